@@ -20,6 +20,12 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+// The mmap flags and madvise used by the reserved pools are not part of
+// strict C11, ask the C library for them before anything is included
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+
 #include "ma-utils.h"
 
 #include <ctype.h>
@@ -34,585 +40,1491 @@
 #include <ctype.h>
 #include <assert.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <pthread.h>
+    #define MA_MEMORY_POOL_HAS_MMAP 1
+#endif
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define MA_STRING_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MA_STRING_SIMD_WIDTH 16
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #define MA_THREAD_LOCAL __declspec(thread)
+#else
+    #define MA_THREAD_LOCAL _Thread_local
+#endif
 
 // ------------------------------------------------------------------------- //
-//                      Costum memory allocation pool                        //
+//                              Allocator                                    //
 // ------------------------------------------------------------------------- //
 
-// Vector memory pool
-static MemoryPoolVector *ma_vector_memory_pool_create(size_t size) {
-    if (size == 0) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Memory pool size cannot be zero.\n");
-        #endif
-        return NULL;
+static void *ma_allocator_default_alloc(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *ma_allocator_default_realloc(void *context, void *ptr, size_t size) {
+    (void)context;
+    return realloc(ptr, size);
+}
+
+static void ma_allocator_default_free(void *context, void *ptr) {
+    (void)context;
+    free(ptr);
+}
+
+static const Allocator default_allocator = {
+    ma_allocator_default_alloc,
+    ma_allocator_default_realloc,
+    ma_allocator_default_free,
+    NULL,
+};
+
+static _Atomic(const Allocator *) global_allocator = &default_allocator;
+static MA_THREAD_LOCAL const Allocator *thread_allocator = NULL;
+
+const Allocator *ma_allocator_default(void) {
+    return &default_allocator;
+}
+
+void ma_allocator_set(const Allocator *allocator) {
+    atomic_store_explicit(&global_allocator, allocator ? allocator : &default_allocator, memory_order_release);
+}
+
+const Allocator *ma_allocator_set_thread(const Allocator *allocator) {
+    const Allocator *previous = thread_allocator;
+    thread_allocator = allocator;
+    return previous;
+}
+
+// Process-wide allocator, for memory that outlives any thread override.
+static const Allocator *ma_allocator_process(void) {
+    return atomic_load_explicit(&global_allocator, memory_order_acquire);
+}
+
+// Thread override when one is installed, the process-wide allocator otherwise.
+const Allocator *ma_allocator_get(void) {
+    if (thread_allocator != NULL) {
+        return thread_allocator;
     }
+    return ma_allocator_process();
+}
 
-    MemoryPoolVector *pool = malloc(sizeof(MemoryPoolVector));
-    if (!pool) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Failed to allocate memory for MemoryPoolVector structure.\n");
-        #endif
-        return NULL;
+void *ma_allocator_alloc(size_t size) {
+    return ma_allocator_alloc_with(ma_allocator_get(), size);
+}
+
+void *ma_allocator_realloc(void *ptr, size_t size) {
+    return ma_allocator_realloc_with(ma_allocator_get(), ptr, size);
+}
+
+void ma_allocator_free(void *ptr) {
+    ma_allocator_free_with(ma_allocator_get(), ptr);
+}
+
+void *ma_allocator_alloc_with(const Allocator *allocator, size_t size) {
+    return allocator->alloc(allocator->context, size);
+}
+
+void *ma_allocator_realloc_with(const Allocator *allocator, void *ptr, size_t size) {
+    return allocator->realloc(allocator->context, ptr, size);
+}
+
+void ma_allocator_free_with(const Allocator *allocator, void *ptr) {
+    if (ptr == NULL) {
+        return;
     }
+    allocator->free(allocator->context, ptr);
+}
 
-    pool->pool = malloc(size);
-    if (!pool->pool) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Failed to allocate memory for memory pool of size %zu.\n", size);
-        #endif
-        free(pool);
-        return NULL;
+// ------------------------------------------------------------------------- //
+//                             Object slab                                   //
+// ------------------------------------------------------------------------- //
+
+// Handle headers of one type are carved out of blocks of
+// MA_OBJECT_SLAB_BLOCK_OBJECTS objects. Released headers go on the releasing
+// thread's free list, so no lock is taken. When a thread exits, its free list
+// and the headers never carved out of its newest block are handed to the other
+// threads through a shared list, which a thread takes over as a whole once its
+// own list runs dry. Blocks come from the process-wide allocator, since headers
+// outlive any thread override, stay for the lifetime of the process and are
+// linked on a global stack so that they remain reachable.
+typedef enum {
+    OBJECT_SLAB_STRING,
+    OBJECT_SLAB_VECTOR,
+    OBJECT_SLAB_FILE_READER,
+    OBJECT_SLAB_FILE_WRITER,
+    OBJECT_SLAB_KINDS,
+} ObjectSlabKind;
+
+typedef struct ObjectSlabBlock ObjectSlabBlock;
+struct ObjectSlabBlock {
+    ObjectSlabBlock *next;    // Block allocated before this one, by any thread
+};
+
+typedef struct ObjectSlab {
+    void *freeList;           // Released objects, linked through their first word
+    char *block;              // Objects of the newest block
+    size_t carved;            // Objects handed out from the newest block
+    size_t objectSize;        // Size of the objects of the newest block
+} ObjectSlab;
+
+#define MA_OBJECT_SLAB_BLOCK_HEADER_SIZE ((sizeof(ObjectSlabBlock) + 15) & ~(size_t)15)
+
+static _Atomic(ObjectSlabBlock *) object_slab_blocks = NULL;
+static _Atomic(void *) object_slab_orphans[OBJECT_SLAB_KINDS]; // Objects left behind by exited threads
+static MA_THREAD_LOCAL ObjectSlab thread_object_slabs[OBJECT_SLAB_KINDS];
+static MA_THREAD_LOCAL bool thread_object_slabs_watched = false;
+
+// Hands every object the exiting thread could still have handed out to the shared lists.
+static void ma_object_slab_thread_exit(void) {
+    for (int kind = 0; kind < OBJECT_SLAB_KINDS; kind++) {
+        ObjectSlab *slab = &thread_object_slabs[kind];
+
+        while (slab->block && slab->carved < MA_OBJECT_SLAB_BLOCK_OBJECTS) {
+            void *object = slab->block + slab->objectSize * slab->carved++;
+            *(void **)object = slab->freeList;
+            slab->freeList = object;
+        }
+        slab->block = NULL;
+        if (slab->freeList == NULL) {
+            continue;
+        }
+
+        void *tail = slab->freeList;
+        while (*(void **)tail) {
+            tail = *(void **)tail;
+        }
+        void *head = atomic_load_explicit(&object_slab_orphans[kind], memory_order_relaxed);
+        do {
+            *(void **)tail = head;
+        } while (!atomic_compare_exchange_weak_explicit(&object_slab_orphans[kind], &head, slab->freeList, memory_order_release, memory_order_relaxed));
+        slab->freeList = NULL;
     }
+}
 
-    pool->poolSize = size;
-    pool->used = 0;
+#if defined(_WIN32) || defined(_WIN64)
+static INIT_ONCE object_slab_exit_once = INIT_ONCE_STATIC_INIT;
+static DWORD object_slab_exit_key = FLS_OUT_OF_INDEXES;
 
-    return pool;
+static void NTAPI ma_object_slab_exit_callback(void *value) {
+    if (value != NULL) {
+        ma_object_slab_thread_exit();
+    }
 }
 
-static void *ma_vector_memory_pool_allocate(MemoryPoolVector *pool, size_t size) {
-    if (!pool) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Memory pool is not initialized.\n");
-        #endif
-        return NULL;
+static BOOL CALLBACK ma_object_slab_exit_init(PINIT_ONCE once, void *parameter, void **context) {
+    (void)once;
+    (void)parameter;
+    (void)context;
+    object_slab_exit_key = FlsAlloc(ma_object_slab_exit_callback);
+    return TRUE;
+}
+
+// Runs ma_object_slab_thread_exit when the calling thread exits.
+static void ma_object_slab_watch_thread(void) {
+    InitOnceExecuteOnce(&object_slab_exit_once, ma_object_slab_exit_init, NULL, NULL);
+    if (object_slab_exit_key != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(object_slab_exit_key, (void *)1);
     }
-    if (size == 0) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Cannot allocate zero size.\n");
-        #endif
-        return NULL;
+    thread_object_slabs_watched = true;
+}
+#else
+static pthread_once_t object_slab_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t object_slab_exit_key;
+static bool object_slab_exit_key_created = false;
+
+static void ma_object_slab_exit_callback(void *value) {
+    (void)value;
+    ma_object_slab_thread_exit();
+}
+
+static void ma_object_slab_exit_init(void) {
+    object_slab_exit_key_created = pthread_key_create(&object_slab_exit_key, ma_object_slab_exit_callback) == 0;
+}
+
+// Runs ma_object_slab_thread_exit when the calling thread exits.
+static void ma_object_slab_watch_thread(void) {
+    pthread_once(&object_slab_exit_once, ma_object_slab_exit_init);
+    if (object_slab_exit_key_created) {
+        pthread_setspecific(object_slab_exit_key, (void *)1);
     }
-    if (pool->used + size > pool->poolSize) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Memory pool out of space. Cannot allocate %zu bytes.\n", size);
-        #endif
-        return NULL; // Pool is out of memory
+    thread_object_slabs_watched = true;
+}
+#endif
+
+static void *ma_object_slab_allocate(ObjectSlabKind kind, size_t objectSize) {
+    ObjectSlab *slab = &thread_object_slabs[kind];
+
+    void *object = slab->freeList;
+    if (object == NULL && atomic_load_explicit(&object_slab_orphans[kind], memory_order_relaxed) != NULL) {
+        object = atomic_exchange_explicit(&object_slab_orphans[kind], NULL, memory_order_acquire); // Take over what exited threads left
     }
+    if (object) {
+        slab->freeList = *(void **)object;
+        return object;
+    }
+
+    if (slab->block == NULL || slab->carved == MA_OBJECT_SLAB_BLOCK_OBJECTS) {
+        if (!thread_object_slabs_watched) {
+            ma_object_slab_watch_thread();
+        }
 
-    void *mem = (char *)pool->pool + pool->used;
-    pool->used += size;
+        ObjectSlabBlock *block = ma_allocator_alloc_with(ma_allocator_process(), MA_OBJECT_SLAB_BLOCK_HEADER_SIZE + objectSize * MA_OBJECT_SLAB_BLOCK_OBJECTS);
+        if (block == NULL) {
+            return NULL;
+        }
 
-    return mem;
+        block->next = atomic_load_explicit(&object_slab_blocks, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&object_slab_blocks, &block->next, block, memory_order_release, memory_order_relaxed)) {
+        }
+        slab->block = (char *)block + MA_OBJECT_SLAB_BLOCK_HEADER_SIZE;
+        slab->carved = 0;
+        slab->objectSize = objectSize;
+    }
+
+    return slab->block + objectSize * slab->carved++;
 }
 
-static void ma_vector_memory_pool_destroy(MemoryPoolVector *pool) {
-    if (!pool) {
-        #ifdef VECTOR_LOGGING_ENABLE
-            printf("Error: Attempted to destroy a non-initialized memory pool.\n");
-        #endif
+static void ma_object_slab_free(ObjectSlabKind kind, void *object) {
+    if (object == NULL) {
         return;
     }
-    free(pool->pool); // Free the allocated pool memory
-    free(pool); // Free the pool structure itself
+    if (!thread_object_slabs_watched) {
+        ma_object_slab_watch_thread(); // Objects released here must not be stranded when the thread exits
+    }
+
+    ObjectSlab *slab = &thread_object_slabs[kind];
+    *(void **)object = slab->freeList;
+    slab->freeList = object;
 }
 
 // ------------------------------------------------------------------------- //
-//                             Encoding                                      //
+//                      Costum memory allocation pool                        //
 // ------------------------------------------------------------------------- //
 
-bool (*b58_sha256_impl)(void *, const void *, size_t) = NULL;
+// Chunks are allocated with their header in front of the usable memory.
+#define MA_MEMORY_POOL_CHUNK_HEADER_SIZE ((sizeof(MemoryPoolChunk) + 15) & ~(size_t)15)
+#define MA_MEMORY_POOL_CHUNK_DATA(chunk) ((char *)(chunk) + MA_MEMORY_POOL_CHUNK_HEADER_SIZE)
 
-#define UNI_REPLACEMENT_CHAR (uint32_t)0x0000FFFD
-#define UNI_SUR_HIGH_START  (unsigned int)0xD800
-#define UNI_SUR_HIGH_END    (unsigned int)0xDBFF
-#define UNI_SUR_LOW_START   (unsigned int)0xDC00
-#define UNI_SUR_LOW_END     (unsigned int)0xDFFF
-#define UNI_MAX_BMP (unsigned int)0x0000FFFF
-#define UNI_MAX_UTF16 (unsigned int)0x0010FFFF
-#define UNI_MAX_UTF32 (unsigned int)0x7FFFFFFF
-#define UNI_MAX_LEGAL_UTF32 (unsigned int)0x0010FFFF
-#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
-#define b58_almostmaxint_bits (sizeof(uint32_t) * 8)
-#define CHAR_BIT 8
+// Size of the chunk that follows one of `chunkSize` bytes under the given growth policy.
+static size_t ma_memory_pool_grow_chunk_size(size_t chunkSize, size_t growthFactor, size_t maxChunkSize) {
+    size_t nextSize = chunkSize;
 
-static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-static const char base32[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567=";
-static const char base16_chars[] = "0123456789ABCDEF";
-static const int halfShift  = 10; /* used for shifting by 10 bits */
-static const uint8_t firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-static const char trailingBytesForUTF8[256] = {
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-    2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3,4,4,4,4,5,5,5,5
-};
-static const uint32_t offsetsFromUTF8[6] = { 0x00000000UL, 0x00003080UL, 0x000E2080UL,
-                     0x03C82080UL, 0xFA082080UL, 0x82082080UL };
-static const unsigned int halfBase = 0x0010000UL;
-static const unsigned int halfMask = 0x3FFUL;
-static const char b58digits_ordered[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-static const int8_t b58digits_map[] = {
-	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
-	-1, 0, 1, 2, 3, 4, 5, 6,  7, 8,-1,-1,-1,-1,-1,-1,
-	-1, 9,10,11,12,13,14,15, 16,-1,17,18,19,20,21,-1,
-	22,23,24,25,26,27,28,29, 30,31,32,-1,-1,-1,-1,-1,
-	-1,33,34,35,36,37,38,39, 40,41,42,43,-1,44,45,46,
-	47,48,49,50,51,52,53,54, 55,56,57,-1,-1,-1,-1,-1,
+    if (growthFactor > 1) {
+        nextSize = (chunkSize > SIZE_MAX / growthFactor) ? SIZE_MAX : chunkSize * growthFactor;
+    }
+    if (maxChunkSize != 0 && nextSize > maxChunkSize) {
+        nextSize = maxChunkSize;
+    }
+
+    return nextSize;
+}
+
+// Process-wide region shared by all threads. Threads carve refill blocks out of
+// the newest region with an atomic fetch-add, an exhausted region is replaced by
+// a larger one with a compare-and-swap, so no thread ever takes a lock.
+typedef struct MemoryPoolRegion MemoryPoolRegion;
+struct MemoryPoolRegion {
+    MemoryPoolRegion *next;   // Exhausted region this one replaced
+    const Allocator *allocator; // Process-wide allocator the region was taken from
+    size_t size;              // Usable bytes in this region
+    atomic_size_t used;       // Bytes handed out as refill blocks
 };
-static const char BASE91_ALPHABET[] =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
-    "!#$%&()*+,./:;<=>?@[]^_`{|}~\"";
 
-static int base91_decode_value(char c) {
-    for (int i = 0; i < 91; ++i) {
-        if (BASE91_ALPHABET[i] == c) {
-            return i;
-        }
+#define MA_MEMORY_POOL_REGION_HEADER_SIZE ((sizeof(MemoryPoolRegion) + 15) & ~(size_t)15)
+
+static _Atomic(MemoryPoolRegion *) global_region = NULL;
+static atomic_uint global_region_generation = 0;
+
+static MemoryPoolRegion *ma_memory_pool_region_create(size_t size) {
+    if (size > SIZE_MAX - MA_MEMORY_POOL_REGION_HEADER_SIZE) {
+        return NULL;
     }
-    return -1; // Character not found
+
+    // Regions are shared by every thread, so a thread override such as a
+    // per-request arena must not provide them
+    const Allocator *allocator = ma_allocator_process();
+    MemoryPoolRegion *region = ma_allocator_alloc_with(allocator, MA_MEMORY_POOL_REGION_HEADER_SIZE + size);
+    if (!region) {
+        return NULL;
+    }
+
+    region->next = NULL;
+    region->allocator = allocator;
+    region->size = size;
+    atomic_init(&region->used, 0);
+
+    return region;
 }
 
-bool ma_encoding_is_utf8(const uint8_t* input, size_t length) {
-    uint8_t a;
-    const uint8_t *srcptr = input+length;
+// Installs the first region unless another thread got there first.
+static bool ma_memory_pool_global_init(size_t size) {
+    if (atomic_load_explicit(&global_region, memory_order_acquire) != NULL) {
+        return true;
+    }
 
-    switch (length) {
-    default:
+    MemoryPoolRegion *region = ma_memory_pool_region_create(size < MA_MEMORY_POOL_GLOBAL_REFILL_SIZE ? MA_MEMORY_POOL_GLOBAL_REFILL_SIZE : size);
+    if (!region) {
         return false;
-        /* Everything else falls through when "true"... */
-    case 4:
-        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
-            return false;
-        }
-    /* fall through */
-    case 3:
-        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
-            return false;
-        }
-   /* fall through */
-    case 2:
-        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
-            return false;
+    }
+
+    MemoryPoolRegion *expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&global_region, &expected, region, memory_order_acq_rel, memory_order_acquire)) {
+        ma_allocator_free_with(region->allocator, region); // Lost the race, the winner's region is used
+    }
+    return true;
+}
+
+// Carves a block of `size` bytes out of the process-wide region.
+static void *ma_memory_pool_global_refill(size_t size) {
+    for (;;) {
+        MemoryPoolRegion *region = atomic_load_explicit(&global_region, memory_order_acquire);
+        if (region == NULL) {
+            if (!ma_memory_pool_global_init(size)) {
+                return NULL;
+            }
+            continue;
         }
-    /* fall through */
 
+        size_t offset = atomic_fetch_add_explicit(&region->used, size, memory_order_relaxed);
+        if (offset <= region->size && size <= region->size - offset) {
+            return (char *)region + MA_MEMORY_POOL_REGION_HEADER_SIZE + offset;
+        }
 
-        switch (*input) {
-            case 0xE0:
-                if (a < 0xA0) {
-                    return false;
-                }
-                break;
-            case 0xED:
-                if (a > 0x9F) {
-                    return false;
-                }
-                break;
-            case 0xF0:
-                if (a < 0x90) {
-                    return false;
-                }
-                break;
-            case 0xF4:
-                if (a > 0x8F) {
-                    return false;
-                }
-                break;
-            default:
-                if (a < 0x80) {
-                    return false;
-                }
-            /* fall through */
+        // The region is exhausted: chain a larger one in front of it
+        size_t regionSize = ma_memory_pool_grow_chunk_size(region->size, MA_MEMORY_POOL_GROWTH_FACTOR, 0);
+        MemoryPoolRegion *fresh = ma_memory_pool_region_create(size > regionSize ? size : regionSize);
+        if (!fresh) {
+            return NULL;
         }
-    /* fall through */
-    case 1:
-        if (*input >= 0x80 && *input < 0xC2) {
-            return false;
+        fresh->next = region;
+        if (!atomic_compare_exchange_strong_explicit(&global_region, &region, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            ma_allocator_free_with(fresh->allocator, fresh); // Another thread already replaced it, retry on the new region
         }
     }
+}
 
-    if (*input > 0xF4) {
-        return false;
+static void ma_memory_pool_global_destroy(void) {
+    MemoryPoolRegion *region = atomic_exchange_explicit(&global_region, NULL, memory_order_acq_rel);
+    atomic_fetch_add_explicit(&global_region_generation, 1, memory_order_acq_rel);
+
+    while (region) {
+        MemoryPoolRegion *next = region->next;
+        ma_allocator_free_with(region->allocator, region);
+        region = next;
     }
-    return true;
 }
 
-static ConversionResult ConvertUTF16toUTF8 (
-        const uint16_t** sourceStart, const uint16_t* sourceEnd,
-        uint8_t** targetStart, uint8_t* targetEnd, ConversionFlags flags) {
+#ifdef MA_MEMORY_POOL_HAS_MMAP
+// Rounds `size` up to a multiple of `boundary`, a power of two, 0 on overflow.
+static size_t ma_memory_pool_round_up(size_t size, size_t boundary) {
+    return (size > SIZE_MAX - (boundary - 1)) ? 0 : (size + boundary - 1) & ~(boundary - 1);
+}
 
-    ConversionResult result = conversionOK;
-    const uint16_t* source = *sourceStart;
-    uint8_t* target = *targetStart;
+// Reserves a chunk of address space. Pages are committed by the kernel on first
+// touch; huge page chunks are placed on a huge page boundary so that
+// MADV_HUGEPAGE can back them with transparent huge pages.
+static MemoryPoolChunk *ma_memory_pool_chunk_map(MemoryPoolBackend backend, const Allocator *allocator, size_t size) {
+    (void)allocator;
+    size_t boundary = (backend == MEMORY_POOL_BACKEND_MMAP_HUGE) ? MA_MEMORY_POOL_HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapSize = ma_memory_pool_round_up(MA_MEMORY_POOL_CHUNK_HEADER_SIZE + size, boundary);
+    if (mapSize == 0 || mapSize > SIZE_MAX - boundary) {
+        return NULL;
+    }
 
-    while (source < sourceEnd) {
-        uint32_t ch;
-        unsigned short bytesToWrite = 0;
-        const uint32_t byteMask = 0xBF;
-        const uint32_t byteMark = 0x80;
-        const uint16_t* oldSource = source; /* In case we have to back up because of target overflow. */
-        ch = *source++;
-        /* If we have a surrogate pair, convert to UTF32 first. */
-        if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_HIGH_END) {
-            /* If the 16 bits following the high surrogate are in the source buffer... */
-            if (source < sourceEnd) {
-                uint32_t ch2 = *source;
-                /* If it's a low surrogate, convert to UTF32. */
-                if (ch2 >= UNI_SUR_LOW_START && ch2 <= UNI_SUR_LOW_END) {
-                    ch = ((ch - UNI_SUR_HIGH_START) << halfShift)
-                        + (ch2 - UNI_SUR_LOW_START) + halfBase;
-                    ++source;
-                }
-                else if (flags == strictConversion) { /* it's an unpaired high surrogate */
-                    --source; /* return to the illegal value itself */
-                    result = sourceIllegal;
-                    break;
-                }
-            }
-            else { /* We don't have the 16 bits following the high surrogate. */
-                --source; /* return to the high surrogate */
-                result = sourceExhausted;
-                break;
-            }
-        }
-        else if (flags == strictConversion) {
-            /* UTF-16 surrogate values are illegal in UTF-32 */
-            if (ch >= UNI_SUR_LOW_START && ch <= UNI_SUR_LOW_END) {
-                --source; /* return to the illegal value itself */
-                result = sourceIllegal;
-                break;
-            }
-        }
-        /* Figure out how many bytes the result will require */
-        if (ch < (uint32_t)0x80) {
-            bytesToWrite = 1;
-        }
-        else if (ch < (uint32_t)0x800) {
-            bytesToWrite = 2;
-        }
-        else if (ch < (uint32_t)0x10000) {
-            bytesToWrite = 3;
-        }
-        else if (ch < (uint32_t)0x110000) {
-            bytesToWrite = 4;
-        }
-        else {
-            bytesToWrite = 3;
-            ch = UNI_REPLACEMENT_CHAR;
-        }
+    size_t reserveSize = (backend == MEMORY_POOL_BACKEND_MMAP_HUGE) ? mapSize + boundary : mapSize;
+    char *mapping = mmap(NULL, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
 
-        target += bytesToWrite;
-        if (target > targetEnd) {
-            source = oldSource; /* Back up source pointer! */
-            target -= bytesToWrite; result = targetExhausted; break;
+    char *start = mapping;
+    if (backend == MEMORY_POOL_BACKEND_MMAP_HUGE) {
+        // Trim the reservation down to an aligned range of `mapSize` bytes
+        start = (char *)ma_memory_pool_round_up((size_t)(uintptr_t)mapping, boundary);
+        if (start > mapping) {
+            munmap(mapping, (size_t)(start - mapping));
         }
-        switch (bytesToWrite) { /* note: everything falls through. */
-            case 4:
-            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 3:
-            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 2:
-            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 1:
-            *--target =  (uint8_t)(ch | firstByteMark[bytesToWrite]);
-            // fall through
+        if (mapping + reserveSize > start + mapSize) {
+            munmap(start + mapSize, (size_t)(mapping + reserveSize - (start + mapSize)));
         }
-        target += bytesToWrite;
+        #ifdef MADV_HUGEPAGE
+            madvise(start, mapSize, MADV_HUGEPAGE); // Only a hint, the chunk works without it
+        #endif
     }
-    *sourceStart = source;
-    *targetStart = target;
 
-    return result;
+    MemoryPoolChunk *chunk = (MemoryPoolChunk *)start;
+    chunk->next = NULL;
+    chunk->size = mapSize - MA_MEMORY_POOL_CHUNK_HEADER_SIZE;
+    chunk->used = 0;
+
+    return chunk;
 }
+#else
+// Without mmap the reserved backends fall back to heap chunks.
+static MemoryPoolChunk *ma_memory_pool_chunk_map(MemoryPoolBackend backend, const Allocator *allocator, size_t size) {
+    (void)backend;
+    if (size > SIZE_MAX - MA_MEMORY_POOL_CHUNK_HEADER_SIZE) {
+        return NULL;
+    }
 
-static ConversionResult ConvertUTF32toUTF8 (
-        const uint32_t** sourceStart, const uint32_t* sourceEnd,
-        uint8_t** targetStart, uint8_t* targetEnd, ConversionFlags flags) {
+    MemoryPoolChunk *chunk = ma_allocator_alloc_with(allocator, MA_MEMORY_POOL_CHUNK_HEADER_SIZE + size);
+    if (!chunk) {
+        return NULL;
+    }
 
-    ConversionResult result = conversionOK;
-    const uint32_t* source = *sourceStart;
-    uint8_t* target = *targetStart;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
 
-    while (source < sourceEnd) {
-        uint32_t ch;
-        unsigned short bytesToWrite = 0;
-        const uint32_t byteMask = 0xBF;
-        const uint32_t byteMark = 0x80;
-        ch = *source++;
-        if (flags == strictConversion ) {
-            /* UTF-16 surrogate values are illegal in UTF-32 */
-            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
-                --source; /* return to the illegal value itself */
-                result = sourceIllegal;
-                break;
-            }
-        }
-        /*
-         * Figure out how many bytes the result will require. Turn any
-         * illegally large UTF32 things (> Plane 17) into replacement chars.
-         */
-        if (ch < (uint32_t)0x80) {
-            bytesToWrite = 1;
-        }
-        else if (ch < (uint32_t)0x800) {
-            bytesToWrite = 2;
-        }
-        else if (ch < (uint32_t)0x10000) {
-            bytesToWrite = 3;
-        }
-        else if (ch <= UNI_MAX_LEGAL_UTF32) {
-            bytesToWrite = 4;
-        }
-        else {
-            bytesToWrite = 3;
-            ch = UNI_REPLACEMENT_CHAR;
-            result = sourceIllegal;
-        }
+    return chunk;
+}
+#endif
 
-        target += bytesToWrite;
-        if (target > targetEnd) {
-            --source; /* Back up source pointer! */
-            target -= bytesToWrite; result = targetExhausted; break;
-        }
-        switch (bytesToWrite) { /* note: everything falls through. */
-            case 4:
-                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 3:
-                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 2:
-                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
-            // fall through
-            case 1:
-                *--target = (uint8_t) (ch | firstByteMark[bytesToWrite]);
-            // fall through
-        }
-        target += bytesToWrite;
+// Heap chunks come from `allocator`, the allocator of the pool they belong to.
+static MemoryPoolChunk *ma_memory_pool_chunk_create(MemoryPoolBackend backend, const Allocator *allocator, size_t size) {
+    if (size > SIZE_MAX - MA_MEMORY_POOL_CHUNK_HEADER_SIZE) {
+        return NULL;
     }
-    *sourceStart = source;
-    *targetStart = target;
 
-    return result;
-}
+    MemoryPoolChunk *chunk = NULL;
+    if (backend == MEMORY_POOL_BACKEND_GLOBAL) {
+        size = (size + 15) & ~(size_t)15; // Keeps the following refill blocks aligned
+        chunk = ma_memory_pool_global_refill(MA_MEMORY_POOL_CHUNK_HEADER_SIZE + size);
+    }
+    else if (backend == MEMORY_POOL_BACKEND_MMAP || backend == MEMORY_POOL_BACKEND_MMAP_HUGE) {
+        return ma_memory_pool_chunk_map(backend, allocator, size);
+    }
+    else {
+        chunk = ma_allocator_alloc_with(allocator, MA_MEMORY_POOL_CHUNK_HEADER_SIZE + size);
+    }
+    if (!chunk) {
+        return NULL;
+    }
 
-static ConversionResult ConvertUTF8toUTF16 (
-        const uint8_t** sourceStart, const uint8_t* sourceEnd,
-        uint16_t** targetStart, uint16_t* targetEnd, ConversionFlags flags) {
-    ConversionResult result = conversionOK;
-    const uint8_t* source = *sourceStart;
-    uint16_t* target = *targetStart;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
 
-    while (source < sourceEnd) {
-        uint32_t ch = 0;
-        unsigned short extraBytesToRead = trailingBytesForUTF8[*source];
+    return chunk;
+}
 
-        if (extraBytesToRead >= sourceEnd - source) {
-            result = sourceExhausted; break;
-        }
-        /* Do this check whether lenient or strict */
-        if (!ma_encoding_is_utf8(source, extraBytesToRead+1)) {
-            result = sourceIllegal;
-            break;
-        }
-        /*
-         * The cases all fall through. See "Note A" below.
-         */
-        switch (extraBytesToRead) {
-            case 5:
-                ch += *source++; ch <<= 6; /* remember, illegal UTF-8 */
-            // fall through
-            case 4:
-                ch += *source++; ch <<= 6; /* remember, illegal UTF-8 */
-                // fall through
-            case 3:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 2:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 1:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 0:
-                ch += *source++;
-                // fall through
-        }
-        ch -= offsetsFromUTF8[extraBytesToRead];
+static void ma_memory_pool_chunks_destroy(MemoryPoolBackend backend, const Allocator *allocator, MemoryPoolChunk *chunk) {
+    if (backend == MEMORY_POOL_BACKEND_GLOBAL) {
+        return; // Refill blocks belong to the process-wide region
+    }
 
-        if (target >= targetEnd) {
-            source -= (extraBytesToRead+1); /* Back up source pointer! */
-            result = targetExhausted; break;
-        }
-        if (ch <= UNI_MAX_BMP) { /* Target is a character <= 0xFFFF */
-            /* UTF-16 surrogate values are illegal in UTF-32 */
-            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
-                if (flags == strictConversion) {
-                    source -= (extraBytesToRead+1); /* return to the illegal value itself */
-                    result = sourceIllegal;
-                    break;
-                }
-                else {
-                    *target++ = UNI_REPLACEMENT_CHAR;
-                }
-            }
-            else {
-                *target++ = (uint16_t)ch; /* normal case */
+    while (chunk) {
+        MemoryPoolChunk *next = chunk->next;
+        #ifdef MA_MEMORY_POOL_HAS_MMAP
+            if (backend == MEMORY_POOL_BACKEND_MMAP || backend == MEMORY_POOL_BACKEND_MMAP_HUGE) {
+                munmap(chunk, MA_MEMORY_POOL_CHUNK_HEADER_SIZE + chunk->size);
+                chunk = next;
+                continue;
             }
+        #endif
+        ma_allocator_free_with(allocator, chunk);
+        chunk = next;
+    }
+}
+
+// Hands the unused pages of every chunk in the list back to the kernel. The
+// address space stays reserved and is committed again on the next touch.
+static void ma_memory_pool_chunks_decommit(MemoryPoolBackend backend, MemoryPoolChunk *chunk) {
+    #ifdef MA_MEMORY_POOL_HAS_MMAP
+        if (backend != MEMORY_POOL_BACKEND_MMAP && backend != MEMORY_POOL_BACKEND_MMAP_HUGE) {
+            return;
         }
-        else if (ch > UNI_MAX_UTF16) {
-            if (flags == strictConversion) {
-                result = sourceIllegal;
-                source -= (extraBytesToRead+1); /* return to the start */
-                break; /* Bail out; shouldn't continue */
-            }
-            else {
-                *target++ = UNI_REPLACEMENT_CHAR;
+
+        size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        for (; chunk; chunk = chunk->next) {
+            char *data = MA_MEMORY_POOL_CHUNK_DATA(chunk);
+            char *from = (char *)ma_memory_pool_round_up((size_t)(uintptr_t)(data + chunk->used), pageSize);
+            char *end = data + chunk->size;
+            if (from < end) {
+                madvise(from, (size_t)(end - from), MADV_DONTNEED);
             }
         }
-        else {
-            /* target is a character in range 0xFFFF - 0x10FFFF. */
-            if (target + 1 >= targetEnd) {
-                source -= (extraBytesToRead+1); /* Back up source pointer! */
-                result = targetExhausted; break;
-            }
-            ch -= halfBase;
-            *target++ = (uint16_t)((ch >> halfShift) + UNI_SUR_HIGH_START);
-            *target++ = (uint16_t)((ch & halfMask) + UNI_SUR_LOW_START);
+    #else
+        (void)backend;
+        (void)chunk;
+    #endif
+}
+
+// Pops a spare chunk that can hold `size` bytes, NULL when none is large enough.
+static MemoryPoolChunk *ma_memory_pool_take_spare(MemoryPoolChunk **spareChunks, size_t size) {
+    for (MemoryPoolChunk **link = spareChunks; *link; link = &(*link)->next) {
+        MemoryPoolChunk *chunk = *link;
+        if (chunk->size >= size) {
+            *link = chunk->next;
+            chunk->next = NULL;
+            chunk->used = 0;
+            return chunk;
         }
     }
-    *sourceStart = source;
-    *targetStart = target;
-
-    return result;
+    return NULL;
 }
 
-ConversionResult ConvertUTF8toUTF32 (
-        const uint8_t** sourceStart, const uint8_t* sourceEnd,
-        uint32_t** targetStart, uint32_t* targetEnd, ConversionFlags flags) {
-    ConversionResult result = conversionOK;
-    const uint8_t* source = *sourceStart;
-    uint32_t* target = *targetStart;
+// Moves every chunk newer than `mark->chunk` onto the spare list and restores the
+// fill level of the marked chunk. Fails when the mark is not part of the chain or
+// its chunk was already rewound below the mark.
+static bool ma_memory_pool_rewind_chunks(MemoryPoolChunk **chunks, MemoryPoolChunk **spareChunks, const MemoryPoolMark *mark, size_t *releasedSize) {
+    MemoryPoolChunk *chunk = *chunks;
+    while (chunk && chunk != mark->chunk) {
+        chunk = chunk->next;
+    }
+    if (!chunk || chunk->used < mark->chunkUsed) {
+        return false;
+    }
 
-    while (source < sourceEnd) {
-        uint32_t ch = 0;
-        unsigned short extraBytesToRead = trailingBytesForUTF8[*source];
-        if (extraBytesToRead >= sourceEnd - source) {
-            result = sourceExhausted; break;
+    *releasedSize = 0;
+    while (*chunks != mark->chunk) {
+        MemoryPoolChunk *released = *chunks;
+        *chunks = released->next;
+        *releasedSize += released->size;
+        released->used = 0;
+        released->next = *spareChunks;
+        *spareChunks = released;
+    }
+    mark->chunk->used = mark->chunkUsed;
+
+    return true;
+}
+
+#define MA_MEMORY_POOL_CLASS_SIZE(sizeClass) ((size_t)1 << ((sizeClass) + MA_MEMORY_POOL_MIN_CLASS_SHIFT))
+
+// Classes whose size still fits a size_t; on 32-bit targets the top
+// MA_MEMORY_POOL_SIZE_CLASSES entries would need a shift past its width.
+#define MA_MEMORY_POOL_USABLE_CLASSES \
+    ((sizeof(size_t) * CHAR_BIT - MA_MEMORY_POOL_MIN_CLASS_SHIFT < MA_MEMORY_POOL_SIZE_CLASSES) \
+        ? sizeof(size_t) * CHAR_BIT - MA_MEMORY_POOL_MIN_CLASS_SHIFT : MA_MEMORY_POOL_SIZE_CLASSES)
+
+// Index of the smallest size class holding `size` bytes, MA_MEMORY_POOL_SIZE_CLASSES when none does.
+static size_t ma_memory_pool_size_class(size_t size) {
+    size_t sizeClass = 0;
+    while (sizeClass < MA_MEMORY_POOL_USABLE_CLASSES && MA_MEMORY_POOL_CLASS_SIZE(sizeClass) < size) {
+        sizeClass++;
+    }
+
+    return (sizeClass < MA_MEMORY_POOL_USABLE_CLASSES) ? sizeClass : MA_MEMORY_POOL_SIZE_CLASSES;
+}
+
+// Resolves MA_MEMORY_POOL_ALIGN_CACHE_LINE and raises `alignment` to the pool
+// minimum, 0 when it is not a power of two.
+static size_t ma_memory_pool_alignment(size_t alignment) {
+    if (alignment == MA_MEMORY_POOL_ALIGN_CACHE_LINE) {
+        return MA_MEMORY_POOL_CACHE_LINE_SIZE;
+    }
+    if (alignment & (alignment - 1)) {
+        return 0;
+    }
+    return (alignment < MA_MEMORY_POOL_MIN_ALIGNMENT) ? MA_MEMORY_POOL_MIN_ALIGNMENT : alignment;
+}
+
+// Bytes to skip from `address` to reach the next multiple of `alignment`.
+static size_t ma_memory_pool_align_padding(const void *address, size_t alignment) {
+    return (size_t)(-(uintptr_t)address & (alignment - 1));
+}
+
+static bool ma_memory_pool_chunk_fits(const MemoryPoolChunk *chunk, size_t padding, size_t size) {
+    size_t available = chunk->size - chunk->used;
+    return padding <= available && size <= available - padding;
+}
+
+// Counters summed over every pool, only maintained with MEMORY_POOL_STATS_ENABLE
+// since every update is an atomic operation shared by all threads.
+#ifdef MEMORY_POOL_STATS_ENABLE
+static atomic_size_t global_stats_allocations = 0;
+static atomic_size_t global_stats_frees = 0;
+static atomic_size_t global_stats_bytes_requested = 0;
+static atomic_size_t global_stats_bytes_allocated = 0;
+static atomic_size_t global_stats_live_bytes = 0;
+static atomic_size_t global_stats_wasted_bytes = 0;
+static atomic_size_t global_stats_high_water_mark = 0;
+static atomic_size_t global_stats_exhaustions = 0;
+#endif
+
+static atomic_bool stats_dump_on_destroy = false;
+
+static void ma_memory_pool_stats_allocated(MemoryPoolStats *stats, size_t requested, size_t size, size_t padding, size_t used) {
+    stats->allocations++;
+    stats->bytesRequested += requested;
+    stats->bytesAllocated += size;
+    stats->liveBytes += size;
+    stats->wastedBytes += padding;
+    if (used > stats->highWaterMark) {
+        stats->highWaterMark = used;
+    }
+
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        atomic_fetch_add_explicit(&global_stats_allocations, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&global_stats_bytes_requested, requested, memory_order_relaxed);
+        atomic_fetch_add_explicit(&global_stats_bytes_allocated, size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&global_stats_wasted_bytes, padding, memory_order_relaxed);
+        size_t live = atomic_fetch_add_explicit(&global_stats_live_bytes, size, memory_order_relaxed) + size;
+        size_t peak = atomic_load_explicit(&global_stats_high_water_mark, memory_order_relaxed);
+        while (live > peak && !atomic_compare_exchange_weak_explicit(&global_stats_high_water_mark, &peak, live, memory_order_relaxed, memory_order_relaxed)) {
         }
-        /* Do this check whether lenient or strict */
-        if (!ma_encoding_is_utf8(source, extraBytesToRead+1)) {
-            result = sourceIllegal;
-            break;
+    #endif
+}
+
+// `recycled` is false for oversized blocks, which stay in the pool as waste.
+static void ma_memory_pool_stats_freed(MemoryPoolStats *stats, size_t size, bool recycled) {
+    stats->frees++;
+    stats->liveBytes -= (size < stats->liveBytes) ? size : stats->liveBytes;
+    if (!recycled) {
+        stats->wastedBytes += size;
+    }
+
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        atomic_fetch_add_explicit(&global_stats_frees, 1, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&global_stats_live_bytes, size, memory_order_relaxed);
+        if (!recycled) {
+            atomic_fetch_add_explicit(&global_stats_wasted_bytes, size, memory_order_relaxed);
         }
-        /*
-         * The cases all fall through. See "Note A" below.
-         */
-        switch (extraBytesToRead) {
-            case 5:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 4:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 3:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 2:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case 1:
-                ch += *source++; ch <<= 6;
-                // fall through
-            case
-                0: ch += *source++;
-                // fall through
+    #endif
+}
+
+// The current chunk could not serve a request: its unused tail is abandoned.
+static void ma_memory_pool_stats_exhausted(MemoryPoolStats *stats, const MemoryPoolChunk *chunk) {
+    stats->exhaustions++;
+    stats->wastedBytes += chunk->size - chunk->used;
+
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        atomic_fetch_add_explicit(&global_stats_exhaustions, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&global_stats_wasted_bytes, chunk->size - chunk->used, memory_order_relaxed);
+    #endif
+}
+
+// Gauges go back to their value at `mark`, the released bytes leave the global totals.
+static void ma_memory_pool_stats_rewound(MemoryPoolStats *stats, const MemoryPoolMark *mark) {
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        atomic_fetch_sub_explicit(&global_stats_live_bytes, stats->liveBytes - mark->liveBytes, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&global_stats_wasted_bytes, stats->wastedBytes - mark->wastedBytes, memory_order_relaxed);
+    #endif
+
+    stats->liveBytes = mark->liveBytes;
+    stats->wastedBytes = mark->wastedBytes;
+}
+
+// A destroyed pool no longer holds any bytes.
+static void ma_memory_pool_stats_destroyed(const char *name, const MemoryPoolStats *stats) {
+    if (atomic_load_explicit(&stats_dump_on_destroy, memory_order_relaxed)) {
+        ma_memory_pool_stats_dump(stderr, name, stats);
+    }
+
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        atomic_fetch_sub_explicit(&global_stats_live_bytes, stats->liveBytes, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&global_stats_wasted_bytes, stats->wastedBytes, memory_order_relaxed);
+    #else
+        (void)stats;
+    #endif
+}
+
+MemoryPoolStats ma_memory_pool_global_stats(void) {
+    MemoryPoolStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    #ifdef MEMORY_POOL_STATS_ENABLE
+        stats.allocations = atomic_load_explicit(&global_stats_allocations, memory_order_relaxed);
+        stats.frees = atomic_load_explicit(&global_stats_frees, memory_order_relaxed);
+        stats.bytesRequested = atomic_load_explicit(&global_stats_bytes_requested, memory_order_relaxed);
+        stats.bytesAllocated = atomic_load_explicit(&global_stats_bytes_allocated, memory_order_relaxed);
+        stats.liveBytes = atomic_load_explicit(&global_stats_live_bytes, memory_order_relaxed);
+        stats.wastedBytes = atomic_load_explicit(&global_stats_wasted_bytes, memory_order_relaxed);
+        stats.highWaterMark = atomic_load_explicit(&global_stats_high_water_mark, memory_order_relaxed);
+        stats.exhaustions = atomic_load_explicit(&global_stats_exhaustions, memory_order_relaxed);
+    #endif
+
+    return stats;
+}
+
+void ma_memory_pool_stats_dump(FILE *stream, const char *name, const MemoryPoolStats *stats) {
+    if (stream == NULL || stats == NULL) {
+        return;
+    }
+
+    fprintf(stream, "%s: %zu allocations, %zu frees, %zu bytes requested, %zu bytes allocated, "
+                    "%zu live bytes, %zu wasted bytes, %zu high-water mark, %zu exhaustions\n",
+            name ? name : "memory pool", stats->allocations, stats->frees, stats->bytesRequested, stats->bytesAllocated,
+            stats->liveBytes, stats->wastedBytes, stats->highWaterMark, stats->exhaustions);
+}
+
+void ma_memory_pool_set_stats_dump(bool enable) {
+    atomic_store_explicit(&stats_dump_on_destroy, enable, memory_order_relaxed);
+}
+
+// Vector memory pool
+static MemoryPoolVector *ma_vector_memory_pool_create_with_backend(MemoryPoolBackend backend, size_t size) {
+    if (size == 0) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool size cannot be zero.\n");
+        #endif
+        return NULL;
+    }
+
+    const Allocator *allocator = ma_allocator_get();
+    MemoryPoolVector *pool = ma_allocator_alloc_with(allocator, sizeof(MemoryPoolVector));
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Failed to allocate memory for MemoryPoolVector structure.\n");
+        #endif
+        return NULL;
+    }
+
+    pool->allocator = allocator;
+    pool->chunks = ma_memory_pool_chunk_create(backend, allocator, size);
+    if (!pool->chunks) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Failed to allocate memory for memory pool of size %zu.\n", size);
+        #endif
+        ma_allocator_free_with(allocator, pool);
+        return NULL;
+    }
+
+    pool->pool = MA_MEMORY_POOL_CHUNK_DATA(pool->chunks);
+    pool->poolSize = pool->chunks->size;
+    pool->used = 0;
+    pool->growthFactor = MA_MEMORY_POOL_GROWTH_FACTOR;
+    pool->maxChunkSize = 0;
+    pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->chunks->size, pool->growthFactor, pool->maxChunkSize);
+    memset(pool->freeLists, 0, sizeof(pool->freeLists));
+    pool->backend = backend;
+    pool->spareChunks = NULL;
+    memset(&pool->stats, 0, sizeof(pool->stats));
+
+    return pool;
+}
+
+MemoryPoolVector *ma_vector_memory_pool_create(size_t size) {
+    return ma_vector_memory_pool_create_with_backend(MEMORY_POOL_BACKEND_HEAP, size);
+}
+
+MemoryPoolVector *ma_vector_memory_pool_create_reserved(size_t reserveSize, bool hugePages) {
+    return ma_vector_memory_pool_create_with_backend(hugePages ? MEMORY_POOL_BACKEND_MMAP_HUGE : MEMORY_POOL_BACKEND_MMAP, reserveSize);
+}
+
+// Chains a new chunk able to hold at least `size` bytes in front of the current one.
+static bool ma_vector_memory_pool_grow(MemoryPoolVector *pool, size_t size) {
+    size_t chunkSize = (size > pool->nextChunkSize) ? size : pool->nextChunkSize;
+
+    ma_memory_pool_stats_exhausted(&pool->stats, pool->chunks);
+
+    MemoryPoolChunk *chunk = ma_memory_pool_take_spare(&pool->spareChunks, size); // Reuse a chunk released by a rewind
+    if (!chunk) {
+        chunk = ma_memory_pool_chunk_create(pool->backend, pool->allocator, chunkSize);
+        if (!chunk) {
+            #ifdef VECTOR_LOGGING_ENABLE
+                printf("Error: Failed to allocate a memory pool chunk of size %zu.\n", chunkSize);
+            #endif
+            return false;
         }
-        ch -= offsetsFromUTF8[extraBytesToRead];
+        pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->nextChunkSize, pool->growthFactor, pool->maxChunkSize);
+    }
 
-        if (target >= targetEnd) {
-            source -= (extraBytesToRead+1); /* Back up the source pointer! */
-            result = targetExhausted; break;
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->pool = MA_MEMORY_POOL_CHUNK_DATA(chunk);
+    pool->poolSize += chunk->size; // Mapped chunks are rounded up to whole pages
+
+    return true;
+}
+
+void *ma_vector_memory_pool_allocate(MemoryPoolVector *pool, size_t size) {
+    return ma_vector_memory_pool_allocate_aligned(pool, size, MA_MEMORY_POOL_MIN_ALIGNMENT);
+}
+
+void *ma_vector_memory_pool_allocate_aligned(MemoryPoolVector *pool, size_t size, size_t alignment) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return NULL;
+    }
+    if (size == 0) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Cannot allocate zero size.\n");
+        #endif
+        return NULL;
+    }
+
+    alignment = ma_memory_pool_alignment(alignment);
+    if (alignment == 0) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Alignment must be a power of two.\n");
+        #endif
+        return NULL;
+    }
+
+    size_t requested = size;
+    size_t sizeClass = ma_memory_pool_size_class(size);
+    if (sizeClass < MA_MEMORY_POOL_SIZE_CLASSES) {
+        size = MA_MEMORY_POOL_CLASS_SIZE(sizeClass);
+
+        void *block = pool->freeLists[sizeClass];
+        if (block && ma_memory_pool_align_padding(block, alignment) == 0) {
+            pool->freeLists[sizeClass] = *(void **)block; // Reuse a released block of the same class
+            ma_memory_pool_stats_allocated(&pool->stats, requested, size, 0, pool->used);
+            return block;
         }
-        if (ch <= UNI_MAX_LEGAL_UTF32) {
-            /*
-             * UTF-16 surrogate values are illegal in UTF-32, and anything
-             * over Plane 17 (> 0x10FFFF) is illegal.
-             */
-            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
-                if (flags == strictConversion) {
-                    source -= (extraBytesToRead+1); /* return to the illegal value itself */
-                    result = sourceIllegal;
-                    break;
-                } else {
-                    *target++ = UNI_REPLACEMENT_CHAR;
-                }
-            } else {
-                *target++ = ch;
-            }
-        } else { /* i.e., ch > UNI_MAX_LEGAL_UTF32 */
-            result = sourceIllegal;
-            *target++ = UNI_REPLACEMENT_CHAR;
+    }
+
+    MemoryPoolChunk *chunk = pool->chunks;
+    size_t padding = ma_memory_pool_align_padding((char *)pool->pool + chunk->used, alignment);
+    if (!ma_memory_pool_chunk_fits(chunk, padding, size)) {
+        if (size > SIZE_MAX - alignment || !ma_vector_memory_pool_grow(pool, size + alignment - 1)) {
+            return NULL;
         }
+        chunk = pool->chunks;
+        padding = ma_memory_pool_align_padding((char *)pool->pool + chunk->used, alignment);
     }
-    *sourceStart = source;
-    *targetStart = target;
-    return result;
+
+    void *mem = (char *)pool->pool + chunk->used + padding;
+    chunk->used += padding + size;
+    pool->used += padding + size;
+    ma_memory_pool_stats_allocated(&pool->stats, requested, size, padding, pool->used);
+
+    return mem;
 }
 
-static int decode_char(unsigned char c) {
-	char retval = -1;
+// Hands a block obtained with `ma_vector_memory_pool_allocate(pool, size)` back to the pool.
+void ma_vector_memory_pool_free(MemoryPoolVector *pool, void *ptr, size_t size) {
+    if (!pool || !ptr) {
+        return;
+    }
 
-	if (c >= 'A' && c <= 'Z') {
-		retval = c - 'A';
+    size_t sizeClass = ma_memory_pool_size_class(size);
+    if (sizeClass >= MA_MEMORY_POOL_SIZE_CLASSES) {
+        ma_memory_pool_stats_freed(&pool->stats, size, false);
+        return; // Oversized blocks are not recycled
     }
-	if (c >= '2' && c <= '7') {
-		retval = c - '2' + 26;
+    ma_memory_pool_stats_freed(&pool->stats, MA_MEMORY_POOL_CLASS_SIZE(sizeClass), true);
+
+    *(void **)ptr = pool->freeLists[sizeClass];
+    pool->freeLists[sizeClass] = ptr;
+}
+
+void ma_vector_memory_pool_set_growth(MemoryPoolVector *pool, size_t growthFactor, size_t maxChunkSize) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return;
     }
 
-	assert(retval == -1 || ((retval & 0x1F) == retval));
-	return  retval;
+    pool->growthFactor = growthFactor == 0 ? 1 : growthFactor;
+    pool->maxChunkSize = maxChunkSize;
+    pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->chunks->size, pool->growthFactor, pool->maxChunkSize);
 }
 
-/**
- * Given a block id between 0 and 7 inclusive, this will return the index of
- * the octet in which this block starts. For example, given 3 it will return 1
- * because block 3 starts in octet 1:
- *
- * +--------+--------+
- * | ......<|.3 >....|
- * +--------+--------+
- *  octet 1 | octet 2
- */
-static int get_octet(int block) {
-	assert(block >= 0 && block < 8);
-	return (block*5) / 8;
+MemoryPoolStats ma_vector_memory_pool_stats(const MemoryPoolVector *pool) {
+    MemoryPoolStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return stats;
+    }
+    return pool->stats;
 }
 
-/**
- * Given a block id between 0 and 7 inclusive, this will return how many bits
- * we can drop at the end of the octet in which this block starts.
- * For example, given block 0 it will return 3 because there are 3 bits
- * we don't care about at the end:
- *
- *  +--------+-
- *  |< 0 >...|
- *  +--------+-
- *
- * Given block 1, it will return -2 because there
- * are actually two bits missing to have a complete block:
- *
- *  +--------+-
- *  |.....< 1|..
- *  +--------+-
- **/
-static int get_offset(int block) {
-	assert(block >= 0 && block < 8);
-	return (8 - 5 - (5*block) % 8);
+MemoryPoolMark ma_vector_memory_pool_mark(MemoryPoolVector *pool) {
+    MemoryPoolMark mark = {NULL, 0, 0, 0, 0};
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return mark;
+    }
+
+    mark.chunk = pool->chunks;
+    mark.chunkUsed = pool->chunks->used;
+    mark.used = pool->used;
+    mark.liveBytes = pool->stats.liveBytes;
+    mark.wastedBytes = pool->stats.wastedBytes;
+
+    return mark;
 }
 
-/**
+// Releases everything allocated after `mark`. Free lists are dropped because they
+// may hold blocks from the released region.
+void ma_vector_memory_pool_rewind(MemoryPoolVector *pool, MemoryPoolMark mark) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return;
+    }
+
+    size_t releasedSize = 0;
+    if (!ma_memory_pool_rewind_chunks(&pool->chunks, &pool->spareChunks, &mark, &releasedSize)) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Mark does not belong to this memory pool.\n");
+        #endif
+        return;
+    }
+
+    pool->pool = MA_MEMORY_POOL_CHUNK_DATA(pool->chunks);
+    pool->poolSize -= releasedSize;
+    pool->used = mark.used;
+    memset(pool->freeLists, 0, sizeof(pool->freeLists));
+    ma_memory_pool_stats_rewound(&pool->stats, &mark);
+}
+
+// Releases every allocation of the pool while keeping its chunks for reuse.
+void ma_vector_memory_pool_reset(MemoryPoolVector *pool) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is not initialized.\n");
+        #endif
+        return;
+    }
+
+    MemoryPoolMark mark = {pool->chunks, 0, 0, 0, 0};
+    while (mark.chunk->next) {
+        mark.chunk = mark.chunk->next;
+    }
+    ma_vector_memory_pool_rewind(pool, mark);
+
+    ma_memory_pool_chunks_decommit(pool->backend, pool->chunks);
+    ma_memory_pool_chunks_decommit(pool->backend, pool->spareChunks);
+}
+
+void ma_vector_memory_pool_destroy(MemoryPoolVector *pool) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Attempted to destroy a non-initialized memory pool.\n");
+        #endif
+        return;
+    }
+    ma_memory_pool_stats_destroyed("vector memory pool", &pool->stats);
+    ma_memory_pool_chunks_destroy(pool->backend, pool->allocator, pool->chunks); // Free every chunk of the pool
+    ma_memory_pool_chunks_destroy(pool->backend, pool->allocator, pool->spareChunks);
+    ma_allocator_free_with(pool->allocator, pool); // Free the pool structure itself
+}
+
+// ------------------------------------------------------------------------- //
+//                             Encoding                                      //
+// ------------------------------------------------------------------------- //
+
+bool (*b58_sha256_impl)(void *, const void *, size_t) = NULL;
+
+#define UNI_REPLACEMENT_CHAR (uint32_t)0x0000FFFD
+#define UNI_SUR_HIGH_START  (unsigned int)0xD800
+#define UNI_SUR_HIGH_END    (unsigned int)0xDBFF
+#define UNI_SUR_LOW_START   (unsigned int)0xDC00
+#define UNI_SUR_LOW_END     (unsigned int)0xDFFF
+#define UNI_MAX_BMP (unsigned int)0x0000FFFF
+#define UNI_MAX_UTF16 (unsigned int)0x0010FFFF
+#define UNI_MAX_UTF32 (unsigned int)0x7FFFFFFF
+#define UNI_MAX_LEGAL_UTF32 (unsigned int)0x0010FFFF
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#define b58_almostmaxint_bits (sizeof(uint32_t) * 8)
+
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char base32[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567=";
+static const char base16_chars[] = "0123456789ABCDEF";
+static const int halfShift  = 10; /* used for shifting by 10 bits */
+static const uint8_t firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
+static const char trailingBytesForUTF8[256] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+    2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3,4,4,4,4,5,5,5,5
+};
+static const uint32_t offsetsFromUTF8[6] = { 0x00000000UL, 0x00003080UL, 0x000E2080UL,
+                     0x03C82080UL, 0xFA082080UL, 0x82082080UL };
+static const unsigned int halfBase = 0x0010000UL;
+static const unsigned int halfMask = 0x3FFUL;
+static const char b58digits_ordered[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static const int8_t b58digits_map[] = {
+	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
+	-1, 0, 1, 2, 3, 4, 5, 6,  7, 8,-1,-1,-1,-1,-1,-1,
+	-1, 9,10,11,12,13,14,15, 16,-1,17,18,19,20,21,-1,
+	22,23,24,25,26,27,28,29, 30,31,32,-1,-1,-1,-1,-1,
+	-1,33,34,35,36,37,38,39, 40,41,42,43,-1,44,45,46,
+	47,48,49,50,51,52,53,54, 55,56,57,-1,-1,-1,-1,-1,
+};
+static const char BASE91_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+    "!#$%&()*+,./:;<=>?@[]^_`{|}~\"";
+
+static int base91_decode_value(char c) {
+    for (int i = 0; i < 91; ++i) {
+        if (BASE91_ALPHABET[i] == c) {
+            return i;
+        }
+    }
+    return -1; // Character not found
+}
+
+bool ma_encoding_is_utf8(const uint8_t* input, size_t length) {
+    uint8_t a;
+    const uint8_t *srcptr = input+length;
+
+    switch (length) {
+    default:
+        return false;
+        /* Everything else falls through when "true"... */
+    case 4:
+        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
+            return false;
+        }
+    /* fall through */
+    case 3:
+        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
+            return false;
+        }
+   /* fall through */
+    case 2:
+        if ((a = (*--srcptr)) < 0x80 || a > 0xBF) {
+            return false;
+        }
+    /* fall through */
+
+
+        switch (*input) {
+            case 0xE0:
+                if (a < 0xA0) {
+                    return false;
+                }
+                break;
+            case 0xED:
+                if (a > 0x9F) {
+                    return false;
+                }
+                break;
+            case 0xF0:
+                if (a < 0x90) {
+                    return false;
+                }
+                break;
+            case 0xF4:
+                if (a > 0x8F) {
+                    return false;
+                }
+                break;
+            default:
+                if (a < 0x80) {
+                    return false;
+                }
+            /* fall through */
+        }
+    /* fall through */
+    case 1:
+        if (*input >= 0x80 && *input < 0xC2) {
+            return false;
+        }
+    }
+
+    if (*input > 0xF4) {
+        return false;
+    }
+    return true;
+}
+
+static ConversionResult ConvertUTF16toUTF8 (
+        const uint16_t** sourceStart, const uint16_t* sourceEnd,
+        uint8_t** targetStart, uint8_t* targetEnd, ConversionFlags flags) {
+
+    ConversionResult result = conversionOK;
+    const uint16_t* source = *sourceStart;
+    uint8_t* target = *targetStart;
+
+    while (source < sourceEnd) {
+        uint32_t ch;
+        unsigned short bytesToWrite = 0;
+        const uint32_t byteMask = 0xBF;
+        const uint32_t byteMark = 0x80;
+        const uint16_t* oldSource = source; /* In case we have to back up because of target overflow. */
+        ch = *source++;
+        /* If we have a surrogate pair, convert to UTF32 first. */
+        if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_HIGH_END) {
+            /* If the 16 bits following the high surrogate are in the source buffer... */
+            if (source < sourceEnd) {
+                uint32_t ch2 = *source;
+                /* If it's a low surrogate, convert to UTF32. */
+                if (ch2 >= UNI_SUR_LOW_START && ch2 <= UNI_SUR_LOW_END) {
+                    ch = ((ch - UNI_SUR_HIGH_START) << halfShift)
+                        + (ch2 - UNI_SUR_LOW_START) + halfBase;
+                    ++source;
+                }
+                else if (flags == strictConversion) { /* it's an unpaired high surrogate */
+                    --source; /* return to the illegal value itself */
+                    result = sourceIllegal;
+                    break;
+                }
+            }
+            else { /* We don't have the 16 bits following the high surrogate. */
+                --source; /* return to the high surrogate */
+                result = sourceExhausted;
+                break;
+            }
+        }
+        else if (flags == strictConversion) {
+            /* UTF-16 surrogate values are illegal in UTF-32 */
+            if (ch >= UNI_SUR_LOW_START && ch <= UNI_SUR_LOW_END) {
+                --source; /* return to the illegal value itself */
+                result = sourceIllegal;
+                break;
+            }
+        }
+        /* Figure out how many bytes the result will require */
+        if (ch < (uint32_t)0x80) {
+            bytesToWrite = 1;
+        }
+        else if (ch < (uint32_t)0x800) {
+            bytesToWrite = 2;
+        }
+        else if (ch < (uint32_t)0x10000) {
+            bytesToWrite = 3;
+        }
+        else if (ch < (uint32_t)0x110000) {
+            bytesToWrite = 4;
+        }
+        else {
+            bytesToWrite = 3;
+            ch = UNI_REPLACEMENT_CHAR;
+        }
+
+        target += bytesToWrite;
+        if (target > targetEnd) {
+            source = oldSource; /* Back up source pointer! */
+            target -= bytesToWrite; result = targetExhausted; break;
+        }
+        switch (bytesToWrite) { /* note: everything falls through. */
+            case 4:
+            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 3:
+            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 2:
+            *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 1:
+            *--target =  (uint8_t)(ch | firstByteMark[bytesToWrite]);
+            // fall through
+        }
+        target += bytesToWrite;
+    }
+    *sourceStart = source;
+    *targetStart = target;
+
+    return result;
+}
+
+static ConversionResult ConvertUTF32toUTF8 (
+        const uint32_t** sourceStart, const uint32_t* sourceEnd,
+        uint8_t** targetStart, uint8_t* targetEnd, ConversionFlags flags) {
+
+    ConversionResult result = conversionOK;
+    const uint32_t* source = *sourceStart;
+    uint8_t* target = *targetStart;
+
+    while (source < sourceEnd) {
+        uint32_t ch;
+        unsigned short bytesToWrite = 0;
+        const uint32_t byteMask = 0xBF;
+        const uint32_t byteMark = 0x80;
+        ch = *source++;
+        if (flags == strictConversion ) {
+            /* UTF-16 surrogate values are illegal in UTF-32 */
+            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
+                --source; /* return to the illegal value itself */
+                result = sourceIllegal;
+                break;
+            }
+        }
+        /*
+         * Figure out how many bytes the result will require. Turn any
+         * illegally large UTF32 things (> Plane 17) into replacement chars.
+         */
+        if (ch < (uint32_t)0x80) {
+            bytesToWrite = 1;
+        }
+        else if (ch < (uint32_t)0x800) {
+            bytesToWrite = 2;
+        }
+        else if (ch < (uint32_t)0x10000) {
+            bytesToWrite = 3;
+        }
+        else if (ch <= UNI_MAX_LEGAL_UTF32) {
+            bytesToWrite = 4;
+        }
+        else {
+            bytesToWrite = 3;
+            ch = UNI_REPLACEMENT_CHAR;
+            result = sourceIllegal;
+        }
+
+        target += bytesToWrite;
+        if (target > targetEnd) {
+            --source; /* Back up source pointer! */
+            target -= bytesToWrite; result = targetExhausted; break;
+        }
+        switch (bytesToWrite) { /* note: everything falls through. */
+            case 4:
+                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 3:
+                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 2:
+                *--target = (uint8_t)((ch | byteMark) & byteMask); ch >>= 6;
+            // fall through
+            case 1:
+                *--target = (uint8_t) (ch | firstByteMark[bytesToWrite]);
+            // fall through
+        }
+        target += bytesToWrite;
+    }
+    *sourceStart = source;
+    *targetStart = target;
+
+    return result;
+}
+
+static ConversionResult ConvertUTF8toUTF16 (
+        const uint8_t** sourceStart, const uint8_t* sourceEnd,
+        uint16_t** targetStart, uint16_t* targetEnd, ConversionFlags flags) {
+    ConversionResult result = conversionOK;
+    const uint8_t* source = *sourceStart;
+    uint16_t* target = *targetStart;
+
+    while (source < sourceEnd) {
+        uint32_t ch = 0;
+        unsigned short extraBytesToRead = trailingBytesForUTF8[*source];
+
+        if (extraBytesToRead >= sourceEnd - source) {
+            result = sourceExhausted; break;
+        }
+        /* Do this check whether lenient or strict */
+        if (!ma_encoding_is_utf8(source, extraBytesToRead+1)) {
+            result = sourceIllegal;
+            break;
+        }
+        /*
+         * The cases all fall through. See "Note A" below.
+         */
+        switch (extraBytesToRead) {
+            case 5:
+                ch += *source++; ch <<= 6; /* remember, illegal UTF-8 */
+            // fall through
+            case 4:
+                ch += *source++; ch <<= 6; /* remember, illegal UTF-8 */
+                // fall through
+            case 3:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 2:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 1:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 0:
+                ch += *source++;
+                // fall through
+        }
+        ch -= offsetsFromUTF8[extraBytesToRead];
+
+        if (target >= targetEnd) {
+            source -= (extraBytesToRead+1); /* Back up source pointer! */
+            result = targetExhausted; break;
+        }
+        if (ch <= UNI_MAX_BMP) { /* Target is a character <= 0xFFFF */
+            /* UTF-16 surrogate values are illegal in UTF-32 */
+            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
+                if (flags == strictConversion) {
+                    source -= (extraBytesToRead+1); /* return to the illegal value itself */
+                    result = sourceIllegal;
+                    break;
+                }
+                else {
+                    *target++ = UNI_REPLACEMENT_CHAR;
+                }
+            }
+            else {
+                *target++ = (uint16_t)ch; /* normal case */
+            }
+        }
+        else if (ch > UNI_MAX_UTF16) {
+            if (flags == strictConversion) {
+                result = sourceIllegal;
+                source -= (extraBytesToRead+1); /* return to the start */
+                break; /* Bail out; shouldn't continue */
+            }
+            else {
+                *target++ = UNI_REPLACEMENT_CHAR;
+            }
+        }
+        else {
+            /* target is a character in range 0xFFFF - 0x10FFFF. */
+            if (target + 1 >= targetEnd) {
+                source -= (extraBytesToRead+1); /* Back up source pointer! */
+                result = targetExhausted; break;
+            }
+            ch -= halfBase;
+            *target++ = (uint16_t)((ch >> halfShift) + UNI_SUR_HIGH_START);
+            *target++ = (uint16_t)((ch & halfMask) + UNI_SUR_LOW_START);
+        }
+    }
+    *sourceStart = source;
+    *targetStart = target;
+
+    return result;
+}
+
+ConversionResult ConvertUTF8toUTF32 (
+        const uint8_t** sourceStart, const uint8_t* sourceEnd,
+        uint32_t** targetStart, uint32_t* targetEnd, ConversionFlags flags) {
+    ConversionResult result = conversionOK;
+    const uint8_t* source = *sourceStart;
+    uint32_t* target = *targetStart;
+
+    while (source < sourceEnd) {
+        uint32_t ch = 0;
+        unsigned short extraBytesToRead = trailingBytesForUTF8[*source];
+        if (extraBytesToRead >= sourceEnd - source) {
+            result = sourceExhausted; break;
+        }
+        /* Do this check whether lenient or strict */
+        if (!ma_encoding_is_utf8(source, extraBytesToRead+1)) {
+            result = sourceIllegal;
+            break;
+        }
+        /*
+         * The cases all fall through. See "Note A" below.
+         */
+        switch (extraBytesToRead) {
+            case 5:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 4:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 3:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 2:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case 1:
+                ch += *source++; ch <<= 6;
+                // fall through
+            case
+                0: ch += *source++;
+                // fall through
+        }
+        ch -= offsetsFromUTF8[extraBytesToRead];
+
+        if (target >= targetEnd) {
+            source -= (extraBytesToRead+1); /* Back up the source pointer! */
+            result = targetExhausted; break;
+        }
+        if (ch <= UNI_MAX_LEGAL_UTF32) {
+            /*
+             * UTF-16 surrogate values are illegal in UTF-32, and anything
+             * over Plane 17 (> 0x10FFFF) is illegal.
+             */
+            if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) {
+                if (flags == strictConversion) {
+                    source -= (extraBytesToRead+1); /* return to the illegal value itself */
+                    result = sourceIllegal;
+                    break;
+                } else {
+                    *target++ = UNI_REPLACEMENT_CHAR;
+                }
+            } else {
+                *target++ = ch;
+            }
+        } else { /* i.e., ch > UNI_MAX_LEGAL_UTF32 */
+            result = sourceIllegal;
+            *target++ = UNI_REPLACEMENT_CHAR;
+        }
+    }
+    *sourceStart = source;
+    *targetStart = target;
+    return result;
+}
+
+static int decode_char(unsigned char c) {
+	char retval = -1;
+
+	if (c >= 'A' && c <= 'Z') {
+		retval = c - 'A';
+    }
+	if (c >= '2' && c <= '7') {
+		retval = c - '2' + 26;
+    }
+
+	assert(retval == -1 || ((retval & 0x1F) == retval));
+	return  retval;
+}
+
+/**
+ * Given a block id between 0 and 7 inclusive, this will return the index of
+ * the octet in which this block starts. For example, given 3 it will return 1
+ * because block 3 starts in octet 1:
+ *
+ * +--------+--------+
+ * | ......<|.3 >....|
+ * +--------+--------+
+ *  octet 1 | octet 2
+ */
+static int get_octet(int block) {
+	assert(block >= 0 && block < 8);
+	return (block*5) / 8;
+}
+
+/**
+ * Given a block id between 0 and 7 inclusive, this will return how many bits
+ * we can drop at the end of the octet in which this block starts.
+ * For example, given block 0 it will return 3 because there are 3 bits
+ * we don't care about at the end:
+ *
+ *  +--------+-
+ *  |< 0 >...|
+ *  +--------+-
+ *
+ * Given block 1, it will return -2 because there
+ * are actually two bits missing to have a complete block:
+ *
+ *  +--------+-
+ *  |.....< 1|..
+ *  +--------+-
+ **/
+static int get_offset(int block) {
+	assert(block >= 0 && block < 8);
+	return (8 - 5 - (5*block) % 8);
+}
+
+/**
  * Like "b >> offset" but it will do the right thing with negative offset.
  * We need this as bitwise shifting by a negative offset is undefined
  * behavior.
@@ -625,3137 +1537,7019 @@ static unsigned char shift_right(unsigned char byte, signed char offset) {
     }
 }
 
-static unsigned char shift_left(unsigned char byte, signed char offset) {
-	return shift_right(byte, - offset);
+static unsigned char shift_left(unsigned char byte, signed char offset) {
+	return shift_right(byte, - offset);
+}
+
+static int decode_sequence(const unsigned char *coded, unsigned char *plain) {
+	assert(CHAR_BIT == 8);
+	assert(coded && plain);
+
+	plain[0] = 0;
+	for (int block = 0; block < 8; block++) {
+		int offset = get_offset(block);
+		int octet = get_octet(block);
+
+		int c = decode_char(coded[block]);
+		if (c < 0) {
+			return octet;
+        }
+
+		plain[octet] |= shift_left(c, offset);
+		if (offset < 0) {  // does this block overflows to next octet?
+			assert(octet < 4);
+			plain[octet+1] = shift_left(c, 8 + offset);
+		}
+	}
+	return 5;
+}
+
+char* ma_encoding_base64_encode(const char* input, size_t length) {
+    size_t output_length = 4 * ((length + 2) / 3);
+    char* encoded = ma_allocator_alloc(output_length + 1); // +1 for null terminator
+    if (!encoded) {
+        printf("Error: Can not allocate memory for encoded in encoding_base64_encode.\n");
+        return NULL;
+    }
+
+    size_t i, j;
+    for (i = 0, j = 0; i < length;) {
+        uint32_t octet_a = i < length ? (unsigned char)input[i++] : 0;
+        uint32_t octet_b = i < length ? (unsigned char)input[i++] : 0;
+        uint32_t octet_c = i < length ? (unsigned char)input[i++] : 0;
+        uint32_t triple = (octet_a << 16) + (octet_b << 8) + octet_c;
+
+        encoded[j++] = base64_chars[(triple >> 18) & 0x3F];
+        encoded[j++] = base64_chars[(triple >> 12) & 0x3F];
+        encoded[j++] = base64_chars[(triple >> 6) & 0x3F];
+        encoded[j++] = base64_chars[triple & 0x3F];
+    }
+
+    for (size_t k = 0; k < (3 - length % 3) % 3; k++) {
+        encoded[output_length - 1 - k] = '=';
+    }
+
+    encoded[output_length] = '\0';
+    return encoded;
+}
+
+char* ma_encoding_base64_decode(const char* input, size_t length) {
+    if (length % 4 != 0) {
+        printf("Error: Invalid input length in encoding_base64_decode. Length must be a multiple of 4.\n");
+        return NULL;
+    }
+
+    size_t output_length = length / 4 * 3;
+    if (input[length - 1] == '=')  {
+        output_length--;
+    }
+
+    if (input[length - 2] == '=') {
+        output_length--;
+    }
+
+    char* decoded = ma_allocator_alloc(output_length + 1);
+    if (!decoded) {
+        printf("Error: Memory allocation failed in encoding_base64_decode.\n");
+        return NULL;
+    }
+
+    static const unsigned char d[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0,
+        0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0,
+        0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51
+    };
+
+    for (size_t i = 0, j = 0; i < length;) {
+        uint32_t sextet_a = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
+        uint32_t sextet_b = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
+        uint32_t sextet_c = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
+        uint32_t sextet_d = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
+        uint32_t triple = (sextet_a << 18) + (sextet_b << 12) + (sextet_c << 6) + sextet_d;
+
+        if (j < output_length) {
+            decoded[j++] = (triple >> 16) & 0xFF;
+        }
+        if (j < output_length) {
+            decoded[j++] = (triple >> 8) & 0xFF;
+        }
+        if (j < output_length) {
+            decoded[j++] = triple & 0xFF;
+        }
+    }
+
+    decoded[output_length] = '\0';
+
+    return decoded;
+}
+
+char* ma_encoding_url_encode(const char* input, size_t length) {
+    char* result = ma_allocator_alloc(3 * length + 1); // Worst case scenario, every character needs encoding
+    if (!result) {
+        printf("Error: Memory allocation failed in encoding_url_encode.\n");
+        return NULL;
+    }
+
+    size_t result_index = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char ch = input[i];
+        if (isalnum(ch) || ch == '-' || ch == '.' || ch == '_' || ch == '~') {
+            result[result_index++] = ch;
+        }
+        else {
+            static const char hex[] = "0123456789ABCDEF";
+            result[result_index++] = '%';
+            result[result_index++] = hex[(ch >> 4) & 0x0F];
+            result[result_index++] = hex[ch & 0x0F];
+        }
+    }
+    result[result_index] = '\0';
+
+    return result;
+}
+
+char* ma_encoding_url_decode(const char* input, size_t length) {
+    char* result = ma_allocator_alloc(length + 1); // Decoded string will be equal or smaller in size
+    if (!result) {
+        printf("Error: Memory allocation failed in encoding_url_decode.\n");
+        return NULL;
+    }
+
+    size_t result_index = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char ch = input[i];
+        if (ch == '%') {
+            if (i + 2 >= length) {
+                printf("Error: Incomplete percent-encoding in encoding_url_decode.\n");
+                ma_allocator_free(result);
+                return NULL;
+            }
+
+            static const char hex[] = "0123456789ABCDEF";
+            char hi = input[++i];
+            char lo = input[++i];
+            int hi_index = strchr(hex, toupper(hi)) - hex;
+            int lo_index = strchr(hex, toupper(lo)) - hex;
+
+            if (hi_index < 0 || hi_index >= 16 || lo_index < 0 || lo_index >= 16) {
+                printf("Error: Invalid hex characters in percent-encoding in encoding_url_decode.\n");
+                ma_allocator_free(result);
+                return NULL;
+            }
+
+            result[result_index++] = (char)((hi_index << 4) + lo_index);
+        }
+        else if (ch == '+') {
+            result[result_index++] = ' ';
+        }
+        else {
+            result[result_index++] = ch;
+        }
+    }
+    result[result_index] = '\0';
+    return result;
+}
+
+char* ma_encoding_base32_encode(const char* input, size_t length) {
+    size_t output_length = ((length + 4) / 5) * 8; // Output length including padding
+    char* encoded = ma_allocator_alloc(output_length + 1);
+
+    if (!encoded) {
+        printf("Error: Memory allocation failed in encoding_base32_encode.\n");
+        return NULL;
+    }
+
+    size_t input_index = 0;
+    size_t output_index = 0;
+    size_t bit_count = 0;
+    uint32_t buffer = 0;
+
+    while (input_index < length) {
+        // Fill the buffer with up to 5 bytes
+        buffer = (buffer << 8) | (uint8_t)input[input_index++];
+        bit_count += 8;
+
+        // While we have more than 5 bits, process the buffer
+        while (bit_count >= 5) {
+            encoded[output_index++] = base32[(buffer >> (bit_count - 5)) & 0x1F];
+            bit_count -= 5;
+        }
+    }
+
+    // Process any remaining bits in the buffer
+    if (bit_count > 0) {
+        encoded[output_index++] = base32[(buffer << (5 - bit_count)) & 0x1F];
+    }
+
+    // Add padding
+    while (output_index < output_length) {
+        encoded[output_index++] = '=';
+    }
+
+    encoded[output_index] = '\0';
+
+    return encoded;
+}
+
+char* ma_encoding_base32_decode(const char* input, size_t length) {
+    if (length % 8 != 0) {
+        printf("Error: Invalid input length in encoding_base32_decode. Length must be a multiple of 8.\n");
+        return NULL;
+    }
+
+    size_t olength = (length / 8) * 5;
+    unsigned char* result = ma_allocator_alloc(olength + 1);
+    if (!result) {
+        printf("Error: Memory allocation failed in encoding_base32_decode.\n");
+        return NULL;
+    }
+
+    size_t i = 0, j = 0;
+    while (i < length) {
+        if (input[i] == '=') {
+            break; // Padding character
+        }
+
+        int n = decode_sequence((const unsigned char*)&input[i], &result[j]);
+        if (n < 5) { // Less than 5 bytes decoded, indicates padding or end of input
+            j += n;
+            break;
+        }
+
+        i += 8;
+        j += 5;
+    }
+
+    result[j] = '\0';
+
+    return (char*)result;
+}
+
+char* ma_encoding_base16_encode(const char* input, size_t length) {
+    size_t output_length = length * 2;
+    char* encoded = ma_allocator_alloc(output_length + 1);
+
+    if (!encoded) {
+        printf("Error: Memory allocation failed in encoding_base16_encode.\n");
+        return NULL;
+    }
+
+    for (size_t i = 0, j = 0; i < length; ++i) {
+        uint8_t ch = (uint8_t)input[i];
+        encoded[j++] = base16_chars[(ch & 0xF0) >> 4];
+        encoded[j++] = base16_chars[ch & 0x0F];
+    }
+
+    encoded[output_length] = '\0';
+
+    return encoded;
+}
+
+char* ma_encoding_base16_decode(const char* input, size_t length) {
+    if (input == NULL) {
+        printf("Error: Invalid input param in encoding_base16_decode.\n");
+        return NULL;
+    }
+    static const unsigned char base16_decode[128] ={
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+     };
+
+    if (length % 2 != 0) {
+        printf("Error: Invalid input length in encoding_base16_decode.\n");
+        return NULL; // Invalid input length
+    }
+
+    size_t olength = length / 2;
+    char* decoded = ma_allocator_alloc(olength + 1);
+
+    if (!decoded) {
+        printf("Error: Cannot allocate memory for Base16 decoded string in encoding_base16_decode.\n");
+        return NULL;
+    }
+
+    for (size_t i = 0, j = 0; i < length;) {
+        uint8_t a = base16_decode[(unsigned char)input[i++]];
+        uint8_t b = base16_decode[(unsigned char)input[i++]];
+
+        if (a == 0xFF || b == 0xFF) {
+            printf("Error: Invalid Character in encoding_base16_decode.\n");
+            ma_allocator_free(decoded);
+            return NULL; // Invalid character
+        }
+
+        decoded[j++] = (a << 4) | b;
+    }
+
+    decoded[olength] = '\0';
+
+    return decoded;
+}
+
+uint16_t* ma_encoding_utf32_to_utf16(const uint32_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_utf32_to_utf16.\n");
+        return NULL;
+    }
+
+    // Allocate maximum possible size (each UTF-32 character might become two UTF-16 characters)
+    uint16_t* output = ma_allocator_alloc(sizeof(uint16_t) * (length * 2 + 1));
+    if (!output) {
+        printf("Error: Memory allocation failed in encoding_utf32_to_utf16.\n");
+        return NULL;
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t ch = input[i];
+
+        if (ch > UNI_MAX_LEGAL_UTF32) {
+            printf("Error: Invalid Character in encoding_utf32_to_utf16.\n");
+            ma_allocator_free(output);
+            return NULL;
+        }
+
+        if (ch <= UNI_MAX_BMP) {
+            // Character can be directly converted to single UTF-16 unit
+            output[j++] = (uint16_t)ch;
+        }
+        else if (ch > UNI_MAX_BMP && ch <= UNI_MAX_UTF16) {
+            // Convert character to surrogate pair
+            ch -= halfBase;
+            output[j++] = (uint16_t)((ch >> halfShift) + UNI_SUR_HIGH_START);
+            output[j++] = (uint16_t)((ch & halfMask) + UNI_SUR_LOW_START);
+        }
+    }
+
+    // Null-terminate the UTF-16 string
+    output[j] = 0;
+
+    return output;
+}
+
+uint32_t* ma_encoding_utf16_to_utf32(const uint16_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_utf16_to_utf32.\n");
+        return NULL;
+    }
+
+    // Allocate memory for the worst-case scenario (all characters are non-surrogates)
+    uint32_t* output = ma_allocator_alloc(sizeof(uint32_t) * (length + 1));
+    if (!output) {
+        printf("Error: Memory allocation failed in encoding_utf16_to_utf32.\n");
+        return NULL;
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t ch = input[i];
+
+        // Check for high surrogate
+        if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_HIGH_END) {
+            // Ensure there's a following character for the low surrogate
+            if (i + 1 < length) {
+                uint32_t ch2 = input[i + 1];
+                // Check for low surrogate and construct the full code point
+                if (ch2 >= UNI_SUR_LOW_START && ch2 <= UNI_SUR_LOW_END) {
+                    ch = ((ch - UNI_SUR_HIGH_START) << 10) + (ch2 - UNI_SUR_LOW_START) + 0x10000;
+                    i++; // Skip the low surrogate
+                }
+                else {
+                    printf("Error: Invalid surrogate pair in encoding_utf16_to_utf32.\n");
+                    ma_allocator_free(output);
+                    return NULL;
+                }
+            }
+            else {
+                printf("Error: Lone high surrogate without a low surrogate in encoding_utf16_to_utf32.\n");
+                ma_allocator_free(output);
+                return NULL;
+            }
+        }
+        output[j++] = ch;
+    }
+
+    // Null-terminate the output
+    output[j] = 0;
+
+    return output;
+}
+
+uint8_t* ma_encoding_utf16_to_utf8(const uint16_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_utf16_to_utf8.\n");
+        return NULL;
+    }
+    // Estimate maximum output size (4 bytes per UTF-16 character)
+    size_t maxOutLength = length * 4;
+    uint8_t* output = (uint8_t*)ma_allocator_alloc(maxOutLength);
+    if (!output) {
+        printf("Error: Memory allocation failed in encoding_utf16_to_utf8.\n");
+        return NULL;
+    }
+
+    const uint16_t* sourceStart = input;
+    const uint16_t* sourceEnd = input + length;
+    uint8_t* targetStart = output;
+    uint8_t* targetEnd = output + maxOutLength;
+
+    ConversionResult result = ConvertUTF16toUTF8(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+
+    if (result != conversionOK) {
+        printf("Error: Conversion from UTF-16 to UTF-8 failed in encoding_utf16_to_utf8.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+
+    // Resize the output to the actual UTF-8 string length
+    size_t actualLength = targetStart - output;
+    uint8_t* resizedOutput = (uint8_t*)ma_allocator_realloc(output, actualLength + 1);
+    // if (resizedOutput) {
+    //     resizedOutput[actualLength] = '\0';
+    //     return resizedOutput;
+    // }
+
+    // return output;
+
+    if (!resizedOutput) {
+        printf("Error: Reallocation failed in encoding_utf16_to_utf8.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+    resizedOutput[actualLength] = '\0';
+
+    return resizedOutput;
+}
+
+uint8_t* ma_encoding_utf32_to_utf8(const uint32_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_utf32_to_utf8.\n");
+        return NULL;
+    }
+
+    // Estimate maximum output size (4 bytes per UTF-32 character)
+    size_t maxOutLength = length * 4;
+    uint8_t* output = (uint8_t*)ma_allocator_alloc(maxOutLength);
+    if (!output) {
+        printf("Error: Memory allocation failed in encoding_utf32_to_utf8.\n");
+        return NULL;
+    }
+
+    const uint32_t* sourceStart = input;
+    const uint32_t* sourceEnd = input + length;
+    uint8_t* targetStart = output;
+    uint8_t* targetEnd = output + maxOutLength;
+
+    ConversionResult result = ConvertUTF32toUTF8(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+
+    if (result != conversionOK) {
+        printf("Error: Conversion from UTF-32 to UTF-8 failed in encoding_utf32_to_utf8.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+
+    // Resize the output to the actual UTF-8 string length
+    size_t actualLength = targetStart - output;
+    uint8_t* resizedOutput = (uint8_t*)ma_allocator_realloc(output, actualLength + 1);
+    // if (resizedOutput) {
+    //     resizedOutput[actualLength] = '\0';
+    //     return resizedOutput;
+    // }
+
+    // return output;
+
+    if (!resizedOutput) {
+        printf("Error: Reallocation failed in encoding_utf32_to_utf8.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+    resizedOutput[actualLength] = '\0';
+
+    return resizedOutput;
+}
+
+bool ma_encoding_is_utf8_string(const uint8_t** input, size_t length) {
+    if (input == NULL || *input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_is_utf8_string.\n");
+        return false;
+    }
+
+    const uint8_t* source = *input;
+    const uint8_t* sourceEnd = source + length;
+
+    while (source < sourceEnd) {
+        int trailLength = trailingBytesForUTF8[*source] + 1;
+        if (trailLength > sourceEnd - source || !ma_encoding_is_utf8(source, trailLength)) {
+            printf("Error: Invalid UTF-8 encoding detected in encoding_is_utf8_string.\n");
+            return false;
+        }
+        source += trailLength;
+    }
+
+    *input = source; // Update the input pointer to the end of the string
+    return true;
+}
+
+uint16_t* ma_encoding_utf8_to_utf16(const uint8_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encoding_utf8_to_utf16.\n");
+        return NULL;
+    }
+    // Estimate maximum output size (each UTF-8 character can be at most 4 bytes,
+    // but can translate to at most 2 UTF-16 characters)
+    size_t maxOutLength = length * 2;
+    uint16_t* output = (uint16_t*)ma_allocator_alloc(maxOutLength * sizeof(uint16_t));
+    if (!output) {
+        printf("Error: Memory allocation failed for output in encoding_utf8_to_utf16.\n");
+        return NULL;
+    }
+
+    const uint8_t* sourceStart = input;
+    const uint8_t* sourceEnd = input + length;
+    uint16_t* targetStart = output;
+    uint16_t* targetEnd = output + maxOutLength;
+
+    ConversionResult result = ConvertUTF8toUTF16(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+
+    if (result != conversionOK) {
+        printf("Error: Conversion from UTF-8 to UTF-16 failed in encoding_utf8_to_utf16.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+    // Resize the output to the actual UTF-16 string length
+    size_t actualLength = targetStart - output;
+    uint16_t* resizedOutput = (uint16_t*)ma_allocator_realloc(output, actualLength * sizeof(uint16_t) + 1);
+    if (!resizedOutput) {
+        printf("Error: Reallocation failed in encoding_utf8_to_utf16.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+    resizedOutput[actualLength] = '\0'; // Null-terminate the UTF-16 string
+
+    return resizedOutput;
+}
+
+uint32_t* ma_encoding_utf8_to_utf32(const uint8_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encododing_utf8_to_utf32.\n");
+        return NULL;
+    }
+
+    // Estimate maximum output size (each UTF-8 character can be at most 4 bytes,
+    // translating to a single UTF-32 character)
+    size_t maxOutLength = length;
+    uint32_t* output = (uint32_t*)ma_allocator_alloc(maxOutLength * sizeof(uint32_t));
+    if (!output) {
+        printf("Error: Can not Allocate memory in encoding_utf8_to_utf32.\n");
+        return NULL; // Memory allocation failed
+    }
+
+    const uint8_t* sourceStart = input;
+    const uint8_t* sourceEnd = input + length;
+    uint32_t* targetStart = output;
+    uint32_t* targetEnd = output + maxOutLength;
+
+    ConversionResult result = ConvertUTF8toUTF32(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+
+    if (result != conversionOK) {
+        printf("Error: Failed Convertion to UTF32 in encoding_utf8_to_utf32.\n");
+        ma_allocator_free(output);
+        return NULL;
+    }
+
+    // Resize the output to the actual UTF-32 string length
+    size_t actualLength = targetStart - output;
+    uint32_t* resizedOutput = (uint32_t*)ma_allocator_realloc(output, (actualLength + 1) * sizeof(uint32_t));
+    if (resizedOutput) {
+        resizedOutput[actualLength] = 0; // Null-terminate the UTF-32 string
+        return resizedOutput;
+    }
+    return output;
+}
+
+void encoding_hex_dump(const void *data, size_t size) {
+    const unsigned char *byte = (const unsigned char *)data;
+    size_t i, j;
+
+    for (i = 0; i < size; i += 16) {
+        printf("%08zx  ", i); // Print the offset
+
+        // Print hex values
+        for (j = 0; j < 16; j++) {
+            if (i + j < size) {
+                printf("%02x ", byte[i + j]);
+            } else {
+                printf("   "); // Fill space if less than 16 bytes in a line
+            }
+        }
+        printf(" |");
+
+        // Print ASCII representation
+        for (j = 0; j < 16; j++) {
+            if (i + j < size) {
+                printf("%c", isprint(byte[i + j]) ? byte[i + j] : '.');
+            }
+        }
+        printf("|\n");
+    }
+}
+
+char* ma_encododing_base85_encode(const uint8_t* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encododing_base85_encode.\n");
+        return NULL;
+    }
+
+    // Calculate the maximum possible length of the encoded string
+    size_t encoded_max_length = ((length + 3) / 4) * 5 + 2; // +2 for potential padding and null terminator
+    char* encoded = ma_allocator_alloc(encoded_max_length);
+    if (!encoded) {
+        printf("Error: Memory allocation failed for encoded string in encododing_base85_encode.\n");
+        return NULL;
+    }
+
+    size_t input_index = 0;
+    size_t encoded_index = 0;
+    while (input_index < length) {
+        uint32_t acc = 0;
+        size_t chunk_len = (length - input_index < 4) ? (length - input_index) : 4;
+
+        for (size_t i = 0; i < chunk_len; ++i) {
+            acc = (acc << 8) | input[input_index++];
+        }
+
+        if (chunk_len < 4) {
+            acc <<= (4 - chunk_len) * 8; // Padding
+        }
+        if (acc == 0 && chunk_len == 4) {
+            encoded[encoded_index++] = 'z';
+        }
+        else {
+            for (int i = 4; i >= 0; --i) {
+                encoded[encoded_index + i] = (acc % 85) + 33;
+                acc /= 85;
+            }
+            encoded_index += 5;
+
+            if (chunk_len < 4) {
+                encoded_index -= (4 - chunk_len);  // Adjust for padding
+                break;
+            }
+        }
+    }
+
+    encoded[encoded_index] = '\0';
+
+    return encoded;
+}
+
+uint8_t* ma_encododing_base85_decode(const char* input, size_t length) {
+    if (input == NULL || length == 0) {
+        printf("Error: Invalid input or length in encododing_base85_decode.\n");
+        return NULL;
+    }
+
+    // Calculate the maximum possible length of the decoded string
+    size_t decoded_max_length = (length / 5) * 4;
+    uint8_t* decoded = ma_allocator_alloc(decoded_max_length);
+    if (!decoded) {
+        printf("Error: Memory allocation failed for decoded string in encododing_base85_decode.\n");
+        return NULL;
+    }
+
+    size_t input_index = 0;
+    size_t decoded_index = 0;
+    while (input_index < length) {
+        if (isspace(input[input_index])) {
+            input_index++;   // Skip whitespace
+            continue;
+        }
+        if (input[input_index] == 'z') {
+            // Special case: 'z' represents four zero bytes
+            memset(decoded + decoded_index, 0, 4);
+            decoded_index += 4;
+            input_index++;
+            continue;
+        }
+
+        uint32_t acc = 0;
+        int count = 0;
+        for (int i = 0; i < 5 && input_index < length; ++i) {
+            if (isspace(input[input_index])) {
+                // Skip whitespace within the group
+                input_index++;
+                continue;
+            }
+
+            char ch = input[input_index++];
+            if (ch < 33 || ch > 117) {
+                printf("Error: Invalid character encountered in encododing_base85_decode.\n");
+                ma_allocator_free(decoded);
+                return NULL; // Invalid character
+            }
+
+            acc = acc * 85 + (ch - 33);
+            count++;
+        }
+
+        int padding = 0;
+        if (count < 5) {
+            padding = 5 - count;
+            for (int i = 0; i < padding; i++) {
+                acc = acc * 85 + 84; // Assume 'u' for padding, which is the highest value (84)
+            }
+        }
+
+        for (int i = 3; i >= 0; --i) {
+            if (i < padding) {
+                break; // Ignore padding bytes
+            }
+            decoded[decoded_index++] = (acc >> (i * 8)) & 0xFF;
+        }
+
+        if (count < 5) {
+            break; // End of data
+        }
+    }
+
+    // Resize the output buffer to the actual decoded data length
+    uint8_t* resized_decoded = ma_allocator_realloc(decoded, decoded_index + 1); // +1 for null terminator, if needed
+    if (!resized_decoded) {
+        printf("Error: Reallocation failed in encododing_base85_decode.\n");
+        ma_allocator_free(decoded);
+        return NULL;
+    }
+
+    resized_decoded[decoded_index] = '\0'; // Null-terminate if treating as a C-style string
+
+    return resized_decoded;
+}
+
+char* ma_encoding_base58_encode(const void *data, size_t binsz) {
+    if (!data) {
+        printf("Error: Invalid input data in encoding_base58_encode.\n");
+        return NULL;
+    }
+
+    const uint8_t *bin = data;
+    int carry;
+    size_t i, j, high, zcount = 0;
+    size_t size;
+
+    while (zcount < binsz && !bin[zcount]) {
+        ++zcount;
+    }
+
+    size = (binsz - zcount) * 138 / 100 + 1;
+    uint8_t *buf = ma_allocator_alloc(size * sizeof(uint8_t));
+    if (!buf) {
+        printf("Error: Memory allocation failed for buffer in encoding_base58_encode.\n");
+        return NULL;
+    }
+    memset(buf, 0, size);
+
+    for (i = zcount, high = size - 1; i < binsz; ++i, high = j) {
+        for (carry = bin[i], j = size - 1; (j > high) || carry; --j) {
+            carry += 256 * buf[j];
+            buf[j] = carry % 58;
+            carry /= 58;
+
+            if (!j) {
+                break;
+            }
+        }
+    }
+
+    for (j = 0; j < size && !buf[j]; ++j) {
+        // Skip leading zeros in binary
+    }
+
+    size_t b58sz = zcount + size - j + 1;
+    char *b58 = ma_allocator_alloc(b58sz);
+    if (!b58) {
+        printf("Error: Memory allocation failed for Base58 encoding in encoding_base58_encode.\n");
+        ma_allocator_free(buf);
+        return NULL;
+    }
+    if (zcount) {
+        memset(b58, '1', zcount);
+    }
+    for (i = zcount; j < size; ++i, ++j) {
+        b58[i] = b58digits_ordered[buf[j]];
+    }
+    b58[i] = '\0';
+
+    ma_allocator_free(buf);
+
+    return b58;
+}
+
+char* ma_encoding_base58_decode(const char *b58, size_t *binszp) {
+    if (b58 == NULL || binszp == NULL) {
+        printf("Error: Invalid input or binszp pointer in encoding_base58_decode.\n");
+        return NULL;
+    }
+
+    size_t b58sz = strlen(b58);
+    size_t binsz = b58sz * 733 / 1000 + 1; // Rough estimate of binary size
+    uint8_t *bin = ma_allocator_alloc(binsz);
+    if (!bin) {
+        printf("Error: Memory allocation failed in encoding_base58_decode.\n");
+        return NULL;
+    }
+    memset(bin, 0, binsz);
+
+    size_t i, j;
+    int carry;
+    size_t high = binsz - 1;
+
+    // Process the Base58 string
+    for (i = 0; i < b58sz; ++i) {
+        if (b58[i] & 0x80 || b58digits_map[(unsigned char)b58[i]] == -1) {
+            printf("Error: Invalid Base58 character encountered in encoding_base58_decode.\n");
+            ma_allocator_free(bin);
+            return NULL; // Invalid Base58 character
+        }
+
+        for (carry = b58digits_map[(unsigned char)b58[i]], j = binsz - 1; (j > high) || carry; --j) {
+            carry += 58 * bin[j];
+            bin[j] = carry % 256;
+            carry /= 256;
+
+            if (!j) {
+                break; // Avoid wraparound
+            }
+        }
+        high = j;
+    }
+
+    for (j = 0; j < binsz && !bin[j]; ++j) {
+        // Skip leading zeros in binary
+    }
+
+    *binszp = binsz - j;
+    char *result = ma_allocator_alloc(*binszp);
+
+    if (!result) {
+        printf("Error: Memory allocation failed for result in encoding_base58_decode.\n");
+        ma_allocator_free(bin);
+        return NULL;
+    }
+    memcpy(result, bin + j, *binszp);
+
+    ma_allocator_free(bin);
+    return result;
+}
+
+uint8_t* ma_encoding_base91_decode(const char* encoded, size_t* decoded_length) {
+    if (!encoded || !decoded_length) {
+        printf("Error: Invalid input or decoded_length pointer in encoding_base91_decode.\n");
+        return NULL;
+    }
+
+    size_t len = strlen(encoded);
+    *decoded_length = 0;
+    uint8_t* decoded = ma_allocator_alloc(len); // Max possible size
+    if (!decoded) {
+        printf("Error: Memory allocation failed in encoding_base91_decode.\n");
+        return NULL;
+    }
+
+    int v = -1;
+    int b = 0;
+    int n = 0;
+    size_t index = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        int c = base91_decode_value(encoded[i]);
+        if (c == -1) {
+            printf("Error: Invalid character encountered in encoding_base91_decode.\n");
+            ma_allocator_free(decoded);
+            return NULL; // Invalid character
+        }
+
+        if (v < 0) {
+            v = c;
+        }
+        else {
+            v += c * 91;
+            b |= v << n;
+            n += (v & 8191) > 88 ? 13 : 14;
+
+            while (n > 7) {
+                decoded[index++] = (uint8_t)(b & 255);
+                b >>= 8;
+                n -= 8;
+            }
+            v = -1;
+        }
+    }
+
+    if (v != -1) {
+        if (index >= len) {
+            printf("Error: Decoded index out of bounds in encoding_base91_decode.\n");
+            ma_allocator_free(decoded);
+            return NULL;
+        }
+        decoded[index++] = (uint8_t)((b | v << n) & 255);
+    }
+
+    *decoded_length = index;
+
+    return decoded;
+}
+
+char* ma_encoding_base91_encode(const uint8_t* data, size_t length) {
+    if (!data || length == 0) {
+        printf("Error: Invalid input data or length in encoding_base91_encode.\n");
+        return NULL;
+    }
+
+    size_t estimated_length = length * 1.23 + 2; // +2 for padding and null terminator
+    char* encoded = ma_allocator_alloc(estimated_length);
+    if (!encoded) {
+        printf("Error: Memory allocation failed in encoding_base91_encode.\n");
+        return NULL;
+    }
+
+    size_t index = 0;
+    int b = 0;
+    int n = 0;
+    int v;
+
+    for (size_t i = 0; i < length; ++i) {
+        b |= (data[i] << n);
+        n += 8;
+
+        if (n > 13) {
+            v = b & 8191;
+
+            if (v > 88) {
+                b >>= 13;
+                n -= 13;
+            }
+            else {
+                v = b & 16383;
+                b >>= 14;
+                n -= 14;
+            }
+
+            if (index + 2 < estimated_length) {
+                encoded[index++] = BASE91_ALPHABET[v % 91];
+                encoded[index++] = BASE91_ALPHABET[v / 91];
+            }
+            else {
+                printf("Error: Encoding index out of bounds in encoding_base91_encode.\n");
+                ma_allocator_free(encoded);
+                return NULL;
+            }
+        }
+    }
+
+    if (n) {
+        if (index + 1 < estimated_length) {
+            encoded[index++] = BASE91_ALPHABET[b % 91];
+        }
+        if (n > 7 || b > 90) {
+            if (index + 1 < estimated_length) {
+                encoded[index++] = BASE91_ALPHABET[b / 91];
+            }
+        }
+    }
+
+    encoded[index] = '\0';
+
+    return encoded;
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+    // Function to convert UTF-8 string to wchar_t string (Windows only)
+    wchar_t* encoding_utf8_to_wchar(const char* utf8Str) {
+        if (utf8Str == NULL) {
+            printf("Error: Input string is NULL\n");
+            return NULL;
+        }
+
+        int size_needed = MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, NULL, 0);
+        if (size_needed == 0) {
+        printf("Error: MultiByteToWideChar failed to calculate size. Error: %lu\n", GetLastError());
+            return NULL;
+        }
+
+        wchar_t* wstr = (wchar_t*)ma_allocator_alloc(size_needed * sizeof(wchar_t));
+        if (!wstr) {
+            printf("Error: Cannot allocate memory for wchar\n");
+            return NULL;
+        }
+
+        int result = MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, wstr, size_needed);
+        if (result == 0) {
+            printf("Error: Conversion from UTF-8 to wchar failed\n");
+            ma_allocator_free(wstr);
+            return NULL;
+        }
+
+        return wstr;
+    }
+
+    char* ma_encoding_wchar_to_utf8(const wchar_t* wstr) {
+        if (wstr == NULL) {
+            printf("Error: Input wchar string is NULL\n");
+            return NULL;
+        }
+
+        // Get the length of the required buffer
+        int utf8Length = WideCharToMultiByte(CP_UTF8, 0, wstr, -1, NULL, 0, NULL, NULL);
+        if (utf8Length == 0) {
+            printf("Error: WideCharToMultiByte failed to calculate length\n");
+            return NULL;
+        }
+
+        char* utf8Str = ma_allocator_alloc(utf8Length * sizeof(char));
+        if (!utf8Str) {
+            printf("Error: Cannot allocate memory for UTF-8 string\n");
+            return NULL;
+        }
+        // Convert the wide-character string to UTF-8
+        if (WideCharToMultiByte(CP_UTF8, 0, wstr, -1, utf8Str, utf8Length, NULL, NULL) == 0) {
+            printf("Error: Conversion from wchar to UTF-8 failed\n");
+            ma_allocator_free(utf8Str);
+            return NULL;
+        }
+
+        return utf8Str;
+    }
+#endif
+
+void ma_encoding_initialize(void) {
+    setlocale(LC_ALL, "");
+}
+
+// ------------------------------------------------------------------------- //
+//                              String                                       //
+// ------------------------------------------------------------------------- //
+
+const char* STRING_ASCII_LETTERS = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char* STRING_ASCII_LOWERCASE = "abcdefghijklmnopqrstuvwxyz";
+const char* STRING_ASCII_UPPERCASE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char* STRING_DIGITS = "0123456789";
+const char* STRING_HEXDIGITS = "0123456789abcdefABCDEF";
+const char* STRING_WHITESPACE = " \t\n\r\f\v";
+const char* STRING_PUNCTUATION = "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+// Global pool: each thread allocates from its own pool whose chunks are refill
+// blocks taken from the process-wide region, so pooled Strings never share a
+// free list or bump pointer across threads.
+static MA_THREAD_LOCAL MemoryPoolString thread_global_pool;
+static MA_THREAD_LOCAL unsigned int thread_global_pool_generation = 0;
+
+// Arena mode: every String created on a thread shares that thread's arena
+static MA_THREAD_LOCAL MemoryPoolString* thread_arena = NULL;
+static MA_THREAD_LOCAL bool thread_arena_mode = false;
+
+void ma_string_init_global_memory_pool(size_t size) {
+    if (!ma_memory_pool_global_init(size)) {
+        printf("Error: Failed to create the global memory pool in string_init_global_memory_pool.\n");
+    }
+}
+
+// Must only be called once no thread allocates from the global pool anymore.
+void ma_string_destroy_global_memory_pool(void) {
+    ma_memory_pool_global_destroy();
+}
+
+// Calling thread's pool on top of the global region, reattached after the region was destroyed.
+static MemoryPoolString* ma_string_global_thread_pool(void) {
+    unsigned int generation = atomic_load_explicit(&global_region_generation, memory_order_acquire);
+    MemoryPoolString *pool = &thread_global_pool;
+
+    if (pool->chunks == NULL || thread_global_pool_generation != generation) {
+        memset(pool, 0, sizeof(MemoryPoolString));
+        pool->backend = MEMORY_POOL_BACKEND_GLOBAL;
+        pool->growthFactor = 1;
+        pool->nextChunkSize = MA_MEMORY_POOL_GLOBAL_REFILL_SIZE;
+
+        pool->chunks = ma_memory_pool_chunk_create(MEMORY_POOL_BACKEND_GLOBAL, NULL, MA_MEMORY_POOL_GLOBAL_REFILL_SIZE);
+        if (pool->chunks == NULL) {
+            printf("Error: Failed to refill from the global memory pool.\n");
+            return NULL;
+        }
+        pool->pool = MA_MEMORY_POOL_CHUNK_DATA(pool->chunks);
+        pool->poolSize = pool->chunks->size;
+        thread_global_pool_generation = generation;
+    }
+
+    return pool;
+}
+
+static MemoryPoolString* ma_string_memory_pool_create_with_backend(MemoryPoolBackend backend, size_t size) {
+    const Allocator *allocator = ma_allocator_get();
+    MemoryPoolString *pool = ma_allocator_alloc_with(allocator, sizeof(MemoryPoolString));
+    if (pool) {
+        pool->allocator = allocator;
+        pool->chunks = ma_memory_pool_chunk_create(backend, allocator, size);
+        if (!pool->chunks) {
+            ma_allocator_free_with(allocator, pool);
+            return NULL;
+        }
+
+        pool->pool = MA_MEMORY_POOL_CHUNK_DATA(pool->chunks);
+        pool->poolSize = pool->chunks->size;
+        pool->used = 0;
+        pool->growthFactor = MA_MEMORY_POOL_GROWTH_FACTOR;
+        pool->maxChunkSize = 0;
+        pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->chunks->size, pool->growthFactor, pool->maxChunkSize);
+        memset(pool->freeLists, 0, sizeof(pool->freeLists));
+        pool->backend = backend;
+        pool->spareChunks = NULL;
+        memset(&pool->stats, 0, sizeof(pool->stats));
+    }
+    return pool;
+}
+
+MemoryPoolString* ma_string_memory_pool_create(size_t size) {
+    return ma_string_memory_pool_create_with_backend(MEMORY_POOL_BACKEND_HEAP, size);
+}
+
+MemoryPoolString* ma_string_memory_pool_create_reserved(size_t reserveSize, bool hugePages) {
+    MemoryPoolString *pool = ma_string_memory_pool_create_with_backend(hugePages ? MEMORY_POOL_BACKEND_MMAP_HUGE : MEMORY_POOL_BACKEND_MMAP, reserveSize);
+    if (pool == NULL) {
+        printf("Error: Failed to reserve %zu bytes in memory_pool_create_reserved.\n", reserveSize);
+    }
+    return pool;
+}
+
+// Chains a new chunk able to hold at least `size` bytes in front of the current one.
+static bool ma_string_memory_pool_grow(MemoryPoolString *pool, size_t size) {
+    size_t chunkSize = (size > pool->nextChunkSize) ? size : pool->nextChunkSize;
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+
+    ma_memory_pool_stats_exhausted(&pool->stats, pool->chunks);
+
+    MemoryPoolChunk *chunk = ma_memory_pool_take_spare(&pool->spareChunks, size); // Reuse a chunk released by a rewind
+    if (!chunk) {
+        chunk = ma_memory_pool_chunk_create(pool->backend, pool->allocator, chunkSize);
+        if (!chunk) {
+            printf("Error: Failed to allocate a chunk of %zu bytes in memory_pool_allocate.\n", chunkSize);
+            return false;
+        }
+        pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->nextChunkSize, pool->growthFactor, pool->maxChunkSize);
+    }
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->pool = MA_MEMORY_POOL_CHUNK_DATA(chunk);
+    pool->poolSize += chunk->size; // Mapped chunks are rounded up to whole pages
+
+    return true;
+}
+
+void* ma_string_memory_pool_allocate(MemoryPoolString *pool, size_t size) {
+    return ma_string_memory_pool_allocate_aligned(pool, size, MA_MEMORY_POOL_MIN_ALIGNMENT);
+}
+
+void* ma_string_memory_pool_allocate_aligned(MemoryPoolString *pool, size_t size, size_t alignment) {
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_allocate.\n");
+        return NULL;
+    }
+
+    alignment = ma_memory_pool_alignment(alignment);
+    if (alignment == 0) {
+        printf("Error: Alignment must be a power of two in memory_pool_allocate.\n");
+        return NULL;
+    }
+
+    size_t requested = size;
+    size_t sizeClass = ma_memory_pool_size_class(size);
+    if (sizeClass < MA_MEMORY_POOL_SIZE_CLASSES) {
+        size = MA_MEMORY_POOL_CLASS_SIZE(sizeClass);
+
+        void *block = pool->freeLists[sizeClass];
+        if (block && ma_memory_pool_align_padding(block, alignment) == 0) {
+            pool->freeLists[sizeClass] = *(void **)block; // Reuse a released block of the same class
+            ma_memory_pool_stats_allocated(&pool->stats, requested, size, 0, pool->used);
+            return block;
+        }
+    }
+
+    MemoryPoolChunk *chunk = pool->chunks;
+    size_t padding = ma_memory_pool_align_padding((char *)pool->pool + chunk->used, alignment);
+    if (!ma_memory_pool_chunk_fits(chunk, padding, size)) {
+        if (size > SIZE_MAX - alignment || !ma_string_memory_pool_grow(pool, size + alignment - 1)) {
+            return NULL; // The system is out of memory
+        }
+        chunk = pool->chunks;
+        padding = ma_memory_pool_align_padding((char *)pool->pool + chunk->used, alignment);
+    }
+
+    void *mem = (char *)pool->pool + chunk->used + padding;
+    chunk->used += padding + size;
+    pool->used += padding + size;
+    ma_memory_pool_stats_allocated(&pool->stats, requested, size, padding, pool->used);
+
+    return mem;
+}
+
+void ma_string_memory_pool_free(MemoryPoolString *pool, void *ptr, size_t size) {
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+
+    size_t sizeClass = ma_memory_pool_size_class(size);
+    if (sizeClass >= MA_MEMORY_POOL_SIZE_CLASSES) {
+        ma_memory_pool_stats_freed(&pool->stats, size, false);
+        return; // Oversized blocks are not recycled
+    }
+    ma_memory_pool_stats_freed(&pool->stats, MA_MEMORY_POOL_CLASS_SIZE(sizeClass), true);
+
+    *(void **)ptr = pool->freeLists[sizeClass];
+    pool->freeLists[sizeClass] = ptr;
+}
+
+void ma_string_memory_pool_set_growth(MemoryPoolString *pool, size_t growthFactor, size_t maxChunkSize) {
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_set_growth.\n");
+        return;
+    }
+
+    pool->growthFactor = growthFactor == 0 ? 1 : growthFactor;
+    pool->maxChunkSize = maxChunkSize;
+    pool->nextChunkSize = ma_memory_pool_grow_chunk_size(pool->chunks->size, pool->growthFactor, pool->maxChunkSize);
+}
+
+MemoryPoolStats ma_string_memory_pool_stats(const MemoryPoolString *pool) {
+    MemoryPoolStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_stats.\n");
+        return stats;
+    }
+    return pool->stats;
+}
+
+MemoryPoolMark ma_string_memory_pool_mark(MemoryPoolString *pool) {
+    MemoryPoolMark mark = {NULL, 0, 0, 0, 0};
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_mark.\n");
+        return mark;
+    }
+
+    mark.chunk = pool->chunks;
+    mark.chunkUsed = pool->chunks->used;
+    mark.used = pool->used;
+    mark.liveBytes = pool->stats.liveBytes;
+    mark.wastedBytes = pool->stats.wastedBytes;
+
+    return mark;
+}
+
+// Releases everything allocated after `mark`. Free lists are dropped because they
+// may hold blocks from the released region.
+void ma_string_memory_pool_rewind(MemoryPoolString *pool, MemoryPoolMark mark) {
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_rewind.\n");
+        return;
+    }
+
+    size_t releasedSize = 0;
+    if (!ma_memory_pool_rewind_chunks(&pool->chunks, &pool->spareChunks, &mark, &releasedSize)) {
+        printf("Error: Mark does not belong to this memory pool in memory_pool_rewind.\n");
+        return;
+    }
+
+    pool->pool = MA_MEMORY_POOL_CHUNK_DATA(pool->chunks);
+    pool->poolSize -= releasedSize;
+    pool->used = mark.used;
+    memset(pool->freeLists, 0, sizeof(pool->freeLists));
+    ma_memory_pool_stats_rewound(&pool->stats, &mark);
+}
+
+// Releases every allocation of the pool while keeping its chunks for reuse.
+void ma_string_memory_pool_reset(MemoryPoolString *pool) {
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in memory_pool_reset.\n");
+        return;
+    }
+
+    MemoryPoolMark mark = {pool->chunks, 0, 0, 0, 0};
+    while (mark.chunk->next) {
+        mark.chunk = mark.chunk->next;
+    }
+    ma_string_memory_pool_rewind(pool, mark);
+
+    ma_memory_pool_chunks_decommit(pool->backend, pool->chunks);
+    ma_memory_pool_chunks_decommit(pool->backend, pool->spareChunks);
+}
+
+void ma_string_memory_pool_destroy(MemoryPoolString *pool) {
+    if (pool == NULL) {
+        printf("Warning: Attempt to destroy a NULL memory pool in memory_pool_destroy.\n");
+        return;
+    }
+    ma_memory_pool_stats_destroyed("string memory pool", &pool->stats);
+    ma_memory_pool_chunks_destroy(pool->backend, pool->allocator, pool->chunks);
+    ma_memory_pool_chunks_destroy(pool->backend, pool->allocator, pool->spareChunks);
+    ma_allocator_free_with(pool->allocator, pool);
+}
+
+// Pool that buffers of `str` are allocated from and released to on the calling thread.
+// An owned pool is only created once the contents outgrow the inline buffer.
+static MemoryPoolString *ma_string_pool(String *str) {
+    if (str->poolKind == STRING_POOL_GLOBAL) {
+        return ma_string_global_thread_pool();
+    }
+    if (str->pool == NULL && str->poolKind == STRING_POOL_OWNED) {
+        str->pool = ma_string_memory_pool_create(MA_STRING_OWNED_POOL_SIZE);
+        if (str->pool == NULL) {
+            printf("Error: Memory pool creation failed in string_pool.\n");
+        }
+    }
+    return str->pool;
+}
+
+static bool ma_string_is_inline(const String *str) {
+    return str->dataStr == str->inlineStr;
+}
+
+// Hands the data buffer of `str` back to `pool` unless it is the inline buffer.
+static void ma_string_release_data(String *str, MemoryPoolString *pool, char *data, size_t capacity) {
+    if (data != NULL && data != str->inlineStr) {
+        ma_string_memory_pool_free(pool, data, capacity);
+    }
+}
+
+// Moves the contents of `str` into a buffer of `newCapacity` bytes, the inline
+// buffer when they fit in it, and hands the previous buffer back to the pool so
+// that later allocations can reuse it.
+static bool ma_string_reallocate(String *str, size_t newCapacity) {
+    size_t keep = (str->size < newCapacity) ? str->size : newCapacity - 1;
+
+    if (newCapacity <= MA_STRING_INLINE_CAPACITY) {
+        if (!ma_string_is_inline(str)) {
+            char *oldData = str->dataStr;
+            if (oldData) {
+                memcpy(str->inlineStr, oldData, keep);
+            }
+            ma_string_release_data(str, ma_string_pool(str), oldData, str->capacitySize);
+            str->dataStr = str->inlineStr;
+            str->capacitySize = MA_STRING_INLINE_CAPACITY;
+        }
+        str->dataStr[keep] = '\0';
+        return true;
+    }
+
+    MemoryPoolString *pool = ma_string_pool(str);
+    char *newData = ma_string_memory_pool_allocate(pool, newCapacity);
+    if (!newData) {
+        return false;
+    }
+
+    if (str->dataStr) {
+        memcpy(newData, str->dataStr, keep);
+    }
+    newData[keep] = '\0';
+
+    ma_string_release_data(str, pool, str->dataStr, str->capacitySize);
+    str->dataStr = newData;
+    str->capacitySize = newCapacity;
+
+    return true;
+}
+
+// Index of the lowest set bit, `mask` must not be zero.
+static inline unsigned ma_string_lowest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    unsigned index = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Index of the highest set bit, `mask` must not be zero.
+static inline unsigned ma_string_highest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - (unsigned)__builtin_clz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned)index;
+#else
+    unsigned index = 31;
+    while ((mask & 0x80000000u) == 0) {
+        mask <<= 1;
+        index--;
+    }
+    return index;
+#endif
+}
+
+#if defined(MA_STRING_SIMD_WIDTH)
+// Thin layer over the SIMD instructions the String kernels use, so each kernel
+// is written once for both AVX2 and SSE2.
+#if MA_STRING_SIMD_WIDTH == 32
+typedef __m256i SimdBlock;
+#define MA_SIMD_FULL_MASK 0xFFFFFFFFu
+
+static inline SimdBlock ma_simd_load(const char *p) { return _mm256_loadu_si256((const __m256i *)p); }
+static inline void ma_simd_store(char *p, SimdBlock v) { _mm256_storeu_si256((__m256i *)p, v); }
+static inline SimdBlock ma_simd_splat(char c) { return _mm256_set1_epi8(c); }
+static inline SimdBlock ma_simd_and(SimdBlock a, SimdBlock b) { return _mm256_and_si256(a, b); }
+static inline SimdBlock ma_simd_or(SimdBlock a, SimdBlock b) { return _mm256_or_si256(a, b); }
+static inline SimdBlock ma_simd_xor(SimdBlock a, SimdBlock b) { return _mm256_xor_si256(a, b); }
+static inline SimdBlock ma_simd_cmpeq(SimdBlock a, SimdBlock b) { return _mm256_cmpeq_epi8(a, b); }
+static inline SimdBlock ma_simd_cmpgt(SimdBlock a, SimdBlock b) { return _mm256_cmpgt_epi8(a, b); }
+static inline uint32_t ma_simd_movemask(SimdBlock v) { return (uint32_t)_mm256_movemask_epi8(v); }
+#else
+typedef __m128i SimdBlock;
+#define MA_SIMD_FULL_MASK 0xFFFFu
+
+static inline SimdBlock ma_simd_load(const char *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline void ma_simd_store(char *p, SimdBlock v) { _mm_storeu_si128((__m128i *)p, v); }
+static inline SimdBlock ma_simd_splat(char c) { return _mm_set1_epi8(c); }
+static inline SimdBlock ma_simd_and(SimdBlock a, SimdBlock b) { return _mm_and_si128(a, b); }
+static inline SimdBlock ma_simd_or(SimdBlock a, SimdBlock b) { return _mm_or_si128(a, b); }
+static inline SimdBlock ma_simd_xor(SimdBlock a, SimdBlock b) { return _mm_xor_si128(a, b); }
+static inline SimdBlock ma_simd_cmpeq(SimdBlock a, SimdBlock b) { return _mm_cmpeq_epi8(a, b); }
+static inline SimdBlock ma_simd_cmpgt(SimdBlock a, SimdBlock b) { return _mm_cmpgt_epi8(a, b); }
+static inline uint32_t ma_simd_movemask(SimdBlock v) { return (uint32_t)_mm_movemask_epi8(v); }
+#endif
+
+// Lanes holding a byte in [lo, hi]. The comparison is signed, so it only
+// works for ASCII bounds, and bytes of 0x80 and above are never in range.
+static inline SimdBlock ma_simd_in_range(SimdBlock v, char lo, char hi) {
+    return ma_simd_and(ma_simd_cmpgt(v, ma_simd_splat((char)(lo - 1))), ma_simd_cmpgt(ma_simd_splat((char)(hi + 1)), v));
+}
+
+// Bit i is set when block[i] is `first` and block[i + lastOffset] is `last`,
+// for the MA_STRING_SIMD_WIDTH candidate positions starting at `block`.
+static inline uint32_t ma_string_search_candidates(const char *block, size_t lastOffset, char first, char last) {
+    SimdBlock firstEq = ma_simd_cmpeq(ma_simd_load(block), ma_simd_splat(first));
+    SimdBlock lastEq = ma_simd_cmpeq(ma_simd_load(block + lastOffset), ma_simd_splat(last));
+    return ma_simd_movemask(ma_simd_and(firstEq, lastEq));
+}
+#endif
+
+// Whether the needle starts at `candidate`, whose first and last bytes are
+// already known to match.
+static inline bool ma_string_search_matches(const char *candidate, const char *needle, size_t needleLength) {
+    return needleLength <= 2 || memcmp(candidate + 1, needle + 1, needleLength - 2) == 0;
+}
+
+// Filters candidate positions on the first and last byte of the needle, a whole
+// SIMD block at a time, and only compares the middle of the needle on a hit.
+// Requires 2 <= needleLength <= haystackLength.
+static const char *ma_string_search_filtered(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength) {
+    size_t last = haystackLength - needleLength;  // Last possible start of a match
+    size_t pos = 0;
+    char lastByte = needle[needleLength - 1];
+
+#if defined(MA_STRING_SIMD_WIDTH)
+    for (; pos <= last && last - pos >= MA_STRING_SIMD_WIDTH - 1; pos += MA_STRING_SIMD_WIDTH) {
+        uint32_t mask = ma_string_search_candidates(haystack + pos, needleLength - 1, needle[0], lastByte);
+        while (mask != 0) {
+            const char *candidate = haystack + pos + ma_string_lowest_bit(mask);
+            if (ma_string_search_matches(candidate, needle, needleLength)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (pos <= last) {
+        const char *candidate = memchr(haystack + pos, needle[0], last - pos + 1);
+        if (candidate == NULL) {
+            return NULL;
+        }
+        if (candidate[needleLength - 1] == lastByte && ma_string_search_matches(candidate, needle, needleLength)) {
+            return candidate;
+        }
+        pos = (size_t)(candidate - haystack) + 1;
+    }
+    return NULL;
+}
+
+// Same filter as ma_string_search_filtered, walking from the end of the
+// haystack. Requires 1 <= needleLength <= haystackLength.
+static const char *ma_string_search_filtered_reverse(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength) {
+    size_t end = haystackLength - needleLength + 1;  // Candidates left to examine are [0, end)
+    char lastByte = needle[needleLength - 1];
+
+#if defined(MA_STRING_SIMD_WIDTH)
+    while (end >= MA_STRING_SIMD_WIDTH) {
+        size_t block = end - MA_STRING_SIMD_WIDTH;
+        uint32_t mask = ma_string_search_candidates(haystack + block, needleLength - 1, needle[0], lastByte);
+        while (mask != 0) {
+            unsigned bit = ma_string_highest_bit(mask);
+            const char *candidate = haystack + block + bit;
+            if (ma_string_search_matches(candidate, needle, needleLength)) {
+                return candidate;
+            }
+            mask &= ~(1u << bit);
+        }
+        end = block;
+    }
+#endif
+
+    while (end > 0) {
+        const char *candidate = haystack + --end;
+        if (candidate[0] == needle[0] && candidate[needleLength - 1] == lastByte && ma_string_search_matches(candidate, needle, needleLength)) {
+            return candidate;
+        }
+    }
+    return NULL;
+}
+
+// Byte `i` of `str`, counted from the end when `reverse` is set.
+static inline unsigned char ma_string_two_way_at(const char *str, size_t length, size_t i, bool reverse) {
+    return (unsigned char)str[reverse ? length - 1 - i : i];
+}
+
+// Crochemore-Perrin Two-Way search with a last-byte shift table. It runs in
+// O(haystack + needle) time and constant space whatever the input, which the
+// byte filter cannot promise for long, self-similar needles. With `reverse`
+// both strings are read back to front and the last occurrence is returned.
+// Requires 1 <= needleLength <= haystackLength.
+static const char *ma_string_search_two_way(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength, bool reverse) {
+    const size_t wordBits = 8 * sizeof(size_t);
+    size_t byteset[256 / (8 * sizeof(size_t))] = {0};
+    size_t shift[256];
+    size_t length = needleLength;
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = ma_string_two_way_at(needle, length, i, reverse);
+        byteset[c / wordBits] |= (size_t)1 << (c % wordBits);
+        shift[c] = i + 1;
+    }
+
+    // Critical factorization: the maximal suffix for both byte orderings,
+    // keeping the longer one. `suffixStart` may wrap to SIZE_MAX, standing for -1.
+    size_t suffixStart = 0;
+    size_t period = 1;
+    for (int ordering = 0; ordering < 2; ordering++) {
+        size_t ip = (size_t)-1;
+        size_t jp = 0;
+        size_t k = 1;
+        size_t p = 1;
+        while (jp + k < length) {
+            unsigned char a = ma_string_two_way_at(needle, length, ip + k, reverse);
+            unsigned char b = ma_string_two_way_at(needle, length, jp + k, reverse);
+            if (a == b) {
+                if (k == p) {
+                    jp += p;
+                    k = 1;
+                }
+                else {
+                    k++;
+                }
+            }
+            else if ((ordering == 0) ? (a > b) : (a < b)) {
+                jp += k;
+                k = 1;
+                p = jp - ip;
+            }
+            else {
+                ip = jp++;
+                k = p = 1;
+            }
+        }
+        if (ordering == 0 || ip + 1 > suffixStart + 1) {
+            suffixStart = ip;
+            period = p;
+        }
+    }
+
+    // A periodic needle lets matched prefixes be remembered across shifts.
+    size_t i = 0;
+    while (i < suffixStart + 1 && ma_string_two_way_at(needle, length, i, reverse) == ma_string_two_way_at(needle, length, i + period, reverse)) {
+        i++;
+    }
+    size_t memory0 = 0;
+    if (i < suffixStart + 1) {
+        period = ((suffixStart > length - suffixStart - 1) ? suffixStart : length - suffixStart - 1) + 1;
+    }
+    else {
+        memory0 = length - period;
+    }
+
+    size_t memory = 0;
+    size_t pos = 0;
+    while (haystackLength - pos >= length) {
+        unsigned char c = ma_string_two_way_at(haystack, haystackLength, pos + length - 1, reverse);
+        if ((byteset[c / wordBits] & ((size_t)1 << (c % wordBits))) == 0) {
+            pos += length;
+            memory = 0;
+            continue;
+        }
+
+        size_t k = length - shift[c];
+        if (k != 0) {
+            pos += (k < memory) ? memory : k;
+            memory = 0;
+            continue;
+        }
+
+        // Right half first, then the left half back to the remembered prefix.
+        for (k = (suffixStart + 1 > memory) ? suffixStart + 1 : memory;
+             k < length && ma_string_two_way_at(needle, length, k, reverse) == ma_string_two_way_at(haystack, haystackLength, pos + k, reverse);
+             k++);
+        if (k < length) {
+            pos += k - suffixStart;
+            memory = 0;
+            continue;
+        }
+
+        for (k = suffixStart + 1;
+             k > memory && ma_string_two_way_at(needle, length, k - 1, reverse) == ma_string_two_way_at(haystack, haystackLength, pos + k - 1, reverse);
+             k--);
+        if (k <= memory) {
+            return haystack + (reverse ? haystackLength - pos - length : pos);
+        }
+        pos += period;
+        memory = memory0;
+    }
+    return NULL;
+}
+
+// First occurrence of `needle` in `haystack`, NULL when there is none. Both
+// are length-delimited, so embedded NUL bytes are matched like any other byte.
+static const char *ma_string_search(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength) {
+    if (needleLength == 0) {
+        return haystack;
+    }
+    if (needleLength > haystackLength) {
+        return NULL;
+    }
+    if (needleLength == 1) {
+        return memchr(haystack, needle[0], haystackLength);
+    }
+    if (needleLength >= MA_STRING_TWO_WAY_THRESHOLD) {
+        return ma_string_search_two_way(haystack, haystackLength, needle, needleLength, false);
+    }
+    return ma_string_search_filtered(haystack, haystackLength, needle, needleLength);
+}
+
+// Last occurrence of `needle` in `haystack`, NULL when there is none.
+static const char *ma_string_search_reverse(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength) {
+    if (needleLength == 0) {
+        return haystack + haystackLength;
+    }
+    if (needleLength > haystackLength) {
+        return NULL;
+    }
+    if (needleLength >= MA_STRING_TWO_WAY_THRESHOLD) {
+        return ma_string_search_two_way(haystack, haystackLength, needle, needleLength, true);
+    }
+    return ma_string_search_filtered_reverse(haystack, haystackLength, needle, needleLength);
+}
+
+typedef enum {
+    STRING_CASE_UPPER,
+    STRING_CASE_LOWER,
+    STRING_CASE_SWAP,
+} StringCaseMapping;
+
+// ASCII letters are mapped arithmetically, other bytes through the C library
+// so that single-byte locales keep working.
+static inline char ma_string_case_map_byte(char c, StringCaseMapping mapping) {
+    unsigned char u = (unsigned char)c;
+    bool lower = (u >= 'a' && u <= 'z');
+    bool upper = (u >= 'A' && u <= 'Z');
+    if (u >= 0x80) {
+        lower = islower(u) != 0;
+        upper = isupper(u) != 0;
+    }
+
+    if ((mapping != STRING_CASE_LOWER) && lower) {
+        return (char)((u < 0x80) ? (u ^ 0x20) : toupper(u));
+    }
+    if ((mapping != STRING_CASE_UPPER) && upper) {
+        return (char)((u < 0x80) ? (u ^ 0x20) : tolower(u));
+    }
+    return c;
+}
+
+static inline unsigned char ma_string_fold_byte(char c) {
+    unsigned char u = (unsigned char)c;
+    if (u >= 0x80) {
+        return (unsigned char)tolower(u);
+    }
+    return (u >= 'A' && u <= 'Z') ? (unsigned char)(u | 0x20) : u;
+}
+
+// Writes the case mapping of `size` bytes of `src` to `dst`, which may be `src`.
+// Pure ASCII blocks flip the 0x20 bit of their letters in one step; a block
+// holding a byte of 0x80 or above is mapped byte by byte.
+static void ma_string_case_map(char *dst, const char *src, size_t size, StringCaseMapping mapping) {
+    size_t i = 0;
+
+#if defined(MA_STRING_SIMD_WIDTH)
+    SimdBlock caseBit = ma_simd_splat(0x20);
+    for (; size - i >= MA_STRING_SIMD_WIDTH; i += MA_STRING_SIMD_WIDTH) {
+        SimdBlock block = ma_simd_load(src + i);
+        if (ma_simd_movemask(block) != 0) {
+            for (size_t j = i; j < i + MA_STRING_SIMD_WIDTH; j++) {
+                dst[j] = ma_string_case_map_byte(src[j], mapping);
+            }
+            continue;
+        }
+
+        SimdBlock letters;
+        if (mapping == STRING_CASE_UPPER) {
+            letters = ma_simd_in_range(block, 'a', 'z');
+        }
+        else if (mapping == STRING_CASE_LOWER) {
+            letters = ma_simd_in_range(block, 'A', 'Z');
+        }
+        else {
+            letters = ma_simd_or(ma_simd_in_range(block, 'a', 'z'), ma_simd_in_range(block, 'A', 'Z'));
+        }
+        ma_simd_store(dst + i, ma_simd_xor(block, ma_simd_and(letters, caseBit)));
+    }
+#endif
+
+    for (; i < size; i++) {
+        dst[i] = ma_string_case_map_byte(src[i], mapping);
+    }
+}
+
+// Difference of the first pair of bytes that differ once case folded, 0 when
+// the `size` bytes are equal ignoring case.
+static int ma_string_compare_folded(const char *a, const char *b, size_t size) {
+    size_t i = 0;
+
+#if defined(MA_STRING_SIMD_WIDTH)
+    SimdBlock caseBit = ma_simd_splat(0x20);
+    for (; size - i >= MA_STRING_SIMD_WIDTH; i += MA_STRING_SIMD_WIDTH) {
+        SimdBlock blockA = ma_simd_load(a + i);
+        SimdBlock blockB = ma_simd_load(b + i);
+        if (ma_simd_movemask(ma_simd_or(blockA, blockB)) != 0) {
+            for (size_t j = i; j < i + MA_STRING_SIMD_WIDTH; j++) {
+                int diff = (int)ma_string_fold_byte(a[j]) - (int)ma_string_fold_byte(b[j]);
+                if (diff != 0) {
+                    return diff;
+                }
+            }
+            continue;
+        }
+
+        SimdBlock foldedA = ma_simd_or(blockA, ma_simd_and(ma_simd_in_range(blockA, 'A', 'Z'), caseBit));
+        SimdBlock foldedB = ma_simd_or(blockB, ma_simd_and(ma_simd_in_range(blockB, 'A', 'Z'), caseBit));
+        uint32_t equal = ma_simd_movemask(ma_simd_cmpeq(foldedA, foldedB));
+        if (equal != MA_SIMD_FULL_MASK) {
+            size_t j = i + ma_string_lowest_bit(~equal);
+            return (int)ma_string_fold_byte(a[j]) - (int)ma_string_fold_byte(b[j]);
+        }
+    }
+#endif
+
+    for (; i < size; i++) {
+        int diff = (int)ma_string_fold_byte(a[i]) - (int)ma_string_fold_byte(b[i]);
+        if (diff != 0) {
+            return diff;
+        }
+    }
+    return 0;
+}
+
+typedef enum {
+    STRING_CLASS_ALPHA,       // Every byte is an ASCII letter
+    STRING_CLASS_DIGIT,       // Every byte is an ASCII digit
+    STRING_CLASS_NO_UPPER,    // No byte is an ASCII uppercase letter
+    STRING_CLASS_NO_LOWER,    // No byte is an ASCII lowercase letter
+} StringByteClass;
+
+static inline bool ma_string_byte_matches_class(char c, StringByteClass byteClass) {
+    switch (byteClass) {
+        case STRING_CLASS_ALPHA:
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        case STRING_CLASS_DIGIT:
+            return c >= '0' && c <= '9';
+        case STRING_CLASS_NO_UPPER:
+            return !(c >= 'A' && c <= 'Z');
+        case STRING_CLASS_NO_LOWER:
+            return !(c >= 'a' && c <= 'z');
+    }
+    return false;
+}
+
+// Whether all `size` bytes satisfy `byteClass`, checked a block at a time.
+static bool ma_string_all_match_class(const char *data, size_t size, StringByteClass byteClass) {
+    size_t i = 0;
+
+#if defined(MA_STRING_SIMD_WIDTH)
+    for (; size - i >= MA_STRING_SIMD_WIDTH; i += MA_STRING_SIMD_WIDTH) {
+        SimdBlock block = ma_simd_load(data + i);
+        bool matches = false;
+        switch (byteClass) {
+            case STRING_CLASS_ALPHA:
+                matches = ma_simd_movemask(ma_simd_or(ma_simd_in_range(block, 'a', 'z'), ma_simd_in_range(block, 'A', 'Z'))) == MA_SIMD_FULL_MASK;
+                break;
+            case STRING_CLASS_DIGIT:
+                matches = ma_simd_movemask(ma_simd_in_range(block, '0', '9')) == MA_SIMD_FULL_MASK;
+                break;
+            case STRING_CLASS_NO_UPPER:
+                matches = ma_simd_movemask(ma_simd_in_range(block, 'A', 'Z')) == 0;
+                break;
+            case STRING_CLASS_NO_LOWER:
+                matches = ma_simd_movemask(ma_simd_in_range(block, 'a', 'z')) == 0;
+                break;
+        }
+        if (!matches) {
+            return false;
+        }
+    }
+#endif
+
+    for (; i < size; i++) {
+        if (!ma_string_byte_matches_class(data[i], byteClass)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static atomic_size_t string_growth_factor = MA_STRING_GROWTH_FACTOR;
+
+// Capacity to move to when `required` bytes do not fit: the current capacity
+// scaled by the growth factor, or `required` when that is still too small.
+static size_t ma_string_grow_capacity(const String *str, size_t required) {
+    size_t growthFactor = atomic_load_explicit(&string_growth_factor, memory_order_relaxed);
+    size_t grown = (str->capacitySize > SIZE_MAX / growthFactor) ? SIZE_MAX : str->capacitySize * growthFactor;
+    return (grown > required) ? grown : required;
+}
+
+// Makes room for `required` bytes, terminator included, growing geometrically
+// so that repeated appends cost amortized O(1) per byte.
+static bool ma_string_grow(String *str, size_t required) {
+    if (required <= str->capacitySize) {
+        return true;
+    }
+    return ma_string_reallocate(str, ma_string_grow_capacity(str, required));
+}
+
+// Returns `ptr` rebased into the current buffer when it pointed into `oldData`,
+// so callers can keep reading arguments that aliased the String's own contents.
+static const char *ma_string_rebase(const String *str, const char *oldData, size_t oldCapacity, const char *ptr) {
+    if (oldData != NULL && ptr >= oldData && ptr < oldData + oldCapacity) {
+        return str->dataStr + (ptr - oldData);
+    }
+    return ptr;
+}
+
+// Yields the first match at or after `pos` in `data` and the bytes replacing it.
+typedef bool (*StringRewriteNext)(const void *context, const char *data, size_t size, size_t pos, size_t *offset, size_t *length, const char **replacement, size_t *replacementLength);
+
+// Replaces every match yielded by `next` in two passes: the first sizes the
+// result, the second writes it once, compacting in place when `shrinking`
+// guarantees that no replacement is longer than its match, into a single new
+// buffer otherwise. Replacements must not point into `str`. Returns the number
+// of replacements made.
+static size_t ma_string_rewrite(String *str, StringRewriteNext next, const void *context, bool shrinking) {
+    size_t offset, length, replacementLength;
+    const char *replacement;
+    size_t count = 0;
+    size_t newSize = str->size;
+
+    for (size_t pos = 0; next(context, str->dataStr, str->size, pos, &offset, &length, &replacement, &replacementLength) && length != 0; pos = offset + length) {
+        newSize = newSize - length + replacementLength;
+        count++;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    ma_string_invalidate_hash(str);
+
+    char local[MA_STRING_INLINE_CAPACITY];
+    char *out = str->dataStr;
+    size_t capacity = str->capacitySize;
+    MemoryPoolString *pool = NULL;
+    if (!shrinking) {
+        if (newSize + 1 <= MA_STRING_INLINE_CAPACITY) {
+            out = local;
+        }
+        else {
+            pool = ma_string_pool(str);
+            capacity = (newSize + 1 > capacity) ? ma_string_grow_capacity(str, newSize + 1) : capacity;
+            out = ma_string_memory_pool_allocate(pool, capacity);
+            if (out == NULL) {
+                printf("Error: Memory allocation failed in string_rewrite.\n");
+                return 0;
+            }
+        }
+    }
+
+    // Writes never pass the read position, so the in-place scan only ever reads
+    // bytes that were not overwritten yet.
+    size_t read = 0;
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        next(context, str->dataStr, str->size, read, &offset, &length, &replacement, &replacementLength);
+        memmove(out + written, str->dataStr + read, offset - read);
+        written += offset - read;
+        if (replacementLength != 0) {
+            memcpy(out + written, replacement, replacementLength);
+        }
+        written += replacementLength;
+        read = offset + length;
+    }
+    memmove(out + written, str->dataStr + read, str->size - read);
+    out[newSize] = '\0';
+
+    if (out == local) {
+        ma_string_release_data(str, ma_string_pool(str), str->dataStr, str->capacitySize);
+        memcpy(str->inlineStr, local, newSize + 1);
+        str->dataStr = str->inlineStr;
+        str->capacitySize = MA_STRING_INLINE_CAPACITY;
+    }
+    else if (out != str->dataStr) {
+        ma_string_release_data(str, pool, str->dataStr, str->capacitySize);
+        str->dataStr = out;
+        str->capacitySize = capacity;
+    }
+    str->size = newSize;
+    return count;
+}
+
+//static const char *base64_chars =
+//    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+//    "abcdefghijklmnopqrstuvwxyz"
+//    "0123456789+/";
+
+
+MemoryPoolString* ma_string_thread_arena(void) {
+    if (thread_arena == NULL) {
+        thread_arena = ma_string_memory_pool_create(MA_STRING_ARENA_CHUNK_SIZE);
+        if (thread_arena == NULL) {
+            printf("Error: Memory pool creation failed in string_thread_arena.\n");
+        }
+    }
+    return thread_arena;
+}
+
+void ma_string_set_arena_mode(bool enable) {
+    thread_arena_mode = enable;
+}
+
+bool ma_string_arena_mode_enabled(void) {
+    return thread_arena_mode;
+}
+
+void ma_string_thread_arena_destroy(void) {
+    if (thread_arena != NULL) {
+        ma_string_memory_pool_destroy(thread_arena);
+        thread_arena = NULL;
+    }
+}
+
+// Header and data are both bump-allocated from `pool`, which the caller keeps
+// alive for the lifetime of the String.
+String* ma_string_create_in_pool(MemoryPoolString* pool, const char* initialStr) {
+    if (pool == NULL) {
+        printf("Error: Memory pool is NULL in string_create_in_pool.\n");
+        return NULL;
+    }
+
+    String* str = ma_string_memory_pool_allocate(pool, sizeof(String));
+    if (!str) {
+        printf("Error: Memory allocation failed for String object in string_create_in_pool.\n");
+        return NULL;
+    }
+
+    size_t initialSize = initialStr ? strlen(initialStr) : 0;
+    size_t sizeClass = ma_memory_pool_size_class(initialSize + 1);
+
+    str->size = initialSize;
+    str->pool = pool;
+    str->poolKind = STRING_POOL_SHARED;
+    str->headerPool = pool;
+    str->hash = 0;
+
+    if (initialSize < MA_STRING_INLINE_CAPACITY) {
+        str->dataStr = str->inlineStr;
+        str->capacitySize = MA_STRING_INLINE_CAPACITY;
+    }
+    else {
+        str->capacitySize = (sizeClass < MA_MEMORY_POOL_SIZE_CLASSES) ? MA_MEMORY_POOL_CLASS_SIZE(sizeClass) : initialSize + 1;
+        str->dataStr = ma_string_memory_pool_allocate(pool, str->capacitySize);
+    }
+    if (!str->dataStr) {
+        printf("Error: Memory pool allocation failed in string_create_in_pool.\n");
+        ma_string_memory_pool_free(pool, str, sizeof(String));
+        return NULL;
+    }
+
+    if (initialStr) {
+        memcpy(str->dataStr, initialStr, initialSize);
+    }
+    str->dataStr[initialSize] = '\0';
+
+    return str;
+}
+
+// Arena mode String: header and data are both bump-allocated from the thread arena.
+static String* ma_string_create_in_arena(const char* initialStr) {
+    MemoryPoolString* arena = ma_string_thread_arena();
+    if (!arena) {
+        exit(-1);
+    }
+
+    String* str = ma_string_create_in_pool(arena, initialStr);
+    if (!str) {
+        exit(-1);
+    }
+
+    return str;
+}
+
+String* ma_string_create(const char* initialStr) {
+    if (thread_arena_mode) {
+        return ma_string_create_in_arena(initialStr);
+    }
+    return ma_string_create_len(initialStr, initialStr ? strlen(initialStr) : 0);
+}
+
+String* ma_string_create_len(const char* initialStr, size_t initialSize) {
+    if (initialStr == NULL && initialSize != 0) {
+        printf("Error: The initialStr is NULL in string_create.\n");
+        return NULL;
+    }
+    if (thread_arena_mode) {
+        String* str = ma_string_create_in_arena(NULL);
+        ma_string_assign_len(str, initialStr, initialSize);
+        return str;
+    }
+
+    String* str = (String*)ma_object_slab_allocate(OBJECT_SLAB_STRING, sizeof(String));
+    if (!str) {
+        printf("Error: Memory allocation failed for String object in string_create.\n");
+        exit(-1);
+    }
+
+    str->size = 0;
+    str->dataStr = str->inlineStr;
+    str->capacitySize = MA_STRING_INLINE_CAPACITY;
+    str->pool = NULL; // The owned pool is created once the contents outgrow the inline buffer
+    str->poolKind = STRING_POOL_OWNED;
+    str->headerPool = NULL;
+    str->hash = 0;
+
+    if (initialSize >= MA_STRING_INLINE_CAPACITY && !ma_string_grow(str, initialSize + 1)) {
+        printf("Error: Memory pool allocation failed in string_create.\n");
+        if (str->pool) {
+            ma_string_memory_pool_destroy(str->pool);
+        }
+        ma_object_slab_free(OBJECT_SLAB_STRING, str);
+        exit(-1);
+    }
+
+    if (initialStr) {
+        memcpy(str->dataStr, initialStr, initialSize);
+    }
+    str->dataStr[initialSize] = '\0';
+    str->size = initialSize;
+    return str;
+}
+
+String* ma_string_create_with_pool(size_t size) {
+    // Ensure global memory pool is initialized, the first caller decides its size
+    if (!ma_memory_pool_global_init(size)) {
+        printf("Error: Failed to initialize global memory pool in string_create_with_pool.\n");
+        exit(-1);  // Consider handling the error without exiting
+    }
+
+    String* str = (String*)ma_object_slab_allocate(OBJECT_SLAB_STRING, sizeof(String));
+    if (!str) {
+        printf("Error: Memory allocation failed for String object in string_create_with_pool.\n");
+        exit(-1);
+    }
+
+    str->size = 0;
+    str->capacitySize = MA_STRING_INLINE_CAPACITY;
+    str->dataStr = str->inlineStr; // Pool data is not allocated until the inline buffer is outgrown
+    str->dataStr[0] = '\0';
+    str->pool = NULL; // Allocations go to the calling thread's share of the global pool
+    str->poolKind = STRING_POOL_GLOBAL;
+    str->headerPool = NULL;
+    str->hash = 0;
+
+    return str;
+}
+
+String* ma_string_substr(String* str, size_t pos, size_t len) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_substr.\n");
+        return NULL;
+    }
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_substr.\n");
+        return NULL;
+    }
+
+    // Adjust len if it goes beyond the end of the string
+    if (pos + len > str->size) {
+        len = str->size - pos;
+    }
+
+    String* substr = ma_string_create(NULL); // Allocate memory for the substring
+    if (substr == NULL) {
+        printf("Error: Memory allocation failed for substring in string_substr.\n");
+        return NULL;
+    }
+
+    if (len + 1 > substr->capacitySize && !ma_string_reallocate(substr, len + 1)) {
+        printf("Error: Memory allocation failed for dataStr in substring in string_substr.\n");
+        ma_string_deallocate(substr);
+        return NULL;
+    }
+
+    memcpy(substr->dataStr, str->dataStr + pos, len); // Copy the substring
+    substr->dataStr[len] = '\0';  // Null terminate the substring
+    substr->size = len;
+
+    return substr;
+}
+
+bool ma_string_empty(String* str) {
+    return (str == NULL) ? true : (str->size == 0);
+}
+
+bool ma_string_contains(String* str, const char* substr) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_contains.\n");
+        return false;
+    }
+    if (substr == NULL) {
+        printf("Error: The substring is NULL in string_contains.\n");
+        return false;
+    }
+    return ma_string_contains_len(str, substr, strlen(substr));
+}
+
+bool ma_string_contains_len(String* str, const char* substr, size_t length) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_contains.\n");
+        return false;
+    }
+    if (substr == NULL && length != 0) {
+        printf("Error: The substring is NULL in string_contains.\n");
+        return false;
+    }
+    return ma_string_search(str->dataStr, str->size, substr, length) != NULL;
+}
+
+int ma_string_compare(const String* str1, const String* str2) {
+    if (str1 == NULL || str2 == NULL) {
+        if (str1 == str2) {
+            return 0;  // Both are NULL, considered equal
+        }
+        printf("Error: One or both String objects are NULL in string_compare.\n");
+        return (str1 == NULL) ? -1 : 1;  // NULL is considered less than non-NULL
+    }
+
+    size_t common = (str1->size < str2->size) ? str1->size : str2->size;
+    int result = memcmp(str1->dataStr, str2->dataStr, common);
+    if (result != 0) {
+        return result;
+    }
+    return (str1->size > str2->size) - (str1->size < str2->size);
+}
+
+bool ma_string_is_equal(String* str1, String* str2) {
+    if (str1 == NULL || str2 == NULL) {
+        return ma_string_compare(str1, str2) == 0;
+    }
+    if (str1->size != str2->size) {
+        return false; // Contents of different lengths never match
+    }
+    if (str1->hash != 0 && str2->hash != 0 && str1->hash != str2->hash) {
+        return false; // Hashes cached by earlier lookups rule out most mismatches without touching the bytes
+    }
+    return str1 == str2 || memcmp(str1->dataStr, str2->dataStr, str1->size) == 0;
+}
+
+bool ma_string_is_less(String* str1, String* str2) {
+    return ma_string_compare(str1, str2) < 0;
+}
+
+bool ma_string_is_greater(String* str1, String* str2) {
+    return ma_string_compare(str1, str2) > 0;
+}
+
+bool ma_string_is_less_or_equal(String* str1, String* str2) {
+    return ma_string_compare(str1, str2) <= 0;
+}
+
+bool ma_string_is_greater_or_equal(String* str1, String* str2) {
+    return ma_string_compare(str1, str2) >= 0;
+}
+
+bool ma_string_is_not_equal(String* str1, String* str2) {
+    return !ma_string_is_equal(str1, str2);
+}
+
+bool ma_string_is_alpha(String* str) {
+    if (str != NULL){
+        return ma_string_all_match_class(str->dataStr, str->size, STRING_CLASS_ALPHA);
+    }
+
+    return false;
+}
+
+bool ma_string_is_digit(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_is_digit.\n");
+        return false;
+    }
+
+    return ma_string_all_match_class(str->dataStr, str->size, STRING_CLASS_DIGIT);
+}
+
+bool ma_string_is_upper(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_is_upper.\n");
+        return false;
+    }
+    return ma_string_all_match_class(str->dataStr, str->size, STRING_CLASS_NO_LOWER);
+}
+
+bool ma_string_is_lower(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_is_lower.\n");
+        return false;
+    }
+    return ma_string_all_match_class(str->dataStr, str->size, STRING_CLASS_NO_UPPER);
+}
+
+void ma_string_reverse(String* str) {
+    if (str != NULL && str->dataStr != NULL) {
+        char* reverse = (char*) ma_allocator_alloc(sizeof(char) * (str->size + 1));
+        if (!reverse) {
+            printf("Error: Memory allocation failed in string_reverse.\n");
+            return;
+        }
+
+        for (int index = str->size - 1, j = 0; index >= 0; index--, j++) {
+            reverse[j] = str->dataStr[index];
+        }
+        reverse[str->size] = '\0';
+        ma_string_replace(str, ma_string_c_str(str), reverse);
+
+        ma_allocator_free(reverse);
+    }
+    else {
+        printf("Error: The String object or its data is NULL in string_reverse.\n");
+        return;
+    }
+}
+
+void ma_string_resize(String *str, size_t newSize) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_resize.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (newSize < str->size) {
+        str->size = newSize;
+        str->dataStr[newSize] = '\0';
+    }
+    else if (newSize > str->size) {
+        if (newSize >= str->capacitySize) {
+            if (!ma_string_grow(str, newSize + 1)) {
+                printf("Error: Memory allocation failed in string_resize.\n");
+                return;
+            }
+        }
+
+        memset(str->dataStr + str->size, '\0', newSize - str->size + 1);
+        str->size = newSize;
+    }
+}
+
+void ma_string_shrink_to_fit(String *str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_shrink_to_fit.\n");
+        return;
+    }
+    if (str->size + 1 == str->capacitySize) {
+        return; // No need to shrink if already at optimal size
+    }
+    // Check if the string is using the memory pool
+    if (str->dataStr != NULL) {
+        // Move the data into a fitting block, the old one goes back to the pool
+        if (!ma_string_reallocate(str, str->size + 1)) { // +1 for null terminator
+            printf("Error: Memory allocation failed in string_shrink_to_fit.\n");
+            return;
+        }
+    }
+}
+
+bool ma_string_reserve(String *str, size_t capacity) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_reserve.\n");
+        return false;
+    }
+    if (capacity <= str->capacitySize) {
+        return true;
+    }
+    if (!ma_string_reallocate(str, capacity)) {
+        printf("Error: Memory allocation failed in string_reserve.\n");
+        return false;
+    }
+    return true;
+}
+
+void ma_string_set_growth_factor(size_t growthFactor) {
+    atomic_store_explicit(&string_growth_factor, growthFactor < 2 ? 2 : growthFactor, memory_order_relaxed);
+}
+
+void ma_string_append(String *str, const char *strItem) {
+    if (strItem == NULL) {
+        printf("Error: The strItem is NULL in string_append.\n");
+        return;
+    }
+    ma_string_append_len(str, strItem, strlen(strItem));
+}
+
+void ma_string_append_len(String *str, const char *strItem, size_t strItemLength) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_append.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (strItem == NULL && strItemLength != 0) {
+        printf("Error: The strItem is NULL in string_append.\n");
+        return;
+    }
+    if (strItemLength == 0) {
+        return;
+    }
+
+    if (str->size + strItemLength >= str->capacitySize) {
+        char *oldData = str->dataStr;
+        size_t oldCapacity = str->capacitySize;
+
+        if (!ma_string_grow(str, str->size + strItemLength + 1)) {
+            printf("Error: Memory allocation failed in string_append.\n");
+            return;
+        }
+        strItem = ma_string_rebase(str, oldData, oldCapacity, strItem);
+    }
+
+    memmove(str->dataStr + str->size, strItem, strItemLength);
+    str->dataStr[str->size + strItemLength] = '\0';
+    str->size += strItemLength;
+}
+
+void ma_string_push_back(String* str, char chItem) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_push_back.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->size + 1 >= str->capacitySize) {
+        // Move to a block growthFactor times as large, the old one goes back to the pool
+        if (!ma_string_grow(str, str->size + 2)) {
+            printf("Error: Memory allocation failed in string_push_back.\n");
+            return;
+        }
+    }
+    // Append the character
+    str->dataStr[str->size] = chItem;
+    str->size++;
+    str->dataStr[str->size] = '\0'; // Null-terminate the string
+}
+
+void ma_string_assign(String *str, const char *newStr) {
+    if (newStr == NULL) {
+        printf("Error: The newStr is NULL in string_assign.\n");
+        return;
+    }
+    ma_string_assign_len(str, newStr, strlen(newStr));
+}
+
+void ma_string_assign_len(String *str, const char *newStr, size_t newStrLength) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_assign.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (newStr == NULL && newStrLength != 0) {
+        printf("Error: The newStr is NULL in string_assign.\n");
+        return;
+    }
+
+    if (newStrLength + 1 > str->capacitySize) {
+        size_t newCapacity = ma_string_grow_capacity(str, newStrLength + 1);
+        MemoryPoolString *pool = ma_string_pool(str);
+        char *newData = ma_string_memory_pool_allocate(pool, newCapacity);
+        if (!newData) {
+            printf("Error: Memory allocation failed in string_assign.\n");
+            return;
+        }
+
+        memcpy(newData, newStr, newStrLength);
+        ma_string_release_data(str, pool, str->dataStr, str->capacitySize);
+        str->dataStr = newData;
+        str->capacitySize = newCapacity;
+    }
+    else if (newStrLength != 0) {
+        memmove(str->dataStr, newStr, newStrLength);
+    }
+
+    str->dataStr[newStrLength] = '\0';
+    str->size = newStrLength;
+}
+
+void ma_string_insert(String *str, size_t pos, const char *strItem) {
+    if (strItem == NULL) {
+        printf("Error: The strItem is NULL in string_insert.\n");
+        return;
+    }
+    ma_string_insert_len(str, pos, strItem, strlen(strItem));
 }
 
-static int decode_sequence(const unsigned char *coded, unsigned char *plain) {
-	assert(CHAR_BIT == 8);
-	assert(coded && plain);
+void ma_string_insert_len(String *str, size_t pos, const char *strItem, size_t strItemLength) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_insert.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (strItem == NULL && strItemLength != 0) {
+        printf("Error: The strItem is NULL in string_insert.\n");
+        return;
+    }
+    if (pos > str->size) {
+        printf("Error: Position out of bounds in string_insert.\n");
+        return;
+    }
 
-	plain[0] = 0;
-	for (int block = 0; block < 8; block++) {
-		int offset = get_offset(block);
-		int octet = get_octet(block);
+    size_t newTotalLength = str->size + strItemLength;
 
-		int c = decode_char(coded[block]);
-		if (c < 0) {
-			return octet;
+    if (newTotalLength + 1 > str->capacitySize) {
+        size_t newCapacity = ma_string_grow_capacity(str, newTotalLength + 1);
+        MemoryPoolString *pool = ma_string_pool(str);
+        char *newData = ma_string_memory_pool_allocate(pool, newCapacity);
+        if (!newData) {
+            printf("Error: Memory allocation failed in string_insert.\n");
+            return;
         }
 
-		plain[octet] |= shift_left(c, offset);
-		if (offset < 0) {  // does this block overflows to next octet?
-			assert(octet < 4);
-			plain[octet+1] = shift_left(c, 8 + offset);
-		}
-	}
-	return 5;
-}
+        memcpy(newData, str->dataStr, pos);
+        memcpy(newData + pos, strItem, strItemLength);
+        memcpy(newData + pos + strItemLength, str->dataStr + pos, str->size - pos);
+        newData[newTotalLength] = '\0';
 
-char* ma_encoding_base64_encode(const char* input, size_t length) {
-    size_t output_length = 4 * ((length + 2) / 3);
-    char* encoded = malloc(output_length + 1); // +1 for null terminator
-    if (!encoded) {
-        printf("Error: Can not allocate memory for encoded in encoding_base64_encode.\n");
-        return NULL;
+        ma_string_release_data(str, pool, str->dataStr, str->capacitySize);
+        str->dataStr = newData;
+        str->capacitySize = newCapacity;
+    }
+    else {
+        memmove(str->dataStr + pos + strItemLength, str->dataStr + pos, str->size - pos + 1);
+        if (strItemLength != 0) {
+            memmove(str->dataStr + pos, strItem, strItemLength);
+        }
     }
 
-    size_t i, j;
-    for (i = 0, j = 0; i < length;) {
-        uint32_t octet_a = i < length ? (unsigned char)input[i++] : 0;
-        uint32_t octet_b = i < length ? (unsigned char)input[i++] : 0;
-        uint32_t octet_c = i < length ? (unsigned char)input[i++] : 0;
-        uint32_t triple = (octet_a << 16) + (octet_b << 8) + octet_c;
+    str->size = newTotalLength;
+}
 
-        encoded[j++] = base64_chars[(triple >> 18) & 0x3F];
-        encoded[j++] = base64_chars[(triple >> 12) & 0x3F];
-        encoded[j++] = base64_chars[(triple >> 6) & 0x3F];
-        encoded[j++] = base64_chars[triple & 0x3F];
+void ma_string_erase(String *str, size_t pos, size_t len) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_erase.\n");
+        return;
     }
-
-    for (size_t k = 0; k < (3 - length % 3) % 3; k++) {
-        encoded[output_length - 1 - k] = '=';
+    ma_string_invalidate_hash(str);
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_erase.\n");
+        return;
+    }
+    if (pos + len > str->size) {
+        len = str->size - pos;  // Adjust len to not go beyond the string end
     }
 
-    encoded[output_length] = '\0';
-    return encoded;
+    memmove(str->dataStr + pos, str->dataStr + pos + len, str->size - pos - len + 1);
+    str->size -= len;
 }
 
-char* ma_encoding_base64_decode(const char* input, size_t length) {
-    if (length % 4 != 0) {
-        printf("Error: Invalid input length in encoding_base64_decode. Length must be a multiple of 4.\n");
-        return NULL;
+void ma_string_replace(String *str1, const char *oldStr, const char *newStr) {
+    if (oldStr == NULL) {
+        printf("Error: The oldStr is NULL in string_replace.\n");
+        return;
     }
-
-    size_t output_length = length / 4 * 3;
-    if (input[length - 1] == '=')  {
-        output_length--;
+    if (newStr == NULL) {
+        printf("Error: The newStr is NULL in string_replace.\n");
+        return;
     }
+    ma_string_replace_len(str1, oldStr, strlen(oldStr), newStr, strlen(newStr));
+}
 
-    if (input[length - 2] == '=') {
-        output_length--;
+void ma_string_replace_len(String *str1, const char *oldStr, size_t oldLen, const char *newStr, size_t newLen) {
+    if (str1 == NULL) {
+        printf("Error: The String object (str1) is NULL in string_replace.\n");
+        return;
     }
-
-    char* decoded = malloc(output_length + 1);
-    if (!decoded) {
-        printf("Error: Memory allocation failed in encoding_base64_decode.\n");
-        return NULL;
+    ma_string_invalidate_hash(str1);
+    if (oldStr == NULL || (newStr == NULL && newLen != 0)) {
+        printf("Error: The oldStr or newStr is NULL in string_replace.\n");
+        return;
     }
 
-    static const unsigned char d[] = {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0,
-        0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0,
-        0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51
-    };
+    char *position = (char *)ma_string_search(str1->dataStr, str1->size, oldStr, oldLen);
+    if (position == NULL) {
+        printf("Warning: oldStr not found in str1 in string_replace.\n");
+        return;  // oldStr not found in str1
+    }
 
-    for (size_t i = 0, j = 0; i < length;) {
-        uint32_t sextet_a = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
-        uint32_t sextet_b = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
-        uint32_t sextet_c = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
-        uint32_t sextet_d = input[i] == '=' ? 0 & i++ : d[(unsigned char)input[i++]];
-        uint32_t triple = (sextet_a << 18) + (sextet_b << 12) + (sextet_c << 6) + sextet_d;
+    size_t tailLen = str1->size - (size_t)(position - str1->dataStr) - oldLen;
+    size_t newSize = (position - str1->dataStr) + newLen + tailLen;
 
-        if (j < output_length) {
-            decoded[j++] = (triple >> 16) & 0xFF;
-        }
-        if (j < output_length) {
-            decoded[j++] = (triple >> 8) & 0xFF;
-        }
-        if (j < output_length) {
-            decoded[j++] = triple & 0xFF;
+    size_t offset = position - str1->dataStr;
+    if (newSize + 1 > str1->capacitySize) {
+        size_t newCapacity = ma_string_grow_capacity(str1, newSize + 1);
+        MemoryPoolString *pool = ma_string_pool(str1);
+        char *newData = ma_string_memory_pool_allocate(pool, newCapacity);
+        if (!newData) {
+            return;  // Handle allocation error
         }
-    }
-
-    decoded[output_length] = '\0';
 
-    return decoded;
-}
+        memcpy(newData, str1->dataStr, offset);
+        memcpy(newData + offset, newStr, newLen);
+        memcpy(newData + offset + newLen, position + oldLen, tailLen);
 
-char* ma_encoding_url_encode(const char* input, size_t length) {
-    char* result = malloc(3 * length + 1); // Worst case scenario, every character needs encoding
-    if (!result) {
-        printf("Error: Memory allocation failed in encoding_url_encode.\n");
-        return NULL;
+        ma_string_release_data(str1, pool, str1->dataStr, str1->capacitySize);
+        str1->dataStr = newData;
+        str1->capacitySize = newCapacity;
     }
-
-    size_t result_index = 0;
-    for (size_t i = 0; i < length; ++i) {
-        char ch = input[i];
-        if (isalnum(ch) || ch == '-' || ch == '.' || ch == '_' || ch == '~') {
-            result[result_index++] = ch;
-        }
-        else {
-            static const char hex[] = "0123456789ABCDEF";
-            result[result_index++] = '%';
-            result[result_index++] = hex[(ch >> 4) & 0x0F];
-            result[result_index++] = hex[ch & 0x0F];
-        }
+    else {
+        memmove(position + newLen, position + oldLen, tailLen);
+        memmove(position, newStr, newLen);
     }
-    result[result_index] = '\0';
-
-    return result;
+    str1->dataStr[newSize] = '\0';
+    str1->size = newSize;
 }
 
-char* ma_encoding_url_decode(const char* input, size_t length) {
-    char* result = malloc(length + 1); // Decoded string will be equal or smaller in size
-    if (!result) {
-        printf("Error: Memory allocation failed in encoding_url_decode.\n");
-        return NULL;
+void ma_string_swap(String *str1, String *str2) {
+    if (str1 == NULL || str2 == NULL) {
+        printf("Error: One or both String objects are NULL in string_swap.\n");
+        return;
     }
 
-    size_t result_index = 0;
-    for (size_t i = 0; i < length; ++i) {
-        char ch = input[i];
-        if (ch == '%') {
-            if (i + 2 >= length) {
-                printf("Error: Incomplete percent-encoding in encoding_url_decode.\n");
-                free(result);
-                return NULL;
-            }
-
-            static const char hex[] = "0123456789ABCDEF";
-            char hi = input[++i];
-            char lo = input[++i];
-            int hi_index = strchr(hex, toupper(hi)) - hex;
-            int lo_index = strchr(hex, toupper(lo)) - hex;
+    String temp = *str1;
+    *str1 = *str2;
+    *str2 = temp;
 
-            if (hi_index < 0 || hi_index >= 16 || lo_index < 0 || lo_index >= 16) {
-                printf("Error: Invalid hex characters in percent-encoding in encoding_url_decode.\n");
-                free(result);
-                return NULL;
-            }
+    // Headers stay where they were allocated, only the contents move
+    str2->headerPool = str1->headerPool;
+    str1->headerPool = temp.headerPool;
 
-            result[result_index++] = (char)((hi_index << 4) + lo_index);
-        }
-        else if (ch == '+') {
-            result[result_index++] = ' ';
-        }
-        else {
-            result[result_index++] = ch;
-        }
+    // Inline contents moved with the struct, point them at their new buffer
+    if (str1->dataStr == str2->inlineStr) {
+        str1->dataStr = str1->inlineStr;
+    }
+    if (str2->dataStr == str1->inlineStr) {
+        str2->dataStr = str2->inlineStr;
     }
-    result[result_index] = '\0';
-    return result;
 }
 
-char* ma_encoding_base32_encode(const char* input, size_t length) {
-    size_t output_length = ((length + 4) / 5) * 8; // Output length including padding
-    char* encoded = malloc(output_length + 1);
-
-    if (!encoded) {
-        printf("Error: Memory allocation failed in encoding_base32_encode.\n");
-        return NULL;
+void ma_string_pop_back(String *str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_pop_back.\n");
+        return;
     }
+    ma_string_invalidate_hash(str);
 
-    size_t input_index = 0;
-    size_t output_index = 0;
-    size_t bit_count = 0;
-    uint32_t buffer = 0;
+    if (str->size == 0) {
+        printf("Warning: Attempt to pop back from an empty string in string_pop_back.\n");
+        return;
+    }
 
-    while (input_index < length) {
-        // Fill the buffer with up to 5 bytes
-        buffer = (buffer << 8) | (uint8_t)input[input_index++];
-        bit_count += 8;
+    str->dataStr[str->size - 1] = '\0';
+    str->size--;
+}
 
-        // While we have more than 5 bits, process the buffer
-        while (bit_count >= 5) {
-            encoded[output_index++] = base32[(buffer >> (bit_count - 5)) & 0x1F];
-            bit_count -= 5;
+void ma_string_deallocate(String *str) {
+    if (str == NULL) {
+        printf("Warning: Attempt to deallocate a NULL String object in string_deallocate.\n");
+        return;
+    }
+    // Destroy the memory pool associated with the string, or hand the data back to a shared one
+    if (str->poolKind == STRING_POOL_OWNED) {
+        if (str->pool != NULL) {
+            ma_string_memory_pool_destroy(str->pool);
         }
     }
-
-    // Process any remaining bits in the buffer
-    if (bit_count > 0) {
-        encoded[output_index++] = base32[(buffer << (5 - bit_count)) & 0x1F];
+    else if (!ma_string_is_inline(str)) {
+        ma_string_memory_pool_free(ma_string_pool(str), str->dataStr, str->capacitySize);
+    }
+    str->pool = NULL;
+    // Since dataStr is managed by the memory pool, no separate free call is needed for it
+    if (str->headerPool != NULL) {
+        ma_string_memory_pool_free(str->headerPool, str, sizeof(String));
+    }
+    else {
+        ma_object_slab_free(OBJECT_SLAB_STRING, str);
     }
+}
 
-    // Add padding
-    while (output_index < output_length) {
-        encoded[output_index++] = '=';
+char ma_string_at(String* str, size_t index) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_at.\n");
+        return '\0';  // Return a default character
     }
 
-    encoded[output_index] = '\0';
+    if (index >= str->size) {
+        printf("Error: Index out of range in string_at.\n");
+        return '\0';  // Return a default character
+    }
 
-    return encoded;
+    return str->dataStr[index]; // (const char)
 }
 
-char* ma_encoding_base32_decode(const char* input, size_t length) {
-    if (length % 8 != 0) {
-        printf("Error: Invalid input length in encoding_base32_decode. Length must be a multiple of 8.\n");
+char* ma_string_back(String *str) {
+    if (str == NULL || str->size == 0) {
         return NULL;
     }
+    ma_string_invalidate_hash(str);
 
-    size_t olength = (length / 8) * 5;
-    unsigned char* result = malloc(olength + 1);
-    if (!result) {
-        printf("Error: Memory allocation failed in encoding_base32_decode.\n");
+    return &str->dataStr[str->size - 1];
+}
+
+char* ma_string_front(String *str) {
+    if (str == NULL || str->size == 0) {
         return NULL;
     }
+    ma_string_invalidate_hash(str);
 
-    size_t i = 0, j = 0;
-    while (i < length) {
-        if (input[i] == '=') {
-            break; // Padding character
-        }
+    return &str->dataStr[0];
+}
 
-        int n = decode_sequence((const unsigned char*)&input[i], &result[j]);
-        if (n < 5) { // Less than 5 bytes decoded, indicates padding or end of input
-            j += n;
-            break;
-        }
+size_t ma_string_length(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_length.\n");
+        return 0;
+    }
 
-        i += 8;
-        j += 5;
+    return str->size;
+}
+
+size_t ma_string_capacity(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_capacity.\n");
+        return 0;
     }
 
-    result[j] = '\0';
+    return str->capacitySize;
+}
 
-    return (char*)result;
+size_t ma_string_max_size(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_max_size.\n");
+        return 0;  // Or a special value indicating error
+    }
+
+    return (size_t)-1;  // You may want to define a more realistic maximum size
 }
 
-char* ma_encoding_base16_encode(const char* input, size_t length) {
-    size_t output_length = length * 2;
-    char* encoded = malloc(output_length + 1);
 
-    if (!encoded) {
-        printf("Error: Memory allocation failed in encoding_base16_encode.\n");
-        return NULL;
+size_t ma_string_copy(String *str, char *buffer, size_t pos, size_t len) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_copy.\n");
+        return 0;
     }
 
-    for (size_t i = 0, j = 0; i < length; ++i) {
-        uint8_t ch = (uint8_t)input[i];
-        encoded[j++] = base16_chars[(ch & 0xF0) >> 4];
-        encoded[j++] = base16_chars[ch & 0x0F];
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_copy.\n");
+        return 0;
     }
 
-    encoded[output_length] = '\0';
-
-    return encoded;
-}
-
-char* ma_encoding_base16_decode(const char* input, size_t length) {
-    if (input == NULL) {
-        printf("Error: Invalid input param in encoding_base16_decode.\n");
-        return NULL;
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_copy.\n");
+        return 0;
     }
-    static const unsigned char base16_decode[128] ={
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
-        0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-     };
 
-    if (length % 2 != 0) {
-        printf("Error: Invalid input length in encoding_base16_decode.\n");
-        return NULL; // Invalid input length
+    size_t copyLen = len;
+    if (pos + len > str->size || len == 0) {
+        copyLen = str->size - pos;  // Adjust copy length if it goes beyond the string end
     }
 
-    size_t olength = length / 2;
-    char* decoded = malloc(olength + 1);
+    memcpy(buffer, str->dataStr + pos, copyLen);
+    buffer[copyLen] = '\0';
 
-    if (!decoded) {
-        printf("Error: Cannot allocate memory for Base16 decoded string in encoding_base16_decode.\n");
-        return NULL;
+    return copyLen;  // Return the number of characters copied
+}
+
+size_t ma_string_find(String *str, const char *buffer, size_t pos) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_find.\n");
+        return MA_STRING_NPOS;
     }
+    return ma_string_find_len(str, buffer, strlen(buffer), pos);
+}
 
-    for (size_t i = 0, j = 0; i < length;) {
-        uint8_t a = base16_decode[(unsigned char)input[i++]];
-        uint8_t b = base16_decode[(unsigned char)input[i++]];
+size_t ma_string_find_len(String *str, const char *buffer, size_t length, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_find.\n");
+        return MA_STRING_NPOS;
+    }
 
-        if (a == 0xFF || b == 0xFF) {
-            printf("Error: Invalid Character in encoding_base16_decode.\n");
-            free(decoded);
-            return NULL; // Invalid character
-        }
+    if (buffer == NULL && length != 0) {
+        printf("Error: The buffer is NULL in string_find.\n");
+        return MA_STRING_NPOS;
+    }
 
-        decoded[j++] = (a << 4) | b;
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_find.\n");
+        return MA_STRING_NPOS;
     }
 
-    decoded[olength] = '\0';
+    const char *found = ma_string_search(str->dataStr + pos, str->size - pos, buffer, length);
+    if (found == NULL) {
+        return MA_STRING_NPOS;  // Substring not found
+    }
 
-    return decoded;
+    return (size_t)(found - str->dataStr);  // Return the position of the substring
 }
 
-uint16_t* ma_encoding_utf32_to_utf16(const uint32_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_utf32_to_utf16.\n");
-        return NULL;
+size_t ma_string_rfind(String *str, const char *buffer, size_t pos) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_rfind.\n");
+        return MA_STRING_NPOS;
     }
+    return ma_string_rfind_len(str, buffer, strlen(buffer), pos);
+}
 
-    // Allocate maximum possible size (each UTF-32 character might become two UTF-16 characters)
-    uint16_t* output = malloc(sizeof(uint16_t) * (length * 2 + 1));
-    if (!output) {
-        printf("Error: Memory allocation failed in encoding_utf32_to_utf16.\n");
-        return NULL;
+size_t ma_string_rfind_len(String *str, const char *buffer, size_t length, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_rfind.\n");
+        return MA_STRING_NPOS;
     }
 
-    size_t j = 0;
-    for (size_t i = 0; i < length; ++i) {
-        uint32_t ch = input[i];
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_rfind.\n");
+        return MA_STRING_NPOS;
+    }
 
-        if (ch > UNI_MAX_LEGAL_UTF32) {
-            printf("Error: Invalid Character in encoding_utf32_to_utf16.\n");
-            free(output);
-            return NULL;
-        }
+    if (length == 0) {
+        printf("Error: The buffer is empty in string_rfind.\n");
+        return MA_STRING_NPOS;
+    }
 
-        if (ch <= UNI_MAX_BMP) {
-            // Character can be directly converted to single UTF-16 unit
-            output[j++] = (uint16_t)ch;
-        }
-        else if (ch > UNI_MAX_BMP && ch <= UNI_MAX_UTF16) {
-            // Convert character to surrogate pair
-            ch -= halfBase;
-            output[j++] = (uint16_t)((ch >> halfShift) + UNI_SUR_HIGH_START);
-            output[j++] = (uint16_t)((ch & halfMask) + UNI_SUR_LOW_START);
-        }
+    if (length > str->size) {
+        return MA_STRING_NPOS;
     }
 
-    // Null-terminate the UTF-16 string
-    output[j] = 0;
+    // Only matches starting at or before pos count, so the search ends with
+    // the one starting at pos.
+    size_t lastStart = (pos < str->size - length) ? pos : str->size - length;
+    const char *found = ma_string_search_reverse(str->dataStr, lastStart + length, buffer, length);
+    if (found == NULL) {
+        return MA_STRING_NPOS;  // Substring not found
+    }
 
-    return output;
+    return (size_t)(found - str->dataStr);
 }
 
-uint32_t* ma_encoding_utf16_to_utf32(const uint16_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_utf16_to_utf32.\n");
-        return NULL;
+int ma_string_find_first_of(String *str, const char *buffer, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_find_first_of.\n");
+        return -1;
     }
 
-    // Allocate memory for the worst-case scenario (all characters are non-surrogates)
-    uint32_t* output = malloc(sizeof(uint32_t) * (length + 1));
-    if (!output) {
-        printf("Error: Memory allocation failed in encoding_utf16_to_utf32.\n");
-        return NULL;
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_find_first_of.\n");
+        return -1;
     }
 
-    size_t j = 0;
-    for (size_t i = 0; i < length; ++i) {
-        uint32_t ch = input[i];
-
-        // Check for high surrogate
-        if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_HIGH_END) {
-            // Ensure there's a following character for the low surrogate
-            if (i + 1 < length) {
-                uint32_t ch2 = input[i + 1];
-                // Check for low surrogate and construct the full code point
-                if (ch2 >= UNI_SUR_LOW_START && ch2 <= UNI_SUR_LOW_END) {
-                    ch = ((ch - UNI_SUR_HIGH_START) << 10) + (ch2 - UNI_SUR_LOW_START) + 0x10000;
-                    i++; // Skip the low surrogate
-                }
-                else {
-                    printf("Error: Invalid surrogate pair in encoding_utf16_to_utf32.\n");
-                    free(output);
-                    return NULL;
-                }
-            }
-            else {
-                printf("Error: Lone high surrogate without a low surrogate in encoding_utf16_to_utf32.\n");
-                free(output);
-                return NULL;
-            }
-        }
-        output[j++] = ch;
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_find_first_of.\n");
+        return -1;
     }
 
-    // Null-terminate the output
-    output[j] = 0;
+    const char *found = ma_string_search(str->dataStr + pos, str->size - pos, buffer, strlen(buffer));
+    if (found != NULL) {
+        return (int)(found - str->dataStr);
+    }
 
-    return output;
+    return -1;  // Buffer string not found
 }
 
-uint8_t* ma_encoding_utf16_to_utf8(const uint16_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_utf16_to_utf8.\n");
-        return NULL;
-    }
-    // Estimate maximum output size (4 bytes per UTF-16 character)
-    size_t maxOutLength = length * 4;
-    uint8_t* output = (uint8_t*)malloc(maxOutLength);
-    if (!output) {
-        printf("Error: Memory allocation failed in encoding_utf16_to_utf8.\n");
-        return NULL;
+int ma_string_find_last_of(String *str, const char *buffer, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_find_last_of.\n");
+        return -1;
     }
 
-    const uint16_t* sourceStart = input;
-    const uint16_t* sourceEnd = input + length;
-    uint8_t* targetStart = output;
-    uint8_t* targetEnd = output + maxOutLength;
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_find_last_of.\n");
+        return -1;
+    }
 
-    ConversionResult result = ConvertUTF16toUTF8(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_find_last_of.\n");
+        return -1;
+    }
 
-    if (result != conversionOK) {
-        printf("Error: Conversion from UTF-16 to UTF-8 failed in encoding_utf16_to_utf8.\n");
-        free(output);
-        return NULL;
+    size_t length = strlen(buffer);
+    if (length > str->size) {
+        return -1;
     }
 
-    // Resize the output to the actual UTF-8 string length
-    size_t actualLength = targetStart - output;
-    uint8_t* resizedOutput = (uint8_t*)realloc(output, actualLength + 1);
-    // if (resizedOutput) {
-    //     resizedOutput[actualLength] = '\0';
-    //     return resizedOutput;
-    // }
+    // Matches may run past pos, they only have to start at or before it.
+    size_t lastStart = (pos < str->size - length) ? pos : str->size - length;
+    const char *found = ma_string_search_reverse(str->dataStr, lastStart + length, buffer, length);
+    if (found != NULL) {
+        return (int)(found - str->dataStr);
+    }
 
-    // return output;
+    return -1;  // Buffer string not found
+}
 
-    if (!resizedOutput) {
-        printf("Error: Reallocation failed in encoding_utf16_to_utf8.\n");
-        free(output);
-        return NULL;
+int ma_string_find_first_not_of(String *str, const char *buffer, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_find_first_not_of.\n");
+        return -1;
     }
-    resizedOutput[actualLength] = '\0';
 
-    return resizedOutput;
-}
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_find_first_not_of.\n");
+        return -1;
+    }
 
-uint8_t* ma_encoding_utf32_to_utf8(const uint32_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_utf32_to_utf8.\n");
-        return NULL;
+    if (pos >= str->size) {
+        printf("Error: Position out of bounds in string_find_first_not_of.\n");
+        return -1;
     }
 
-    // Estimate maximum output size (4 bytes per UTF-32 character)
-    size_t maxOutLength = length * 4;
-    uint8_t* output = (uint8_t*)malloc(maxOutLength);
-    if (!output) {
-        printf("Error: Memory allocation failed in encoding_utf32_to_utf8.\n");
-        return NULL;
+    size_t bufferLen = strlen(buffer);
+    if (bufferLen == 0) {
+        return (int)pos;  // If buffer is empty, return pos
     }
 
-    const uint32_t* sourceStart = input;
-    const uint32_t* sourceEnd = input + length;
-    uint8_t* targetStart = output;
-    uint8_t* targetEnd = output + maxOutLength;
+    for (size_t i = pos; i <= str->size - bufferLen; ++i) {
+        if (strncmp(str->dataStr + i, buffer, bufferLen) != 0) {
+            return (int)i;
+        }
+    }
+    return -1;  // No non-matching position found
+}
 
-    ConversionResult result = ConvertUTF32toUTF8(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+int ma_string_find_last_not_of(String *str, const char *buffer, size_t pos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: The String object or its data is NULL in string_find_last_not_of.\n");
+        return -1;
+    }
 
-    if (result != conversionOK) {
-        printf("Error: Conversion from UTF-32 to UTF-8 failed in encoding_utf32_to_utf8.\n");
-        free(output);
-        return NULL;
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_find_last_not_of.\n");
+        return -1;
     }
 
-    // Resize the output to the actual UTF-8 string length
-    size_t actualLength = targetStart - output;
-    uint8_t* resizedOutput = (uint8_t*)realloc(output, actualLength + 1);
-    // if (resizedOutput) {
-    //     resizedOutput[actualLength] = '\0';
-    //     return resizedOutput;
-    // }
+    size_t bufferLen = strlen(buffer);
+    if (bufferLen == 0) {
+        printf("Error: The buffer is empty in string_find_last_not_of.\n");
+        return -1;
+    }
+    if (pos < bufferLen - 1) {
+        printf("Error: Position is too small in string_find_last_not_of.\n");
+        return -1;
+    }
 
-    // return output;
+    pos = (pos < str->size - bufferLen) ? pos : str->size - bufferLen;
+    for (int i = (int)pos; i >= 0; --i) {
+        if (strncmp(str->dataStr + i, buffer, bufferLen) != 0) {
+            return i;
+        }
+    }
+    return -1;
+}
 
-    if (!resizedOutput) {
-        printf("Error: Reallocation failed in encoding_utf32_to_utf8.\n");
-        free(output);
+const char* ma_string_data(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_data function.\n");
         return NULL;
     }
-    resizedOutput[actualLength] = '\0';
 
-    return resizedOutput;
+    return str->dataStr;
 }
 
-bool ma_encoding_is_utf8_string(const uint8_t** input, size_t length) {
-    if (input == NULL || *input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_is_utf8_string.\n");
-        return false;
+const char* ma_string_c_str(const String *str) {
+    if (str == NULL) {
+        printf("Error: Invalid input in string_c_str function.\n");
+        return "";  // Return empty string for null String
     }
 
-    const uint8_t* source = *input;
-    const uint8_t* sourceEnd = source + length;
-
-    while (source < sourceEnd) {
-        int trailLength = trailingBytesForUTF8[*source] + 1;
-        if (trailLength > sourceEnd - source || !ma_encoding_is_utf8(source, trailLength)) {
-            printf("Error: Invalid UTF-8 encoding detected in encoding_is_utf8_string.\n");
-            return false;
-        }
-        source += trailLength;
+    if (str->dataStr == NULL) {
+        printf("Error: Uninitialized String in string_c_str function.\n");
+        return "";  // Return empty string for uninitialized String
     }
 
-    *input = source; // Update the input pointer to the end of the string
-    return true;
+    return str->dataStr;
 }
 
-uint16_t* ma_encoding_utf8_to_utf16(const uint8_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encoding_utf8_to_utf16.\n");
-        return NULL;
-    }
-    // Estimate maximum output size (each UTF-8 character can be at most 4 bytes,
-    // but can translate to at most 2 UTF-16 characters)
-    size_t maxOutLength = length * 2;
-    uint16_t* output = (uint16_t*)malloc(maxOutLength * sizeof(uint16_t));
-    if (!output) {
-        printf("Error: Memory allocation failed for output in encoding_utf8_to_utf16.\n");
-        return NULL;
+char* ma_string_begin(String *str) {
+    if (str == NULL) {
+        printf("Error: Invalid input in string_begin function.\n");
+        return "";  // Return empty string for null String
     }
+    ma_string_invalidate_hash(str);
 
-    const uint8_t* sourceStart = input;
-    const uint8_t* sourceEnd = input + length;
-    uint16_t* targetStart = output;
-    uint16_t* targetEnd = output + maxOutLength;
+    if (str->dataStr == NULL) {
+        printf("Error: Uninitialized String in string_begin function.\n");
+        return "";  // Return empty string for uninitialized String
+    }
 
-    ConversionResult result = ConvertUTF8toUTF16(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+    return str->dataStr;  // The beginning of the string
+}
 
-    if (result != conversionOK) {
-        printf("Error: Conversion from UTF-8 to UTF-16 failed in encoding_utf8_to_utf16.\n");
-        free(output);
-        return NULL;
+char* ma_string_end(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_end function.\n");
+        return NULL;  // Return NULL for null or uninitialized String
     }
-    // Resize the output to the actual UTF-16 string length
-    size_t actualLength = targetStart - output;
-    uint16_t* resizedOutput = (uint16_t*)realloc(output, actualLength * sizeof(uint16_t) + 1);
-    if (!resizedOutput) {
-        printf("Error: Reallocation failed in encoding_utf8_to_utf16.\n");
-        free(output);
+    ma_string_invalidate_hash(str);
+
+    return str->dataStr + str->size;  // The end of the string
+}
+
+char* ma_string_rbegin(String *str) {
+    if (str == NULL || str->dataStr == NULL || str->size == 0) {
+        printf("Error: Invalid input, uninitialized, or empty String in string_rbegin function.\n");
         return NULL;
     }
-    resizedOutput[actualLength] = '\0'; // Null-terminate the UTF-16 string
+    ma_string_invalidate_hash(str);
 
-    return resizedOutput;
+    return str->dataStr + str->size - 1;
 }
 
-uint32_t* ma_encoding_utf8_to_utf32(const uint8_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encododing_utf8_to_utf32.\n");
+char* ma_string_rend(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_rend function.\n");
         return NULL;
     }
+    ma_string_invalidate_hash(str);
 
-    // Estimate maximum output size (each UTF-8 character can be at most 4 bytes,
-    // translating to a single UTF-32 character)
-    size_t maxOutLength = length;
-    uint32_t* output = (uint32_t*)malloc(maxOutLength * sizeof(uint32_t));
-    if (!output) {
-        printf("Error: Can not Allocate memory in encoding_utf8_to_utf32.\n");
-        return NULL; // Memory allocation failed
-    }
+    return str->dataStr - 1;
+}
 
-    const uint8_t* sourceStart = input;
-    const uint8_t* sourceEnd = input + length;
-    uint32_t* targetStart = output;
-    uint32_t* targetEnd = output + maxOutLength;
+const char* ma_string_cbegin(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_cbegin function.\n");
+        return NULL;  // Return NULL for null or uninitialized String
+    }
 
-    ConversionResult result = ConvertUTF8toUTF32(&sourceStart, sourceEnd, &targetStart, targetEnd, lenientConversion);
+    return str->dataStr;  // The beginning of the string
+}
 
-    if (result != conversionOK) {
-        printf("Error: Failed Convertion to UTF32 in encoding_utf8_to_utf32.\n");
-        free(output);
-        return NULL;
+const char* ma_string_cend(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_cend function.\n");
+        return NULL;  // Return NULL for null or uninitialized String
     }
 
-    // Resize the output to the actual UTF-32 string length
-    size_t actualLength = targetStart - output;
-    uint32_t* resizedOutput = (uint32_t*)realloc(output, (actualLength + 1) * sizeof(uint32_t));
-    if (resizedOutput) {
-        resizedOutput[actualLength] = 0; // Null-terminate the UTF-32 string
-        return resizedOutput;
+    return str->dataStr + str->size;  // The end of the string
+}
+
+const char* ma_string_crbegin(String *str) {
+    if (str == NULL || str->dataStr == NULL || str->size == 0) {
+        printf("Error: Invalid input, uninitialized, or empty String in string_crbegin function.\n");
+        return NULL;  // Return NULL for null, uninitialized, or empty String
     }
-    return output;
+
+    return str->dataStr + str->size - 1;  // Pointer to the last character
 }
 
-void encoding_hex_dump(const void *data, size_t size) {
-    const unsigned char *byte = (const unsigned char *)data;
-    size_t i, j;
+const char* ma_string_crend(String *str) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid input or uninitialized String in string_crend function.\n");
+        return NULL;  // Return NULL for null or uninitialized String
+    }
 
-    for (i = 0; i < size; i += 16) {
-        printf("%08zx  ", i); // Print the offset
+    return str->dataStr - 1;  // Pointer to one before the first character
+}
 
-        // Print hex values
-        for (j = 0; j < 16; j++) {
-            if (i + j < size) {
-                printf("%02x ", byte[i + j]);
-            } else {
-                printf("   "); // Fill space if less than 16 bytes in a line
-            }
-        }
-        printf(" |");
+void ma_string_clear(String* str) {
+    if (str != NULL) {
+        str->size = 0;  // Reset the size to 0, indicating the string is now empty
+        ma_string_invalidate_hash(str);
 
-        // Print ASCII representation
-        for (j = 0; j < 16; j++) {
-            if (i + j < size) {
-                printf("%c", isprint(byte[i + j]) ? byte[i + j] : '.');
-            }
+        // Set the first character to the null terminator.
+        // This ensures that the string is considered empty when accessed.
+        if (str->dataStr != NULL) {
+            str->dataStr[0] = '\0';
         }
-        printf("|\n");
     }
+    printf("Info : String object is null no need to clear in string_clear.\n");
 }
 
-char* ma_encododing_base85_encode(const uint8_t* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encododing_base85_encode.\n");
-        return NULL;
-    }
+char* ma_string_to_upper(String* str) {
+    if (str != NULL) {
+        char* upper = (char*) ma_allocator_alloc(sizeof(char) * (str->size + 1));
+        if (!upper) {
+            printf("Error: Failed to allocate memory for string_to_upper function.\n");
+            exit(-1);
+        }
 
-    // Calculate the maximum possible length of the encoded string
-    size_t encoded_max_length = ((length + 3) / 4) * 5 + 2; // +2 for potential padding and null terminator
-    char* encoded = malloc(encoded_max_length);
-    if (!encoded) {
-        printf("Error: Memory allocation failed for encoded string in encododing_base85_encode.\n");
-        return NULL;
+        ma_string_case_map(upper, str->dataStr, str->size, STRING_CASE_UPPER);
+        upper[str->size] = '\0';
+        return upper;
     }
 
-    size_t input_index = 0;
-    size_t encoded_index = 0;
-    while (input_index < length) {
-        uint32_t acc = 0;
-        size_t chunk_len = (length - input_index < 4) ? (length - input_index) : 4;
-
-        for (size_t i = 0; i < chunk_len; ++i) {
-            acc = (acc << 8) | input[input_index++];
-        }
+    printf("Error: Input 'str' is NULL in string_to_upper function.\n");
+    return NULL;
+}
 
-        if (chunk_len < 4) {
-            acc <<= (4 - chunk_len) * 8; // Padding
-        }
-        if (acc == 0 && chunk_len == 4) {
-            encoded[encoded_index++] = 'z';
+char* ma_string_to_lower(String* str) {
+    if (str != NULL) {
+        char* lower = (char*) ma_allocator_alloc(sizeof(char) * (str->size + 1));
+        if (!lower) {
+            printf("Error: Failed to allocate memory for string_to_lower function.\n");
+            exit(-1);
         }
-        else {
-            for (int i = 4; i >= 0; --i) {
-                encoded[encoded_index + i] = (acc % 85) + 33;
-                acc /= 85;
-            }
-            encoded_index += 5;
 
-            if (chunk_len < 4) {
-                encoded_index -= (4 - chunk_len);  // Adjust for padding
-                break;
-            }
-        }
+        ma_string_case_map(lower, str->dataStr, str->size, STRING_CASE_LOWER);
+        lower[str->size] = '\0';
+        return lower;
     }
 
-    encoded[encoded_index] = '\0';
-
-    return encoded;
+    printf("Error: Input 'str' is NULL in string_to_lower function.\n");
+    return NULL;
 }
 
-uint8_t* ma_encododing_base85_decode(const char* input, size_t length) {
-    if (input == NULL || length == 0) {
-        printf("Error: Invalid input or length in encododing_base85_decode.\n");
-        return NULL;
+bool ma_string_set_pool_size(String* str, size_t newSize) {
+    if (!str) {
+        printf("Error: Invalid input - 'str' is NULL in string_set_pool_size.\n");
+        return false;
     }
 
-    // Calculate the maximum possible length of the decoded string
-    size_t decoded_max_length = (length / 5) * 4;
-    uint8_t* decoded = malloc(decoded_max_length);
-    if (!decoded) {
-        printf("Error: Memory allocation failed for decoded string in encododing_base85_decode.\n");
-        return NULL;
+    if (newSize == 0) {
+        printf("Error: Invalid input - 'newSize' is zero in string_set_pool_size.\n");
+        return false;
     }
+    char* oldData = str->dataStr;
+    size_t oldCapacity = str->capacitySize;
 
-    size_t input_index = 0;
-    size_t decoded_index = 0;
-    while (input_index < length) {
-        if (isspace(input[input_index])) {
-            input_index++;   // Skip whitespace
-            continue;
-        }
-        if (input[input_index] == 'z') {
-            // Special case: 'z' represents four zero bytes
-            memset(decoded + decoded_index, 0, 4);
-            decoded_index += 4;
-            input_index++;
-            continue;
-        }
-
-        uint32_t acc = 0;
-        int count = 0;
-        for (int i = 0; i < 5 && input_index < length; ++i) {
-            if (isspace(input[input_index])) {
-                // Skip whitespace within the group
-                input_index++;
-                continue;
-            }
-
-            char ch = input[input_index++];
-            if (ch < 33 || ch > 117) {
-                printf("Error: Invalid character encountered in encododing_base85_decode.\n");
-                free(decoded);
-                return NULL; // Invalid character
-            }
-
-            acc = acc * 85 + (ch - 33);
-            count++;
+    // Create a new memory pool with the specified size
+    MemoryPoolString *newPool = ma_string_memory_pool_create(newSize);
+    if (!newPool) {
+        printf("Error: Failed to create a new memory pool in string_set_pool_size.\n");
+        return false; // Return false if memory pool creation fails
+    }
+    // If the string already has pool data, move it to the new pool before the old one goes away
+    if (str->dataStr && !ma_string_is_inline(str)) {
+        char* newData = ma_string_memory_pool_allocate(newPool, str->size + 1); // +1 for null terminator
+        if (!newData) {
+            printf("Error: Failed to allocate memory for string data in the new pool in string_set_pool_size.\n");
+            ma_string_memory_pool_destroy(newPool);
+            return false; // Return false if allocation fails
         }
-
-        int padding = 0;
-        if (count < 5) {
-            padding = 5 - count;
-            for (int i = 0; i < padding; i++) {
-                acc = acc * 85 + 84; // Assume 'u' for padding, which is the highest value (84)
-            }
+        memcpy(newData, str->dataStr, str->size);
+        newData[str->size] = '\0';
+        str->dataStr = newData;
+        str->capacitySize = str->size + 1;
+    }
+    if (str->poolKind == STRING_POOL_OWNED) {
+        if (str->pool) {
+            ma_string_memory_pool_destroy(str->pool);
         }
+    }
+    else {
+        ma_string_release_data(str, ma_string_pool(str), oldData, oldCapacity);
+    }
+    str->pool = newPool;
+    str->poolKind = STRING_POOL_OWNED;
 
-        for (int i = 3; i >= 0; --i) {
-            if (i < padding) {
-                break; // Ignore padding bytes
-            }
-            decoded[decoded_index++] = (acc >> (i * 8)) & 0xFF;
-        }
+    return true; // Return true on successful pool resize
+}
 
-        if (count < 5) {
-            break; // End of data
-        }
+void ma_string_concatenate(String *str1, const String *str2) {
+    if (str1 == NULL) {
+        printf("Error: Null String object 'str1' in string_concatenate.\n");
+        return;
     }
 
-    // Resize the output buffer to the actual decoded data length
-    uint8_t* resized_decoded = realloc(decoded, decoded_index + 1); // +1 for null terminator, if needed
-    if (!resized_decoded) {
-        printf("Error: Reallocation failed in encododing_base85_decode.\n");
-        free(decoded);
-        return NULL;
+    if (str2 == NULL) {
+        printf("Error: Null String object 'str2' in string_concatenate.\n");
+        return;
     }
-
-    resized_decoded[decoded_index] = '\0'; // Null-terminate if treating as a C-style string
-
-    return resized_decoded;
+    ma_string_append_len(str1, str2->dataStr, str2->size);
 }
 
-char* ma_encoding_base58_encode(const void *data, size_t binsz) {
-    if (!data) {
-        printf("Error: Invalid input data in encoding_base58_encode.\n");
-        return NULL;
+void ma_string_trim_left(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_trim_left.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->size == 0) {
+        return;
     }
 
-    const uint8_t *bin = data;
-    int carry;
-    size_t i, j, high, zcount = 0;
-    size_t size;
+    size_t i = 0;
+    while (i < str->size && isspace((unsigned char)str->dataStr[i])) {
+        i++;
+    }
 
-    while (zcount < binsz && !bin[zcount]) {
-        ++zcount;
+    if (i > 0) {
+        memmove(str->dataStr, str->dataStr + i, str->size - i);
+        str->size -= i;
+        str->dataStr[str->size] = '\0';
     }
+}
 
-    size = (binsz - zcount) * 138 / 100 + 1;
-    uint8_t *buf = malloc(size * sizeof(uint8_t));
-    if (!buf) {
-        printf("Error: Memory allocation failed for buffer in encoding_base58_encode.\n");
-        return NULL;
+void ma_string_trim_right(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_trim_right.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->size == 0) {
+        return;
     }
-    memset(buf, 0, size);
 
-    for (i = zcount, high = size - 1; i < binsz; ++i, high = j) {
-        for (carry = bin[i], j = size - 1; (j > high) || carry; --j) {
-            carry += 256 * buf[j];
-            buf[j] = carry % 58;
-            carry /= 58;
+    size_t i = str->size;
+    while (i > 0 && isspace((unsigned char)str->dataStr[i - 1])) {
+        i--;
+    }
 
-            if (!j) {
-                break;
-            }
-        }
+    if (i < str->size) {
+        str->dataStr[i] = '\0';
+        str->size = i;
     }
+}
 
-    for (j = 0; j < size && !buf[j]; ++j) {
-        // Skip leading zeros in binary
+void ma_string_trim(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_trim.\n");
+        return;
     }
 
-    size_t b58sz = zcount + size - j + 1;
-    char *b58 = malloc(b58sz);
-    if (!b58) {
-        printf("Error: Memory allocation failed for Base58 encoding in encoding_base58_encode.\n");
-        free(buf);
+    ma_string_trim_left(str);
+    ma_string_trim_right(str);
+}
+
+String** ma_string_split(String *str, const char *delimiter, int *count) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_split.\n");
         return NULL;
     }
-    if (zcount) {
-        memset(b58, '1', zcount);
+    if (delimiter == NULL) {
+        printf("Error: Null delimiter in string_split.\n");
+        return NULL;
     }
-    for (i = zcount; j < size; ++i, ++j) {
-        b58[i] = b58digits_ordered[buf[j]];
+
+    size_t num_splits = 0;
+    char *temp = ma_string_strdup(str->dataStr);
+    if (temp == NULL) {
+        printf("Error: Memory allocation failed in string_split.\n");
+        return NULL;
     }
-    b58[i] = '\0';
 
-    free(buf);
+    char *token = strtok(temp, delimiter);
 
-    return b58;
-}
+    while (token != NULL) {
+        num_splits++;
+        token = strtok(NULL, delimiter);
+    }
+    ma_allocator_free(temp);
 
-char* ma_encoding_base58_decode(const char *b58, size_t *binszp) {
-    if (b58 == NULL || binszp == NULL) {
-        printf("Error: Invalid input or binszp pointer in encoding_base58_decode.\n");
+    if (num_splits == 0) {
         return NULL;
     }
 
-    size_t b58sz = strlen(b58);
-    size_t binsz = b58sz * 733 / 1000 + 1; // Rough estimate of binary size
-    uint8_t *bin = malloc(binsz);
-    if (!bin) {
-        printf("Error: Memory allocation failed in encoding_base58_decode.\n");
+    String** splits = ma_allocator_alloc(sizeof(String*) * num_splits);
+    if (splits == NULL) {
+        printf("Error: Memory allocation failed for splits in string_split.\n");
         return NULL;
     }
-    memset(bin, 0, binsz);
 
-    size_t i, j;
-    int carry;
-    size_t high = binsz - 1;
+    temp = ma_string_strdup(str->dataStr);
+    if (temp == NULL) {
+        printf("Error: Memory allocation failed in string_split.\n");
+        ma_allocator_free(splits);
+        return NULL;
+    }
 
-    // Process the Base58 string
-    for (i = 0; i < b58sz; ++i) {
-        if (b58[i] & 0x80 || b58digits_map[(unsigned char)b58[i]] == -1) {
-            printf("Error: Invalid Base58 character encountered in encoding_base58_decode.\n");
-            free(bin);
-            return NULL; // Invalid Base58 character
-        }
+    token = strtok(temp, delimiter);
+    size_t index = 0;
 
-        for (carry = b58digits_map[(unsigned char)b58[i]], j = binsz - 1; (j > high) || carry; --j) {
-            carry += 58 * bin[j];
-            bin[j] = carry % 256;
-            carry /= 256;
+    while (token != NULL && index < num_splits) {
+        splits[index] = ma_string_create(token);
 
-            if (!j) {
-                break; // Avoid wraparound
+        if (splits[index] == NULL) {
+            printf("Error: Failed to create string in string_split.\n");
+            // Free previously allocated strings and array
+            for (size_t i = 0; i < index; i++) {
+                ma_string_deallocate(splits[i]); // Assuming string_free is defined
             }
+            ma_allocator_free(splits);
+            ma_allocator_free(temp);
+            return NULL;
         }
-        high = j;
-    }
-
-    for (j = 0; j < binsz && !bin[j]; ++j) {
-        // Skip leading zeros in binary
+        index++;
+        token = strtok(NULL, delimiter);
     }
+    ma_allocator_free(temp);
+    *count = num_splits;
 
-    *binszp = binsz - j;
-    char *result = malloc(*binszp);
+    return splits;
+}
 
-    if (!result) {
-        printf("Error: Memory allocation failed for result in encoding_base58_decode.\n");
-        free(bin);
+String* ma_string_join(String **strings, int count, const char *delimiter) {
+    if (strings == NULL) {
+        printf("Error: Null string array in string_join.\n");
         return NULL;
     }
-    memcpy(result, bin + j, *binszp);
 
-    free(bin);
-    return result;
-}
+    if (count <= 0) {
+        printf("Error: Invalid count in string_join.\n");
+        return NULL;
+    }
 
-uint8_t* ma_encoding_base91_decode(const char* encoded, size_t* decoded_length) {
-    if (!encoded || !decoded_length) {
-        printf("Error: Invalid input or decoded_length pointer in encoding_base91_decode.\n");
+    if (delimiter == NULL) {
+        printf("Error: Null delimiter in string_join.\n");
         return NULL;
     }
 
-    size_t len = strlen(encoded);
-    *decoded_length = 0;
-    uint8_t* decoded = malloc(len); // Max possible size
-    if (!decoded) {
-        printf("Error: Memory allocation failed in encoding_base91_decode.\n");
+    String* result = ma_string_create("");
+    if (result == NULL) {
+        printf("Error: Memory allocation failed in string_join.\n");
         return NULL;
     }
 
-    int v = -1;
-    int b = 0;
-    int n = 0;
-    size_t index = 0;
+    size_t totalLength = strlen(delimiter) * (size_t)(count - 1); // Presize so the appends never regrow
+    for (int i = 0; i < count; i++) {
+        totalLength += strings[i]->size;
+    }
+    ma_string_reserve(result, totalLength + 1);
 
-    for (size_t i = 0; i < len; ++i) {
-        int c = base91_decode_value(encoded[i]);
-        if (c == -1) {
-            printf("Error: Invalid character encountered in encoding_base91_decode.\n");
-            free(decoded);
-            return NULL; // Invalid character
+    size_t delimiterLength = strlen(delimiter);
+    for (int i = 0; i < count; i++) {
+        ma_string_append_len(result, strings[i]->dataStr, strings[i]->size);
+        if (i < count - 1) {
+            ma_string_append_len(result, delimiter, delimiterLength);
         }
+    }
+    return result;
+}
 
-        if (v < 0) {
-            v = c;
-        }
-        else {
-            v += c * 91;
-            b |= v << n;
-            n += (v & 8191) > 88 ? 13 : 14;
+typedef struct StringReplacement {
+    const char *needle;
+    size_t needleLength;
+    const char *replacement;
+    size_t replacementLength;
+} StringReplacement;
 
-            while (n > 7) {
-                decoded[index++] = (uint8_t)(b & 255);
-                b >>= 8;
-                n -= 8;
-            }
-            v = -1;
-        }
+static bool ma_string_replacement_next(const void *context, const char *data, size_t size, size_t pos, size_t *offset, size_t *length, const char **replacement, size_t *replacementLength) {
+    const StringReplacement *rule = context;
+    const char *found = ma_string_search(data + pos, size - pos, rule->needle, rule->needleLength);
+    if (found == NULL) {
+        return false;
     }
+    *offset = (size_t)(found - data);
+    *length = rule->needleLength;
+    *replacement = rule->replacement;
+    *replacementLength = rule->replacementLength;
+    return true;
+}
 
-    if (v != -1) {
-        if (index >= len) {
-            printf("Error: Decoded index out of bounds in encoding_base91_decode.\n");
-            free(decoded);
-            return NULL;
+// Replaces every non-overlapping occurrence of the needle in one linear pass
+// with at most one allocation, copying the arguments first when they point
+// into the String being rewritten.
+static void ma_string_replace_occurrences(String *str, const char *oldStr, size_t oldLen, const char *newStr, size_t newLen) {
+    const char *begin = str->dataStr;
+    const char *end = str->dataStr + str->capacitySize;
+    bool aliased = (oldStr >= begin && oldStr < end) || (newLen != 0 && newStr >= begin && newStr < end);
+
+    char *copy = NULL;
+    if (aliased) {
+        copy = ma_allocator_alloc(oldLen + newLen);
+        if (copy == NULL) {
+            printf("Error: Memory allocation failed in string_replace_occurrences.\n");
+            return;
         }
-        decoded[index++] = (uint8_t)((b | v << n) & 255);
+        memcpy(copy, oldStr, oldLen);
+        if (newLen != 0) {
+            memcpy(copy + oldLen, newStr, newLen);
+        }
+        oldStr = copy;
+        newStr = copy + oldLen;
     }
 
-    *decoded_length = index;
-
-    return decoded;
+    StringReplacement rule = { oldStr, oldLen, newStr, newLen };
+    ma_string_rewrite(str, ma_string_replacement_next, &rule, newLen <= oldLen);
+    ma_allocator_free(copy);
 }
 
-char* ma_encoding_base91_encode(const uint8_t* data, size_t length) {
-    if (!data || length == 0) {
-        printf("Error: Invalid input data or length in encoding_base91_encode.\n");
-        return NULL;
+void ma_string_replace_all(String *str, const char *oldStr, const char *newStr) {
+    if (oldStr == NULL || newStr == NULL) {
+        printf("Error: Null substring in string_replace_all.\n");
+        return;
     }
+    ma_string_replace_all_len(str, oldStr, strlen(oldStr), newStr, strlen(newStr));
+}
 
-    size_t estimated_length = length * 1.23 + 2; // +2 for padding and null terminator
-    char* encoded = malloc(estimated_length);
-    if (!encoded) {
-        printf("Error: Memory allocation failed in encoding_base91_encode.\n");
-        return NULL;
+void ma_string_replace_all_len(String *str, const char *oldStr, size_t oldLen, const char *newStr, size_t newLen) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_replace_all.\n");
+        return;
     }
 
-    size_t index = 0;
-    int b = 0;
-    int n = 0;
-    int v;
+    if (oldStr == NULL || (newStr == NULL && newLen != 0)) {
+        printf("Error: Null substring in string_replace_all.\n");
+        return;
+    }
 
-    for (size_t i = 0; i < length; ++i) {
-        b |= (data[i] << n);
-        n += 8;
+    if (oldLen == 0) {
+        printf("Error: Empty substring in string_replace_all.\n");
+        return;
+    }
 
-        if (n > 13) {
-            v = b & 8191;
+    ma_string_replace_occurrences(str, oldStr, oldLen, newStr, newLen);
+}
 
-            if (v > 88) {
-                b >>= 13;
-                n -= 13;
-            }
-            else {
-                v = b & 16383;
-                b >>= 14;
-                n -= 14;
-            }
+// Length of the leading ASCII whitespace that atoi and strtod used to skip.
+static size_t ma_string_leading_space(const String *str) {
+    size_t i = 0;
+    while (i < str->size && (str->dataStr[i] == ' ' || (str->dataStr[i] >= '\t' && str->dataStr[i] <= '\r'))) {
+        i++;
+    }
+    return i;
+}
 
-            if (index + 2 < estimated_length) {
-                encoded[index++] = BASE91_ALPHABET[v % 91];
-                encoded[index++] = BASE91_ALPHABET[v / 91];
-            }
-            else {
-                printf("Error: Encoding index out of bounds in encoding_base91_encode.\n");
-                free(encoded);
-                return NULL;
-            }
-        }
+int ma_string_to_int(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_to_int.\n");
+        return 0;
+    }
+    if (ma_string_empty(str)) {
+        printf("Error: Empty string in string_to_int.\n");
+        return 0;
     }
 
-    if (n) {
-        if (index + 1 < estimated_length) {
-            encoded[index++] = BASE91_ALPHABET[b % 91];
-        }
-        if (n > 7 || b > 90) {
-            if (index + 1 < estimated_length) {
-                encoded[index++] = BASE91_ALPHABET[b / 91];
-            }
-        }
+    size_t skip = ma_string_leading_space(str);
+    int64_t value = 0;
+    ma_string_parse_int64_len(str->dataStr + skip, str->size - skip, &value);
+    return (value > INT_MAX) ? INT_MAX : (value < INT_MIN) ? INT_MIN : (int)value;
+}
+
+float ma_string_to_float(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_to_float.\n");
+        return 0.0f;
+    }
+    if (ma_string_empty(str)) {
+        printf("Error: Empty string in string_to_float.\n");
+        return 0.0f;
     }
 
-    encoded[index] = '\0';
+    size_t skip = ma_string_leading_space(str);
+    float value = 0.0f;
+    ma_string_parse_float_len(str->dataStr + skip, str->size - skip, &value);
+    return value;
+}
 
-    return encoded;
+double ma_string_to_double(String* str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_to_double.\n");
+        return 0.0;
+    }
+    if (ma_string_empty(str)) {
+        printf("Error: Empty string in string_to_double.\n");
+        return 0.0;
+    }
+
+    size_t skip = ma_string_leading_space(str);
+    double value = 0.0;
+    ma_string_parse_double_len(str->dataStr + skip, str->size - skip, &value);
+    return value;
 }
 
-#if defined(_WIN32) || defined(_WIN64)
-    // Function to convert UTF-8 string to wchar_t string (Windows only)
-    wchar_t* encoding_utf8_to_wchar(const char* utf8Str) {
-        if (utf8Str == NULL) {
-            printf("Error: Input string is NULL\n");
-            return NULL;
-        }
+void ma_string_pad_left(String *str, size_t totalLength, char padChar) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_pad_left.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->size >= totalLength) {
+        printf("Error: Size of String object is bigger or equal that total Length in string_pad_left.\n");
+        return;
+    }
+    size_t padSize = totalLength - str->size;
+    size_t newSize = str->size + padSize;
 
-        int size_needed = MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, NULL, 0);
-        if (size_needed == 0) {
-        printf("Error: MultiByteToWideChar failed to calculate size. Error: %lu\n", GetLastError());
-            return NULL;
-        }
+    if (!ma_string_grow(str, newSize + 1)) { // +1 for null terminator
+        printf("Error: Failed to allocate memory in string_pad_left.\n");
+        return;
+    }
 
-        wchar_t* wstr = (wchar_t*)malloc(size_needed * sizeof(wchar_t));
-        if (!wstr) {
-            printf("Error: Cannot allocate memory for wchar\n");
-            return NULL;
-        }
+    memmove(str->dataStr + padSize, str->dataStr, str->size);
+    memset(str->dataStr, padChar, padSize);
+    str->dataStr[newSize] = '\0';
+    str->size = newSize;
+}
+
+void ma_string_pad_right(String *str, size_t totalLength, char padChar) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_pad_right.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->size >= totalLength) {
+        printf("Error: Size of String object is bigger or equal that total Length in string_pad_right.\n");
+        return;
+    }
 
-        int result = MultiByteToWideChar(CP_UTF8, 0, utf8Str, -1, wstr, size_needed);
-        if (result == 0) {
-            printf("Error: Conversion from UTF-8 to wchar failed\n");
-            free(wstr);
-            return NULL;
-        }
+    size_t padSize = totalLength - str->size;
+    size_t newSize = str->size + padSize;
 
-        return wstr;
+    if (!ma_string_grow(str, newSize + 1)) { // +1 for null terminator
+        printf("Error: Failed to allocate memory in string_pad_right.\n");
+        return;
     }
 
-    char* ma_encoding_wchar_to_utf8(const wchar_t* wstr) {
-        if (wstr == NULL) {
-            printf("Error: Input wchar string is NULL\n");
-            return NULL;
-        }
-
-        // Get the length of the required buffer
-        int utf8Length = WideCharToMultiByte(CP_UTF8, 0, wstr, -1, NULL, 0, NULL, NULL);
-        if (utf8Length == 0) {
-            printf("Error: WideCharToMultiByte failed to calculate length\n");
-            return NULL;
-        }
+    memset(str->dataStr + str->size, padChar, padSize);
+    str->dataStr[newSize] = '\0';
+    str->size = newSize;
+}
 
-        char* utf8Str = malloc(utf8Length * sizeof(char));
-        if (!utf8Str) {
-            printf("Error: Cannot allocate memory for UTF-8 string\n");
-            return NULL;
-        }
-        // Convert the wide-character string to UTF-8
-        if (WideCharToMultiByte(CP_UTF8, 0, wstr, -1, utf8Str, utf8Length, NULL, NULL) == 0) {
-            printf("Error: Conversion from wchar to UTF-8 failed\n");
-            free(utf8Str);
-            return NULL;
-        }
+String* ma_string_to_hex(String *str) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_to_hex.\n");
+        return NULL;
+    }
+    if (ma_string_empty(str)) {
+        return ma_string_create(""); // Return an empty string for an empty input.
+    }
 
-        return utf8Str;
+    String *hexStr = ma_string_create("");
+    if (hexStr == NULL) {
+        printf("Error: Memory allocation failed in string_to_hex.\n");
+        return NULL;
     }
-#endif
 
-void ma_encoding_initialize(void) {
-    setlocale(LC_ALL, "");
+    for (size_t i = 0; i < str->size; ++i) {
+        char buffer[3];  // Each char can be represented by max 2 hex digits + null terminator
+
+        sprintf(buffer, "%02x", (unsigned char)str->dataStr[i]);
+        ma_string_append(hexStr, buffer);
+    }
+    return hexStr;
 }
 
-// ------------------------------------------------------------------------- //
-//                              String                                       //
-// ------------------------------------------------------------------------- //
+String* ma_string_from_hex(String *hexStr) {
+    if (hexStr == NULL) {
+        printf("Error: Null String object in string_from_hex.\n");
+        return NULL;
+    }
+    if (ma_string_empty(hexStr) || (hexStr->size % 2) != 0) {
+        printf("Error: Invalid hex string in string_from_hex.\n");
+        return NULL; // Hex string should have an even number of characters
+    }
 
-const char* STRING_ASCII_LETTERS = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-const char* STRING_ASCII_LOWERCASE = "abcdefghijklmnopqrstuvwxyz";
-const char* STRING_ASCII_UPPERCASE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-const char* STRING_DIGITS = "0123456789";
-const char* STRING_HEXDIGITS = "0123456789abcdefABCDEF";
-const char* STRING_WHITESPACE = " \t\n\r\f\v";
-const char* STRING_PUNCTUATION = "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+    String *str = ma_string_create("");
+    if (str == NULL) {
+        printf("Error: Memory allocation failed in string_from_hex.\n");
+        return NULL;
+    }
 
-MemoryPoolString* global_pool = NULL;
-bool memoryPoolCreated = false;
+    for (size_t i = 0; i < hexStr->size; i += 2) {
+        char buffer[3] = {hexStr->dataStr[i], hexStr->dataStr[i + 1], '\0'};
+        char ch = (char)strtol(buffer, NULL, 16);
 
-void ma_string_init_global_memory_pool(size_t size) {
-    if (global_pool == NULL) {
-        global_pool = ma_string_memory_pool_create(size);
-        memoryPoolCreated = true;
+        ma_string_push_back(str, ch);
     }
+    return str;
 }
 
-void ma_string_destroy_global_memory_pool() {
-    if (global_pool != NULL && memoryPoolCreated) {
-        ma_string_memory_pool_destroy(global_pool);
-        global_pool = NULL;
+size_t ma_string_count(String* str, const char* substr) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_count.\n");
+        return 0;
+    }
+    if (substr == NULL) {
+        printf("Error: Null substring in string_count.\n");
+        return 0;
+    }
+    if (str->dataStr == NULL) {
+        printf("Error: Null data string in String object in string_count.\n");
+        return 0;
     }
+    return ma_string_count_len(str, substr, strlen(substr));
 }
 
-MemoryPoolString* ma_string_memory_pool_create(size_t size) {
-    MemoryPoolString *pool = malloc(sizeof(MemoryPoolString));
-    if (pool) {
-        pool->pool = malloc(size);
-        if (!pool->pool) {
-            free(pool);
-            return NULL;
-        }
+size_t ma_string_count_len(String* str, const char* substr, size_t length) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_count.\n");
+        return 0;
+    }
+    if (substr == NULL && length != 0) {
+        printf("Error: Null substring in string_count.\n");
+        return 0;
+    }
+    if (length == 0) {
+        return 0;
+    }
 
-        pool->poolSize = size;
-        pool->used = 0;
+    size_t count = 0;
+    const char* temp = str->dataStr;
+    const char* end = str->dataStr + str->size;
+    const char* found;
+
+    while ((found = ma_string_search(temp, (size_t)(end - temp), substr, length)) != NULL) {
+        count++;
+        temp = found + length;
     }
-    return pool;
+    return count;
 }
 
-void* ma_string_memory_pool_allocate(MemoryPoolString *pool, size_t size) {
-    if (pool == NULL) {
-        printf("Error: Memory pool is NULL in memory_pool_allocate.\n");
-        return NULL;
-    }
-    if (pool->used + size > pool->poolSize) {
-        printf("Error: Memory pool out of memory in memory_pool_allocate.\n");
-        return NULL; // Pool is out of memory
+void ma_string_remove(String* str, const char* substr) {
+    if (substr == NULL) {
+        printf("Error: Null substring in string_remove.\n");
+        return;
     }
+    ma_string_remove_len(str, substr, strlen(substr));
+}
 
-    void *mem = (char *)pool->pool + pool->used;
-    pool->used += size;
+void ma_string_remove_len(String* str, const char* substr, size_t length) {
+    if (str == NULL) {
+        printf("Error: Null String object in string_remove.\n");
+        return;
+    }
+    if (substr == NULL) {
+        printf("Error: Null substring in string_remove.\n");
+        return;
+    }
+    if (str->dataStr == NULL) {
+        printf("Error: Null data string in String object in string_remove.\n");
+        return;
+    }
+    if (length == 0) {
+        printf("Error: Empty substring in string_remove.\n");
+        return;
+    }
 
-    return mem;
+    ma_string_replace_occurrences(str, substr, length, NULL, 0);
 }
 
-void ma_string_memory_pool_destroy(MemoryPoolString *pool) {
-    if (pool == NULL) {
-        printf("Warning: Attempt to destroy a NULL memory pool in memory_pool_destroy.\n");
+void ma_string_remove_range(String* str, size_t startPos, size_t endPos) {
+    if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Null String object in string_remove_range.\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (startPos >= endPos || endPos > str->size) {
+        printf("Error: Invalid range in string_remove_range.\n");
         return;
     }
-    free(pool->pool);
-    free(pool);
+    size_t length = endPos - startPos;
+
+    memmove(str->dataStr + startPos, str->dataStr + endPos, str->size - endPos + 1); // +1 for null terminator
+    str->size -= length;
 }
 
-//static const char *base64_chars =
-//    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-//    "abcdefghijklmnopqrstuvwxyz"
-//    "0123456789+/";
+String* ma_string_from_int(int value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    size_t length = ma_string_write_int64(buffer, value);
 
+    return ma_string_create_len(buffer, length);
+}
 
-String* ma_string_create(const char* initialStr) {
-    String* str = (String*)malloc(sizeof(String));
-    if (!str) {
-        printf("Error: Memory allocation failed for String object in string_create.\n");
-        exit(-1);
-    }
+char* ma_string_from_int_cstr(int value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    size_t length = ma_string_write_int64(buffer, value);
 
-    size_t initialSize = initialStr ? strlen(initialStr) : 0;
-    str->size = initialSize;
-    str->capacitySize = 32 + initialSize; // +1 for null terminator
-
-    // Initialize memory pool for strings with a smaller size
-    size_t initialPoolSize = 1000000; // 1KB
-    str->pool = ma_string_memory_pool_create(initialPoolSize);
-    if (!str->pool) {
-        printf("Error: Memory pool creation failed in string_create.\n");
-        free(str);
-        exit(-1);
+    char* result = ma_allocator_alloc(length + 1); // +1 for null-terminator
+    if (result) {
+        memcpy(result, buffer, length + 1);
     }
 
-    str->dataStr = ma_string_memory_pool_allocate(str->pool, str->capacitySize);
-    if (!str->dataStr) {
-        printf("Error: Memory pool allocation failed in string_create.\n");
-        ma_string_memory_pool_destroy(str->pool);
-        free(str);
-        exit(-1);
+    return result;
+}
+
+String* ma_string_from_float(float value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    size_t length = ma_string_write_float(buffer, value);
+
+    return ma_string_create_len(buffer, length);
+}
+
+String* ma_string_from_double(double value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    size_t length = ma_string_write_double(buffer, value);
+
+    return ma_string_create_len(buffer, length);
+}
+
+String** ma_string_tokenize(String* str, const char* delimiters, int* count) {
+    if (str == NULL || delimiters == NULL) {
+        printf("Error: Invalid input in string_tokenize.\n");
+        return NULL;
     }
 
-    if (initialStr) {
-        strcpy(str->dataStr, initialStr);
+    size_t num_tokens = 0;
+    char* temp_str = ma_string_strdup(str->dataStr); // strdup
+    if (temp_str == NULL) {
+        printf("Error: Memory allocation failed in string_tokenize.\n");
+        return NULL;
     }
-    return str;
-}
 
-String* ma_string_create_with_pool(size_t size) {
-    static int counter = 0;
+    char* token = strtok(temp_str, delimiters);
 
-    if (!counter) {
-        ma_string_init_global_memory_pool(size);
-        counter++;
+    while (token != NULL) {
+        num_tokens++;
+        token = strtok(NULL, delimiters);
     }
-    // Ensure global memory pool is initialized
-    if (global_pool == NULL) {
-        printf("Error: Failed to initialize global memory pool in string_create_with_pool.\n");
-        exit(-1);  // Consider handling the error without exiting
+
+    ma_allocator_free(temp_str);
+
+    // Allocate array of String pointers
+    String** tokens = ma_allocator_alloc(num_tokens * sizeof(String*));
+    if (tokens == NULL) {
+        printf("Error: Memory allocation failed for tokens in string_tokenize.\n");
+        return NULL;
     }
 
-    String* str = (String*)malloc(sizeof(String));
-    if (!str) {
-        printf("Error: Memory allocation failed for String object in string_create_with_pool.\n");
-        exit(-1);
+    // Tokenize again to fill the array
+    temp_str = ma_string_strdup(str->dataStr);
+    if (temp_str == NULL) {
+        printf("Error: Memory allocation failed in string_tokenize.\n");
+        ma_allocator_free(tokens);
+        return NULL;
     }
 
-    str->size = 0;
-    str->capacitySize = 1;
-    str->dataStr = NULL; // Data is not allocated yet (lazy allocation)
-    str->pool = global_pool; // Use the global pool
+    token = strtok(temp_str, delimiters);
+    size_t idx = 0;
 
-    return str;
+    while (token != NULL && idx < num_tokens) {
+        tokens[idx] = ma_string_create(token);
+        if (tokens[idx] == NULL) {
+            printf("Error: string_create failed in string_tokenize.\n");
+            for (size_t i = 0; i < idx; ++i) {
+                // Assuming a function to free String* is available
+                ma_string_deallocate(tokens[i]);
+            }
+            ma_allocator_free(tokens);
+            ma_allocator_free(temp_str);
+            return NULL;
+        }
+        idx++;
+        token = strtok(NULL, delimiters);
+    }
+    ma_allocator_free(temp_str);
+    *count = num_tokens;
+
+    return tokens;
 }
 
-String* ma_string_substr(String* str, size_t pos, size_t len) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_substr.\n");
-        return NULL;
+int ma_string_compare_ignore_case(String* str1, String* str2) {
+    if (str1 == NULL || str2 == NULL) {
+        if (str1 == str2) {
+            return 0;
+        }
+        return (str1 == NULL) ? -1 : 1;
     }
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_substr.\n");
-        return NULL;
+    if (str1->dataStr == NULL || str2->dataStr == NULL) {
+        if (str1->dataStr == str2->dataStr) {
+            return 0; // Both dataStr are NULL, considered equal
+        }
+        return (str1->dataStr == NULL) ? -1 : 1; // One dataStr is NULL, the other is not
     }
 
-    // Adjust len if it goes beyond the end of the string
-    if (pos + len > str->size) {
-        len = str->size - pos;
+    size_t common = (str1->size < str2->size) ? str1->size : str2->size;
+    int result = ma_string_compare_folded(str1->dataStr, str2->dataStr, common);
+    if (result != 0) {
+        return result;
     }
+    return (str1->size > str2->size) - (str1->size < str2->size);
+}
 
-    String* substr = ma_string_create(NULL); // Allocate memory for the substring
-    if (substr == NULL) {
-        printf("Error: Memory allocation failed for substring in string_substr.\n");
+String* ma_string_base64_encode(const String *input) {
+    if (input == NULL) {
+        printf("Error: The String object is NULL in string_baes64_encode.\n");
         return NULL;
     }
-
-    substr->size = len;
-    substr->capacitySize = len + 1;
-    substr->dataStr = (char*)malloc(substr->capacitySize * sizeof(char));
-
-    if (substr->dataStr == NULL) {
-        printf("Error: Memory allocation failed for dataStr in substring in string_substr.\n");
-        free(substr);
+    if (input->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_base64_encode.\n");
         return NULL;
     }
+    String *encoded = ma_string_create("");
+    int val = 0, valb = -6;
+    size_t i;
 
-    strncpy(substr->dataStr, str->dataStr + pos, len); // Copy the substring
-    substr->dataStr[len] = '\0';  // Null terminate the substring
-
-    return substr;
-}
-
-bool ma_string_empty(String* str) {
-    return (str == NULL) ? true : (str->size == 0);
-}
+    for (i = 0; i < input->size; i++) {
+        unsigned char c = input->dataStr[i];
+        val = (val << 8) + c;
+        valb += 8;
 
-bool ma_string_contains(String* str, const char* substr) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_contains.\n");
-        return false;
+        while (valb >= 0) {
+            ma_string_push_back(encoded, base64_chars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
     }
-    if (substr == NULL) {
-        printf("Error: The substring is NULL in string_contains.\n");
-        return false;
+
+    if (valb > -6) {
+        ma_string_push_back(encoded, base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
     }
-    return strstr(str->dataStr, substr) != NULL;
-}
 
-int ma_string_compare(const String* str1, const String* str2) {
-    if (str1 == NULL || str2 == NULL) {
-        if (str1 == str2) {
-            return 0;  // Both are NULL, considered equal
-        }
-        printf("Error: One or both String objects are NULL in string_compare.\n");
-        return (str1 == NULL) ? -1 : 1;  // NULL is considered less than non-NULL
+    while (encoded->size % 4) {
+        ma_string_push_back(encoded, '=');
     }
-    return strcmp(str1->dataStr, str2->dataStr);
+    return encoded;
 }
 
-bool ma_string_is_equal(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) == 0;
-}
+String* ma_string_base64_decode(const String* encodedStr) {
+    if (encodedStr == NULL) {
+        printf("Error: encodedStr param is null in string_base64_decode\n");
+        return NULL;
+    }
 
-bool ma_string_is_less(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) < 0;
-}
+    if (encodedStr->dataStr == NULL) {
+        printf("Error: dataStr item of encodedStr object is null in string_base64_decode\n");
+        return NULL;
+    }
 
-bool ma_string_is_greater(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) > 0;
-}
+    char* decodedStr = (char*)ma_allocator_alloc(encodedStr->size * 3 / 4 + 1);
 
-bool ma_string_is_less_or_equal(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) <= 0;
-}
+    if (decodedStr == NULL) {
+        printf("Error: Failed to allocate memory for base64 decoding");
+        return NULL;
+    }
 
-bool ma_string_is_greater_or_equal(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) >= 0;
-}
+    int val = 0, valb = -8;
+    size_t i = 0;
+    size_t j = 0;
 
-bool ma_string_is_not_equal(String* str1, String* str2) {
-    return ma_string_compare(str1, str2) != 0;
-}
+    for (i = 0; i < encodedStr->size; i++) {
+        char c = encodedStr->dataStr[i];
+        if (c == '=')
+            break;
 
-bool ma_string_is_alpha(String* str) {
-    if (str != NULL){
-        for (size_t index = 0; index < str->size; index++){
-            if (!(str->dataStr[index] >= 'a' && str->dataStr[index] <= 'z') &&
-                !(str->dataStr[index] >= 'A' && str->dataStr[index] <= 'Z')) {
-                return false;
-            }
+        if (c >= 'A' && c <= 'Z') {
+            c -= 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            c = c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            c = c - '0' + 52;
+        } else if (c == '+') {
+            c = 62;
+        } else if (c == '/') {
+            c = 63;
+        } else {
+            continue;
         }
-        return true;
-    }
-
-    return false;
-}
 
-bool ma_string_is_digit(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_is_digit.\n");
-        return false;
-    }
+        val = (val << 6) | c;
+        valb += 6;
 
-    for (size_t index = 0; index < str->size; index++) {
-        if (!(str->dataStr[index] >= '0' && str->dataStr[index] <= '9')) {
-            return false;
+        if (valb >= 0) {
+            decodedStr[j++] = (char)((val >> valb) & 0xFF);
+            valb -= 8;
         }
     }
+    decodedStr[j] = '\0';
 
-    return true;
-}
+    String* decodedStringObject = ma_string_create_len(decodedStr, j);
+    ma_allocator_free(decodedStr);
 
-bool ma_string_is_upper(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_is_upper.\n");
-        return false;
-    }
-    for (size_t index = 0; index < str->size; index++) {
-        if (str->dataStr[index] >= 'a' && str->dataStr[index] <= 'z') {
-            return false;
-        }
-    }
-    return true;
+    return decodedStringObject;
 }
 
-bool ma_string_is_lower(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_is_lower.\n");
-        return false;
+// Formats into the storage of `str` after its first `offset` bytes. The text
+// is written into the spare capacity past the current contents, so arguments
+// pointing into the String stay valid, and then moved into place. Only when
+// that space is short is the text formatted a second time: into a stack
+// buffer for short results, or straight into one larger pool buffer that
+// replaces the current one afterwards.
+static void ma_string_vformat_at(String *str, size_t offset, const char *format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+    ma_string_invalidate_hash(str);
+
+    size_t start = str->size + 1;
+    size_t room = str->capacitySize - start;
+    int length = vsnprintf(str->dataStr + start, room, format, args);
+    if (length < 0) {
+        printf("Error: vsnprintf failed in string_format.\n");
+        va_end(retry);
+        return;
     }
-    for (size_t index = 0; index < str->size; index++) {
-        if (str->dataStr[index] >= 'A' && str->dataStr[index] <= 'Z') {
-            return false;
-        }
+
+    size_t newSize = offset + (size_t)length;
+    if ((size_t)length < room) {
+        memmove(str->dataStr + offset, str->dataStr + start, (size_t)length + 1);
+        str->size = newSize;
+        va_end(retry);
+        return;
     }
-    return true;
-}
 
-void ma_string_reverse(String* str) {
-    if (str != NULL && str->dataStr != NULL) {
-        char* reverse = (char*) malloc(sizeof(char) * (str->size + 1));
-        if (!reverse) {
-            printf("Error: Memory allocation failed in string_reverse.\n");
+    char local[256];
+    if ((size_t)length < sizeof(local)) {
+        vsnprintf(local, sizeof(local), format, retry);
+        va_end(retry);
+        if (!ma_string_grow(str, newSize + 1)) {
+            printf("Error: Memory allocation failed in string_format.\n");
             return;
         }
-
-        for (int index = str->size - 1, j = 0; index >= 0; index--, j++) {
-            reverse[j] = str->dataStr[index];
-        }
-        reverse[str->size] = '\0';
-        ma_string_replace(str, ma_string_c_str(str), reverse);
-
-        free(reverse);
+        memcpy(str->dataStr + offset, local, (size_t)length + 1);
+        str->size = newSize;
+        return;
     }
-    else {
-        printf("Error: The String object or its data is NULL in string_reverse.\n");
+
+    size_t capacity = ma_string_grow_capacity(str, newSize + 1);
+    MemoryPoolString *pool = ma_string_pool(str);
+    char *newData = ma_string_memory_pool_allocate(pool, capacity);
+    if (newData == NULL) {
+        printf("Error: Memory allocation failed in string_format.\n");
+        va_end(retry);
         return;
     }
+    vsnprintf(newData + offset, (size_t)length + 1, format, retry);
+    va_end(retry);
+
+    memcpy(newData, str->dataStr, offset);
+    ma_string_release_data(str, pool, str->dataStr, str->capacitySize);
+    str->dataStr = newData;
+    str->capacitySize = capacity;
+    str->size = newSize;
 }
 
-void ma_string_resize(String *str, size_t newSize) {
+void ma_string_vformat(String* str, const char* format, va_list args) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_resize.\n");
+        printf("Error: The String object is NULL in string_format.\n");
         return;
     }
-    if (newSize < str->size) {
-        str->size = newSize;
-        str->dataStr[newSize] = '\0';
-    }
-    else if (newSize > str->size) {
-        if (newSize >= str->capacitySize) {
-            size_t newCapacity = newSize + 1;
-            char *newData = ma_string_memory_pool_allocate(str->pool, newCapacity);
-
-            if (!newData) {
-                printf("Error: Memory allocation failed in string_resize.\n");
-                return;
-            }
-            memcpy(newData, str->dataStr, str->size);
-            str->dataStr = newData;
-            str->capacitySize = newCapacity;
-        }
-
-        memset(str->dataStr + str->size, '\0', newSize - str->size);
-        str->size = newSize;
+    if (format == NULL) {
+        printf("Error: The format string is NULL in string_format.\n");
+        return;
     }
+    ma_string_vformat_at(str, 0, format, args);
 }
 
-void ma_string_shrink_to_fit(String *str) {
+void ma_string_vformat_append(String* str, const char* format, va_list args) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_shrink_to_fit.\n");
+        printf("Error: The String object is NULL in string_format_append.\n");
         return;
     }
-    if (str->size + 1 == str->capacitySize) {
-        return; // No need to shrink if already at optimal size
+    if (format == NULL) {
+        printf("Error: The format string is NULL in string_format_append.\n");
+        return;
     }
-    // Check if the string is using the memory pool
-    if (str->dataStr != NULL) {
-        // Allocate new space from the memory pool
-        size_t newCapacity = str->size + 1; // +1 for null terminator
-        char *newData = ma_string_memory_pool_allocate(str->pool, newCapacity);
+    ma_string_vformat_at(str, str->size, format, args);
+}
 
-        if (newData == NULL) {
-            printf("Error: Memory allocation failed in string_shrink_to_fit.\n");
-            return;
-        }
-        // Copy existing data to the new space
-        memcpy(newData, str->dataStr, str->size);
-        newData[str->size] = '\0'; // Null-terminate the string
+void ma_string_format(String* str, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    ma_string_vformat(str, format, args);
+    va_end(args);
+}
 
-        // Update the string's metadata
-        str->dataStr = newData;
-        str->capacitySize = newCapacity;
-    }
+void ma_string_format_append(String* str, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    ma_string_vformat_append(str, format, args);
+    va_end(args);
 }
 
-void ma_string_append(String *str, const char *strItem) {
+String* ma_string_repeat(const String* str, size_t count) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_append.\n");
-        return;
+        printf("Error: The String object is NULL in string_repeat.\n");
+        return NULL;
     }
-    if (strItem == NULL) {
-        printf("Error: The strItem is NULL in string_append.\n");
-        return;
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_repeat.\n");
+        return NULL;
     }
-    size_t strItemLength = strlen(strItem);
-    if (strItemLength == 0) {
-        return;
+    if (str->size != 0 && count > (SIZE_MAX - 1) / str->size) {
+        printf("Error: The result is too large in string_repeat.\n");
+        return NULL;
     }
 
-    if (str->size + strItemLength >= str->capacitySize) {
-        size_t newCapacity = str->size + strItemLength + 1;
-        char *newData = ma_string_memory_pool_allocate(str->pool, newCapacity);
-
-        if (!newData) {
-            printf("Error: Memory allocation failed in string_append.\n");
-            return;
-        }
-
-        memcpy(newData, str->dataStr, str->size);
-        str->dataStr = newData;
-        str->capacitySize = newCapacity;
+    String* result = ma_string_create("");
+    if (result == NULL) {
+        return NULL;
     }
-
-    strcpy(str->dataStr + str->size, strItem);
-    str->size += strItemLength;
-}
-
-void ma_string_push_back(String* str, char chItem) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_push_back.\n");
-        return;
+    if (!ma_string_reserve(result, str->size * count + 1)) {
+        ma_string_deallocate(result);
+        return NULL;
+    }
+
+    // Writes the first copy and then doubles what is already there, so the
+    // result takes log2(count) copies straight into its own storage.
+    size_t newLength = str->size * count;
+    size_t filled = (count != 0) ? str->size : 0;
+    memcpy(result->dataStr, str->dataStr, filled);
+    while (filled < newLength) {
+        size_t chunk = (filled < newLength - filled) ? filled : newLength - filled;
+        memcpy(result->dataStr + filled, result->dataStr, chunk);
+        filled += chunk;
     }
-    if (str->size + 1 >= str->capacitySize) {
-        // static int counter = 0;
-        size_t newCapacity = str->capacitySize * 2;
-        char* newData = ma_string_memory_pool_allocate(str->pool, newCapacity);  // Allocate new space from the memory pool
+    result->dataStr[newLength] = '\0';
+    result->size = newLength;
 
-        if (!newData) {
-            printf("Error: Memory allocation failed in string_push_back.\n");
-            return;
-        }
+    return result;
+}
 
-        // Copy existing string to the new space
-        if (str->dataStr) {
-            memcpy(newData, str->dataStr, str->size);
-        }
-        str->dataStr = newData;
-        str->capacitySize = newCapacity;
+String* ma_string_join_variadic(size_t count, ...) {
+    va_list args;
+    va_start(args, count);
+
+    size_t totalLength = 0;
+    for (size_t i = 0; i < count; ++i) {
+        String* str = va_arg(args, String*);
+        totalLength += str->size;
     }
-    // Append the character
-    str->dataStr[str->size] = chItem;
-    str->size++;
-    str->dataStr[str->size] = '\0'; // Null-terminate the string
-}
+    va_end(args);
 
-void ma_string_assign(String *str, const char *newStr) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_assign.\n");
-        return;
+    String* result = ma_string_create("");
+    if (result == NULL) {
+        printf("Error: Memory allocation failed in string_join_variadic.\n");
+        return NULL;
     }
-    if (newStr == NULL) {
-        printf("Error: The newStr is NULL in string_assign.\n");
-        return;
+    if (!ma_string_reserve(result, totalLength + 1)) {
+        ma_string_deallocate(result);
+        return NULL;
     }
 
-    size_t newStrLength = strlen(newStr);
-    if (newStrLength + 1 > str->capacitySize) {
-        char *newData = ma_string_memory_pool_allocate(str->pool, newStrLength + 1);
-        if (!newData) {
-            printf("Error: Memory allocation failed in string_assign.\n");
-            return;
-        }
-
-
-        str->dataStr = newData;
-        str->capacitySize = newStrLength + 1;
+    va_start(args, count);
+    for (size_t i = 0; i < count; ++i) {
+        String* str = va_arg(args, String*);
+        ma_string_append_len(result, str->dataStr, str->size);
     }
+    va_end(args);
 
-    strcpy(str->dataStr, newStr);
-    str->size = newStrLength;
+    return result;
 }
 
-void ma_string_insert(String *str, size_t pos, const char *strItem) {
+void ma_string_trim_characters(String* str, const char* chars) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_insert.\n");
+        printf("Error: The String object is NULL in string_trim_characters.\n");
         return;
     }
-    if (strItem == NULL) {
-        printf("Error: The strItem is NULL in string_insert.\n");
+    ma_string_invalidate_hash(str);
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_trim_characters.\n");
         return;
     }
-    if (pos > str->size) {
-        printf("Error: Position out of bounds in string_insert.\n");
+    if (chars == NULL) {
+        printf("Error: The chars parameter is NULL in string_trim_characters.\n");
         return;
     }
+    char* start = str->dataStr;
+    char* end = str->dataStr + str->size - 1;
 
-    size_t strItemLength = strlen(strItem);
-    size_t newTotalLength = str->size + strItemLength;
-
-    if (newTotalLength + 1 > str->capacitySize) {
-        size_t newCapacity = newTotalLength + 1;
-        char *newData = ma_string_memory_pool_allocate(str->pool, newCapacity);
-        if (!newData) {
-            printf("Error: Memory allocation failed in string_insert.\n");
-            return;
-        }
-
-        memcpy(newData, str->dataStr, pos);
-        memcpy(newData + pos + strItemLength, str->dataStr + pos, str->size - pos);
-        str->dataStr = newData;
-        str->capacitySize = newCapacity;
+    while (start <= end && strchr(chars, *start)) {
+        start++;
     }
-    else {
-        memmove(str->dataStr + pos + strItemLength, str->dataStr + pos, str->size - pos);
+    while (end > start && strchr(chars, *end)) {
+        end--;
     }
+    size_t newLength = end - start + 1;
 
-    memcpy(str->dataStr + pos, strItem, strItemLength);
-    str->size = newTotalLength;
+    memmove(str->dataStr, start, newLength);
+    str->dataStr[newLength] = '\0';
+    str->size = newLength;
 }
 
-void ma_string_erase(String *str, size_t pos, size_t len) {
+void ma_string_shuffle(String* str){
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_erase.\n");
+        printf("Error: The String object is NULL in string_shuffle.\n");
         return;
     }
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_erase.\n");
+    ma_string_invalidate_hash(str);
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_shuffle.\n");
         return;
     }
-    if (pos + len > str->size) {
-        len = str->size - pos;  // Adjust len to not go beyond the string end
+
+    srand(time(NULL));
+    size_t length = str->size;
+    if (length < 2) {
+        return;
     }
+    for (size_t i = length - 1; i > 0; i--) {
+        size_t j = rand() % (i + 1);
 
-    memmove(str->dataStr + pos, str->dataStr + pos + len, str->size - pos - len + 1);
-    str->size -= len;
+        // Swap characters at positions i and j
+        char temp = str->dataStr[i];
+        str->dataStr[i] = str->dataStr[j];
+        str->dataStr[j] = temp;
+    }
 }
 
-void ma_string_replace(String *str1, const char *oldStr, const char *newStr) {
-    if (str1 == NULL) {
-        printf("Error: The String object (str1) is NULL in string_replace.\n");
-        return;
-    }
-    if (oldStr == NULL) {
-        printf("Error: The oldStr is NULL in string_replace.\n");
+void ma_string_to_title(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_to_title.\n");
         return;
     }
-    if (newStr == NULL) {
-        printf("Error: The newStr is NULL in string_replace.\n");
+    ma_string_invalidate_hash(str);
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_to_title.\n");
         return;
     }
 
-    char *position = strstr(str1->dataStr, oldStr);
-    if (position == NULL) {
-        printf("Warning: oldStr not found in str1 in string_replace.\n");
-        return;  // oldStr not found in str1
-    }
-
-    size_t oldLen = strlen(oldStr);
-    size_t newLen = strlen(newStr);
-    size_t tailLen = strlen(position + oldLen);
-    size_t newSize = (position - str1->dataStr) + newLen + tailLen;
-
-    if (newSize + 1 > str1->capacitySize) {
-        size_t newCapacity = newSize + 1;
-        char *newData = ma_string_memory_pool_allocate(str1->pool, newCapacity);
-        if (!newData) {
-            return;  // Handle allocation error
+    bool capitalize = true;
+    for (size_t i = 0; i < str->size; i++) {
+        if (capitalize && isalpha(str->dataStr[i])) {
+            str->dataStr[i] = toupper(str->dataStr[i]);
+            capitalize = false;
+        }
+        else if (!isalpha(str->dataStr[i])) {
+            capitalize = true;
+        }
+        else {
+            str->dataStr[i] = tolower(str->dataStr[i]);
         }
-
-        memcpy(newData, str1->dataStr, position - str1->dataStr);
-        memcpy(newData + (position - str1->dataStr) + newLen, position + oldLen, tailLen);
-        str1->dataStr = newData;
-        str1->capacitySize = newCapacity;
-    }
-    else {
-        memmove(position + newLen, position + oldLen, tailLen);
     }
-    memcpy(position, newStr, newLen);
-    str1->size = newSize;
 }
 
-void ma_string_swap(String *str1, String *str2) {
-    if (str1 == NULL || str2 == NULL) {
-        printf("Error: One or both String objects are NULL in string_swap.\n");
+void ma_string_to_capitalize(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_to_capitalize.\n");
         return;
     }
-
-    String temp = *str1;
-    *str1 = *str2;
-    *str2 = temp;
-}
-
-void ma_string_pop_back(String *str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_pop_back.\n");
+    ma_string_invalidate_hash(str);
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_to_capitalize.\n");
         return;
     }
-
     if (str->size == 0) {
-        printf("Warning: Attempt to pop back from an empty string in string_pop_back.\n");
+        printf("Error: The size of String object is zero in string_to_capitalize.\n");
         return;
     }
-
-    str->dataStr[str->size - 1] = '\0';
-    str->size--;
+    str->dataStr[0] = toupper(str->dataStr[0]);
 }
 
-void ma_string_deallocate(String *str) {
-    if (str == NULL) {
-        printf("Warning: Attempt to deallocate a NULL String object in string_deallocate.\n");
+void ma_string_to_casefold(String* str) {
+     if (str == NULL || str->dataStr == NULL) {
+        printf("Error: Invalid string input in string_to_casefold.\n");
         return;
     }
-    // Destroy the memory pool associated with the string
-    if (str->pool != NULL) {
-        ma_string_memory_pool_destroy(str->pool);
-        str->pool = NULL;
-    }
-    // Since dataStr is managed by the memory pool, no separate free call is needed for it
-    free(str);
-    if (memoryPoolCreated) {
-        ma_string_destroy_global_memory_pool();
-    }
+    ma_string_invalidate_hash(str);
+    ma_string_case_map(str->dataStr, str->dataStr, str->size, STRING_CASE_LOWER);
 }
 
-char ma_string_at(String* str, size_t index) {
+bool ma_string_starts_with(const String* str, const char* substr) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_at.\n");
-        return '\0';  // Return a default character
+        printf("Error: The String object is NULL in string_starts_with.\n");
+        return false;
     }
-
-    if (index >= str->size) {
-        printf("Error: Index out of range in string_at.\n");
-        return '\0';  // Return a default character
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_starts_with.\n");
+        return false;
     }
-
-    return str->dataStr[index]; // (const char)
-}
-
-char* ma_string_back(String *str) {
-    if (str == NULL || str->size == 0) {
-        return NULL;
+    if (substr == NULL) {
+        printf("Error: The substring is NULL in string_starts_with.\n");
+        return false;
     }
 
-    return &str->dataStr[str->size - 1];
-}
-
-char* ma_string_front(String *str) {
-    if (str == NULL || str->size == 0) {
-        return NULL;
+    size_t substrLen = strlen(substr);
+    if (substrLen > str->size) {
+        return false;
     }
-
-    return &str->dataStr[0];
+    return strncmp(str->dataStr, substr, substrLen) == 0;
 }
 
-size_t ma_string_length(String* str) {
+bool ma_string_ends_with(const String* str, const char* substr) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_length.\n");
-        return 0;
+        printf("Error: The String object is NULL in string_ends_with.\n");
+        return false;
+    }
+    if (str->dataStr == NULL) {
+        printf("Error: The dataStr of String object is NULL in string_ends_with.\n");
+        return false;
+    }
+    if (substr == NULL) {
+        printf("Error: The substring is NULL in string_ends_with.\n");
+        return false;
     }
 
-    return str->size;
-}
-
-size_t ma_string_capacity(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_capacity.\n");
-        return 0;
+    size_t substrLen = strlen(substr);
+    size_t strLen = str->size;
+    if (substrLen > strLen) {
+        return false;
     }
 
-    return str->capacitySize;
+    return strncmp(str->dataStr + strLen - substrLen, substr, substrLen) == 0;
 }
 
-size_t ma_string_max_size(String* str) {
+void ma_string_swap_case(String* str) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_max_size.\n");
-        return 0;  // Or a special value indicating error
+        printf("Error: str is NULL in string_swap_case\n");
+        return;
+    }
+    ma_string_invalidate_hash(str);
+    if (str->dataStr == NULL) {
+        printf("Error: str->dataStr is NULL in string_swap_case\n");
+        return;
     }
 
-    return (size_t)-1;  // You may want to define a more realistic maximum size
+    ma_string_case_map(str->dataStr, str->dataStr, str->size, STRING_CASE_SWAP);
 }
 
-
-size_t ma_string_copy(String *str, char *buffer, size_t pos, size_t len) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_copy.\n");
-        return 0;
-    }
-
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_copy.\n");
-        return 0;
+wchar_t* ma_string_to_unicode(const char* str) {
+    if (str == NULL) {
+        printf("Error: Input string is NULL in string_to_unicode.\n");
+        return NULL;
     }
-
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_copy.\n");
-        return 0;
+    // Calculate the length of the wide string
+    size_t len = mbstowcs(NULL, str, 0) + 1;
+    if (len == (size_t)-1) {
+        printf("Error: Conversion failed in string_to_unicode.\n");
+        return NULL;
     }
-
-    size_t copyLen = len;
-    if (pos + len > str->size || len == 0) {
-        copyLen = str->size - pos;  // Adjust copy length if it goes beyond the string end
+    wchar_t* wstr = ma_allocator_alloc(len * sizeof(wchar_t));
+    if (!wstr) {
+        printf("Error: Memory allocation failed in string_to_unicode.\n");
+        return NULL;
     }
 
-    strncpy(buffer, str->dataStr + pos, copyLen);
-    buffer[copyLen] = '\0';
-
-    return copyLen;  // Return the number of characters copied
+    mbstowcs(wstr, str, len);
+    return wstr;
 }
 
-int ma_string_find(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_find.\n");
-        return -1;
+String* ma_string_from_unicode(const wchar_t* wstr) {
+    if (wstr == NULL) {
+        printf("Error: Input wide string is NULL in string_from_unicode.\n");
+        return NULL;
     }
-
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_find.\n");
-        return -1;
+    // Calculate the length of the string
+    size_t len = wcstombs(NULL, wstr, 0);
+    if (len == (size_t)-1) {
+        printf("Error: Conversion failed in string_from_unicode.\n");
+        return NULL;
     }
 
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_find.\n");
-        return -1;
+    char* str = ma_allocator_alloc(len + 1); // +1 for null terminator
+    if (!str) {
+        printf("Error: Memory allocation failed in string_from_unicode.\n");
+        return NULL;
     }
+    wcstombs(str, wstr, len + 1); // Convert and include the null terminator
 
-    const char *found = strstr(str->dataStr + pos, buffer);
-    if (found == NULL) {
-        return -1;  // Substring not found
-    }
+    String* stringObj = ma_string_create(str);
+    ma_allocator_free(str); // Free the temporary char* buffer
 
-    return (int)(found - str->dataStr);  // Return the position of the substring
+    return stringObj;
 }
 
-int ma_string_rfind(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_rfind.\n");
-        return -1;
+String** ma_string_create_from_initializer(size_t count, ...) {
+    if (count == 0) {
+        printf("Error: count is zero in string_create_from_initializer.\n");
+        return NULL;
     }
 
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_rfind.\n");
-        return -1;
-    }
+    va_list args;
+    va_start(args, count);
 
-    size_t bufferLen = strlen(buffer);
-    if (bufferLen == 0) {
-        printf("Error: The buffer is empty in string_rfind.\n");
-        return -1;
+    // Allocate memory for the array of String pointers
+    String** strings = (String**)ma_allocator_alloc(sizeof(String*) * (count + 1)); // +1 for NULL termination
+    if (!strings) {
+        printf("Error: Memory allocation failed for strings array in string_create_from_initializer.\n");
+        va_end(args);
+        return NULL;
     }
 
-    if (pos < bufferLen - 1) {
-        printf("Error: Position is too small in string_rfind.\n");
-        return -1;
-    }
+    // Create each string and add it to the array
+    for (size_t i = 0; i < count; i++) {
+        char* str = va_arg(args, char*);
+        strings[i] = ma_string_create(str);
+        if (!strings[i]) {
+            printf("Error: string_create failed for string: %s in string_create_from_initializer.\n", str);
 
-    pos = (pos < str->size) ? pos : str->size - 1;  // Adjust pos to be within bounds
-    for (int i = (int)pos; i >= 0; --i) {
-        if (strncmp(str->dataStr + i, buffer, bufferLen) == 0) {
-            return i;  // Found the substring
+            // Handle allocation failure: cleanup and exit
+            for (size_t j = 0; j < i; j++) {
+                ma_string_deallocate(strings[j]);
+            }
+            ma_allocator_free(strings);
+            va_end(args);
+            return NULL;
         }
     }
 
-    return -1;  // Substring not found
+    // Null-terminate the array
+    strings[count] = NULL;
+
+    va_end(args);
+    return strings;
 }
 
-int ma_string_find_first_of(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_find_first_of.\n");
-        return -1;
+char* ma_string_strdup(const char* s)
+{
+    if (s == NULL) {
+        printf("Error: Parameter 's' is NULL in string_strdup.\n");
+        return NULL;
     }
 
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_find_first_of.\n");
-        return -1;
+    char* new_str = ma_allocator_alloc(strlen(s) + 1);
+    if (new_str == NULL) {
+        printf("Error: Memory allocation failed in string_strdup for string: %s\n", s);
+        return NULL;
     }
+    strcpy(new_str, s);
 
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_find_first_of.\n");
-        return -1;
-    }
+    return new_str;
+}
 
-    const char *found = strstr(str->dataStr + pos, buffer);
-    if (found != NULL) {
-        return (int)(found - str->dataStr);
+size_t ma_string_length_cstr(const char* str) {
+    if (!str) {
+        printf("Error: str is null in string_length_cstr.\n");
+        return 0;
     }
-
-    return -1;  // Buffer string not found
+    return (size_t)strlen(str);
 }
 
-int ma_string_find_last_of(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_find_last_of.\n");
-        return -1;
+size_t ma_string_length_utf8(const char* str) {
+    if (!str) {
+        printf("Error: str is null in string_length_cstr.\n");
+        return 0;
     }
+    size_t length = 0;
 
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_find_last_of.\n");
-        return -1;
+    while (*str) {
+        if ((*str & 0xC0) != 0x80) {
+            length++;
+        }
+        str++;
     }
+    return length;
+}
 
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_find_last_of.\n");
-        return -1;
+bool ma_string_to_bool_from_cstr(const char* boolstr) {
+    if (!boolstr) {
+        printf("Error: bool str is NULL and invalid in string_to_bool_cstr.\n");
+        return false;
     }
 
-    int lastFound = -1;
-    const char *currentFound = strstr(str->dataStr, buffer);
-
-    while (currentFound != NULL && (size_t)(currentFound - str->dataStr) <= pos) {
-        lastFound = (int)(currentFound - str->dataStr);
-        currentFound = strstr(currentFound + 1, buffer);
+    if (strcmp(boolstr, "true") == 0) {
+        return true;
+    } else if (strcmp(boolstr, "false") == 0) {
+        return false;
     }
 
-    return lastFound;
+    return false;
 }
 
-int ma_string_find_first_not_of(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_find_first_not_of.\n");
-        return -1;
+size_t ma_string_utf8_char_len(char c) {
+    if ((c & 0x80) == 0) {
+        return 1;
     }
 
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_find_first_not_of.\n");
-        return -1;
+    if ((c & 0xE0) == 0xC0) {
+        return 2;
     }
 
-    if (pos >= str->size) {
-        printf("Error: Position out of bounds in string_find_first_not_of.\n");
-        return -1;
+    if ((c & 0xF0) == 0xE0) {
+        return 3;
     }
 
-    size_t bufferLen = strlen(buffer);
-    if (bufferLen == 0) {
-        return (int)pos;  // If buffer is empty, return pos
+    if ((c & 0xF8) == 0xF0) {
+        return 4;
     }
 
-    for (size_t i = pos; i <= str->size - bufferLen; ++i) {
-        if (strncmp(str->dataStr + i, buffer, bufferLen) != 0) {
-            return (int)i;
-        }
-    }
-    return -1;  // No non-matching position found
+    return 0;
 }
 
-int ma_string_find_last_not_of(String *str, const char *buffer, size_t pos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: The String object or its data is NULL in string_find_last_not_of.\n");
-        return -1;
-    }
-
-    if (buffer == NULL) {
-        printf("Error: The buffer is NULL in string_find_last_not_of.\n");
-        return -1;
-    }
+// ------------------------------------------------------------------------- //
+//                            String view                                    //
+// ------------------------------------------------------------------------- //
 
-    size_t bufferLen = strlen(buffer);
-    if (bufferLen == 0) {
-        printf("Error: The buffer is empty in string_find_last_not_of.\n");
-        return -1;
-    }
-    if (pos < bufferLen - 1) {
-        printf("Error: Position is too small in string_find_last_not_of.\n");
-        return -1;
-    }
+StringView ma_string_view_create(const char* str) {
+    StringView view = {str, str ? strlen(str) : 0};
+    return view;
+}
 
-    pos = (pos < str->size - bufferLen) ? pos : str->size - bufferLen;
-    for (int i = (int)pos; i >= 0; --i) {
-        if (strncmp(str->dataStr + i, buffer, bufferLen) != 0) {
-            return i;
-        }
-    }
-    return -1;
+StringView ma_string_view_from_buffer(const char* data, size_t size) {
+    StringView view = {data, data ? size : 0};
+    return view;
 }
 
-const char* ma_string_data(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_data function.\n");
-        return NULL;
+StringView ma_string_view_from_string(const String* str) {
+    StringView view = {NULL, 0};
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_view_from_string.\n");
+        return view;
     }
 
-    return str->dataStr;
+    view.data = str->dataStr;
+    view.size = str->size;
+    return view;
 }
 
-const char* ma_string_c_str(const String *str) {
-    if (str == NULL) {
-        printf("Error: Invalid input in string_c_str function.\n");
-        return "";  // Return empty string for null String
+// Positions past the end give an empty view, lengths past the end are clamped.
+StringView ma_string_view_substr(StringView view, size_t pos, size_t len) {
+    if (pos > view.size) {
+        pos = view.size;
     }
-
-    if (str->dataStr == NULL) {
-        printf("Error: Uninitialized String in string_c_str function.\n");
-        return "";  // Return empty string for uninitialized String
+    if (len > view.size - pos) {
+        len = view.size - pos;
     }
 
-    return str->dataStr;
+    StringView result = {view.data + pos, len};
+    return result;
 }
 
-char* ma_string_begin(String *str) {
-    if (str == NULL) {
-        printf("Error: Invalid input in string_begin function.\n");
-        return "";  // Return empty string for null String
+StringView ma_string_view_trim_left(StringView view) {
+    while (view.size > 0 && isspace((unsigned char)view.data[0])) {
+        view.data++;
+        view.size--;
     }
+    return view;
+}
 
-    if (str->dataStr == NULL) {
-        printf("Error: Uninitialized String in string_begin function.\n");
-        return "";  // Return empty string for uninitialized String
+StringView ma_string_view_trim_right(StringView view) {
+    while (view.size > 0 && isspace((unsigned char)view.data[view.size - 1])) {
+        view.size--;
     }
+    return view;
+}
+
+StringView ma_string_view_trim(StringView view) {
+    return ma_string_view_trim_right(ma_string_view_trim_left(view));
+}
+
+bool ma_string_view_starts_with(StringView view, StringView prefix) {
+    return prefix.size <= view.size && (prefix.size == 0 || memcmp(view.data, prefix.data, prefix.size) == 0);
+}
 
-    return str->dataStr;  // The beginning of the string
+bool ma_string_view_ends_with(StringView view, StringView suffix) {
+    return suffix.size <= view.size && (suffix.size == 0 || memcmp(view.data + view.size - suffix.size, suffix.data, suffix.size) == 0);
 }
 
-char* ma_string_end(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_end function.\n");
-        return NULL;  // Return NULL for null or uninitialized String
+size_t ma_string_view_find(StringView view, StringView needle, size_t pos) {
+    if (pos > view.size || (view.data == NULL && needle.size != 0)) {
+        return MA_STRING_VIEW_NPOS;
     }
 
-    return str->dataStr + str->size;  // The end of the string
+    const char *found = ma_string_search(view.data + pos, view.size - pos, needle.data, needle.size);
+    return found ? (size_t)(found - view.data) : MA_STRING_VIEW_NPOS;
 }
 
-char* ma_string_rbegin(String *str) {
-    if (str == NULL || str->dataStr == NULL || str->size == 0) {
-        printf("Error: Invalid input, uninitialized, or empty String in string_rbegin function.\n");
-        return NULL;
+int ma_string_view_compare(StringView view1, StringView view2) {
+    size_t common = (view1.size < view2.size) ? view1.size : view2.size;
+    int result = (common == 0) ? 0 : memcmp(view1.data, view2.data, common);
+    if (result != 0) {
+        return result;
     }
-
-    return str->dataStr + str->size - 1;
+    return (view1.size > view2.size) - (view1.size < view2.size);
 }
 
-char* ma_string_rend(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_rend function.\n");
-        return NULL;
+int ma_string_view_compare_ignore_case(StringView view1, StringView view2) {
+    size_t common = (view1.size < view2.size) ? view1.size : view2.size;
+    int result = (common == 0) ? 0 : ma_string_compare_folded(view1.data, view2.data, common);
+    if (result != 0) {
+        return result;
     }
+    return (view1.size > view2.size) - (view1.size < view2.size);
+}
 
-    return str->dataStr - 1;
+bool ma_string_view_is_equal(StringView view1, StringView view2) {
+    return view1.size == view2.size && ma_string_view_compare(view1, view2) == 0;
 }
 
-const char* ma_string_cbegin(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_cbegin function.\n");
-        return NULL;  // Return NULL for null or uninitialized String
+String* ma_string_view_to_string(StringView view) {
+    return ma_string_create_len(view.data, view.size);
+}
+
+// ------------------------------------------------------------------------- //
+//                          String split iterator                            //
+// ------------------------------------------------------------------------- //
+
+void ma_string_split_iterator_init(StringSplitIterator* it, const char* data, size_t size, const char* delimiter, size_t delimiterLength, StringSplitMode mode) {
+    if (it == NULL) {
+        printf("Error: The iterator is NULL in string_split_iterator_init.\n");
+        return;
     }
 
-    return str->dataStr;  // The beginning of the string
+    memset(it, 0, sizeof(StringSplitIterator));
+    it->data = data;
+    it->size = data ? size : 0;
+    it->delimiter = delimiter;
+    it->delimiterLength = delimiter ? delimiterLength : 0;
+    it->mode = mode;
+
+    if (mode == STRING_SPLIT_CHAR && it->delimiterLength > 1) {
+        it->delimiterLength = 1; // Only the first byte delimits
+    }
+    if (mode == STRING_SPLIT_ANY_OF) {
+        for (size_t i = 0; i < it->delimiterLength; i++) {
+            unsigned char c = (unsigned char)delimiter[i];
+            it->delimiterSet[c >> 3] |= (uint8_t)(1u << (c & 7));
+        }
+    }
 }
 
-const char* ma_string_cend(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_cend function.\n");
-        return NULL;  // Return NULL for null or uninitialized String
+void ma_string_split_iterator_init_string(StringSplitIterator* it, const String* str, const char* delimiter, StringSplitMode mode) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_split_iterator_init_string.\n");
+        ma_string_split_iterator_init(it, NULL, 0, NULL, 0, mode);
+        if (it) {
+            it->done = true;
+        }
+        return;
     }
+    ma_string_split_iterator_init(it, str->dataStr, str->size, delimiter, delimiter ? strlen(delimiter) : 0, mode);
+}
 
-    return str->dataStr + str->size;  // The end of the string
+// Offset of the next delimiter at or after `pos`, `it->size` when there is none.
+static size_t ma_string_split_find_delimiter(const StringSplitIterator* it, size_t pos) {
+    const char *start = it->data + pos;
+    size_t remaining = it->size - pos;
+    const char *found = NULL;
+
+    switch (it->mode) {
+        case STRING_SPLIT_CHAR:
+            found = memchr(start, it->delimiter[0], remaining);
+            break;
+        case STRING_SPLIT_SEQUENCE:
+            found = ma_string_search(start, remaining, it->delimiter, it->delimiterLength);
+            break;
+        case STRING_SPLIT_ANY_OF:
+            if (it->delimiterLength == 1) {
+                found = memchr(start, it->delimiter[0], remaining);
+                break;
+            }
+            for (size_t i = 0; i < remaining; i++) {
+                unsigned char c = (unsigned char)start[i];
+                if (it->delimiterSet[c >> 3] & (1u << (c & 7))) {
+                    found = start + i;
+                    break;
+                }
+            }
+            break;
+    }
+
+    return found ? (size_t)(found - it->data) : it->size;
 }
 
-const char* ma_string_crbegin(String *str) {
-    if (str == NULL || str->dataStr == NULL || str->size == 0) {
-        printf("Error: Invalid input, uninitialized, or empty String in string_crbegin function.\n");
-        return NULL;  // Return NULL for null, uninitialized, or empty String
+// Every delimiter ends a field, so empty fields are reported and an input of
+// n delimiters always yields n + 1 fields.
+bool ma_string_split_next(StringSplitIterator* it, size_t* offset, size_t* length) {
+    if (it == NULL || it->done) {
+        return false;
     }
 
-    return str->dataStr + str->size - 1;  // Pointer to the last character
+    size_t end = (it->delimiterLength == 0) ? it->size : ma_string_split_find_delimiter(it, it->pos);
+    if (offset) {
+        *offset = it->pos;
+    }
+    if (length) {
+        *length = end - it->pos;
+    }
+
+    if (end == it->size) {
+        it->done = true;
+    }
+    else {
+        it->pos = end + ((it->mode == STRING_SPLIT_SEQUENCE) ? it->delimiterLength : 1);
+    }
+    return true;
 }
 
-const char* ma_string_crend(String *str) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid input or uninitialized String in string_crend function.\n");
-        return NULL;  // Return NULL for null or uninitialized String
+bool ma_string_split_next_view(StringSplitIterator* it, StringView* field) {
+    size_t offset = 0;
+    size_t length = 0;
+    if (!ma_string_split_next(it, &offset, &length)) {
+        return false;
     }
 
-    return str->dataStr - 1;  // Pointer to one before the first character
+    if (field) {
+        field->data = it->data + offset;
+        field->size = length;
+    }
+    return true;
 }
 
-void ma_string_clear(String* str) {
-    if (str != NULL) {
-        str->size = 0;  // Reset the size to 0, indicating the string is now empty
+// ------------------------------------------------------------------------- //
+//                            String matcher                                 //
+// ------------------------------------------------------------------------- //
 
-        // Set the first character to the null terminator.
-        // This ensures that the string is considered empty when accessed.
-        if (str->dataStr != NULL) {
-            str->dataStr[0] = '\0';
-        }
+StringMatcher* ma_string_matcher_create(const char** patterns, size_t count) {
+    if (patterns == NULL || count == 0) {
+        printf("Error: No patterns given in string_matcher_create.\n");
+        return NULL;
     }
-    printf("Info : String object is null no need to clear in string_clear.\n");
+
+    size_t *lengths = ma_allocator_alloc(count * sizeof(size_t));
+    if (lengths == NULL) {
+        printf("Error: Memory allocation failed in string_matcher_create.\n");
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = patterns[i] ? strlen(patterns[i]) : 0;
+    }
+
+    StringMatcher *matcher = ma_string_matcher_create_len(patterns, lengths, count);
+    ma_allocator_free(lengths);
+    return matcher;
 }
 
-char* string_to_upper(String* str) {
-    if (str != NULL) {
-        char* upper = (char*) malloc(sizeof(char) * (str->size + 1));
-        if (!upper) {
-            printf("Error: Failed to allocate memory for string_to_upper function.\n");
-            exit(-1);
-        }
+StringMatcher* ma_string_matcher_create_len(const char** patterns, const size_t* lengths, size_t count) {
+    if (patterns == NULL || lengths == NULL || count == 0) {
+        printf("Error: No patterns given in string_matcher_create.\n");
+        return NULL;
+    }
 
-        for (size_t index = 0; index < str->size; index++) {
-            if (isalpha(str->dataStr[index]) && (str->dataStr[index] >= 'a' && str->dataStr[index] <= 'z')) {
-                upper[index] = toupper(str->dataStr[index]);
-            }
-            else {
-                upper[index] = str->dataStr[index];
-            }
+    size_t maxStates = 1;
+    for (size_t i = 0; i < count; i++) {
+        if (patterns[i] == NULL || lengths[i] == 0) {
+            printf("Error: Pattern %zu is NULL or empty in string_matcher_create.\n", i);
+            return NULL;
         }
-        upper[str->size] = '\0';
-        return upper;
+        maxStates += lengths[i];
+    }
+    if (maxStates > UINT32_MAX) {
+        printf("Error: The patterns are too long in string_matcher_create.\n");
+        return NULL;
     }
 
-    printf("Error: Input 'str' is NULL in string_to_upper function.\n");
-    return NULL;
-}
+    StringMatcher *matcher = ma_allocator_alloc(sizeof(StringMatcher));
+    if (matcher == NULL) {
+        printf("Error: Memory allocation failed in string_matcher_create.\n");
+        return NULL;
+    }
+    memset(matcher, 0, sizeof(StringMatcher));
+    matcher->patternCount = count;
 
-char* string_to_lower(String* str) {
-    if (str != NULL) {
-        char* lower = (char*) malloc(sizeof(char) * (str->size + 1));
-        if (!lower) {
-            printf("Error: Failed to allocate memory for string_to_lower function.\n");
-            exit(-1);
+    // Bytes that appear in no pattern all behave the same and share column 0.
+    matcher->classCount = 1;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < lengths[i]; j++) {
+            unsigned char c = (unsigned char)patterns[i][j];
+            if (matcher->classMap[c] == 0) {
+                matcher->classMap[c] = (uint16_t)matcher->classCount++;
+            }
         }
+    }
+
+    size_t classes = matcher->classCount;
+    matcher->transitions = ma_allocator_alloc(maxStates * classes * sizeof(uint32_t));
+    matcher->depth = ma_allocator_alloc(maxStates * sizeof(uint32_t));
+    matcher->output = ma_allocator_alloc(maxStates * sizeof(uint32_t));
+    matcher->patternLengths = ma_allocator_alloc(count * sizeof(size_t));
+    uint32_t *fail = ma_allocator_alloc(maxStates * sizeof(uint32_t));
+    uint32_t *queue = ma_allocator_alloc(maxStates * sizeof(uint32_t));
+    if (!matcher->transitions || !matcher->depth || !matcher->output || !matcher->patternLengths || !fail || !queue) {
+        printf("Error: Memory allocation failed in string_matcher_create.\n");
+        ma_allocator_free(fail);
+        ma_allocator_free(queue);
+        ma_string_matcher_destroy(matcher);
+        return NULL;
+    }
+    memset(matcher->transitions, 0, maxStates * classes * sizeof(uint32_t));
+    memcpy(matcher->patternLengths, lengths, count * sizeof(size_t));
 
-        for (size_t index = 0; index < str->size; index++) {
-            if (isalpha(str->dataStr[index]) && (str->dataStr[index] >= 'A' && str->dataStr[index] <= 'Z')) {
-                lower[index] = tolower(str->dataStr[index]);
+    // Trie of the patterns. State 0 is the root, which is never a child, so a
+    // zero transition means "no child" while the trie is built.
+    size_t stateCount = 1;
+    matcher->depth[0] = 0;
+    matcher->output[0] = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t state = 0;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            uint32_t *slot = &matcher->transitions[state * classes + matcher->classMap[(unsigned char)patterns[i][j]]];
+            if (*slot == 0) {
+                *slot = (uint32_t)stateCount;
+                matcher->depth[stateCount] = (uint32_t)(j + 1);
+                matcher->output[stateCount] = 0;
+                stateCount++;
             }
-            else {
-                lower[index] = str->dataStr[index];
+            state = *slot;
+        }
+        if (matcher->output[state] == 0) {
+            matcher->output[state] = (uint32_t)(i + 1); // The first of duplicate patterns wins
+        }
+    }
+
+    // Breadth-first pass turning the trie into a complete automaton: missing
+    // transitions follow the failure link, and states without a pattern of their
+    // own report the longest pattern ending at their failure state.
+    size_t head = 0;
+    size_t tail = 0;
+    fail[0] = 0;
+    queue[tail++] = 0;
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        uint32_t *row = &matcher->transitions[state * classes];
+        const uint32_t *failRow = &matcher->transitions[fail[state] * classes];
+        for (size_t c = 0; c < classes; c++) {
+            uint32_t child = row[c];
+            if (child == 0) {
+                row[c] = (state == 0) ? 0 : failRow[c];
+                continue;
+            }
+            fail[child] = (state == 0) ? 0 : failRow[c];
+            if (matcher->output[child] == 0) {
+                matcher->output[child] = matcher->output[fail[child]];
             }
+            queue[tail++] = child;
         }
-        lower[str->size] = '\0';
-        return lower;
     }
+    ma_allocator_free(fail);
+    ma_allocator_free(queue);
 
-    printf("Error: Input 'str' is NULL in string_to_lower function.\n");
-    return NULL;
+    matcher->stateCount = stateCount;
+    uint32_t *shrunk = ma_allocator_realloc(matcher->transitions, stateCount * classes * sizeof(uint32_t));
+    if (shrunk != NULL) {
+        matcher->transitions = shrunk;
+    }
+    return matcher;
 }
 
-bool ma_string_set_pool_size(String* str, size_t newSize) {
-    if (!str) {
-        printf("Error: Invalid input - 'str' is NULL in string_set_pool_size.\n");
-        return false;
+void ma_string_matcher_destroy(StringMatcher* matcher) {
+    if (matcher == NULL) {
+        return;
     }
+    ma_allocator_free(matcher->transitions);
+    ma_allocator_free(matcher->depth);
+    ma_allocator_free(matcher->output);
+    ma_allocator_free(matcher->patternLengths);
+    ma_allocator_free(matcher);
+}
 
-    if (newSize == 0) {
-        printf("Error: Invalid input - 'newSize' is zero in string_set_pool_size.\n");
+// Leftmost match at or after `pos`, the longest one when several patterns
+// start there. Scanning goes on past the first hit only while the automaton
+// still tracks a prefix starting at or before it.
+bool ma_string_matcher_find(const StringMatcher* matcher, const char* data, size_t size, size_t pos, StringMatch* match) {
+    if (matcher == NULL || (data == NULL && size != 0)) {
+        printf("Error: The matcher or the data is NULL in string_matcher_find.\n");
         return false;
     }
-    // If a memory pool already exists, destroy it first
-    if (str->pool) {
-        ma_string_memory_pool_destroy(str->pool);
-        str->pool = NULL;
-    }
 
-    // Create a new memory pool with the specified size
-    str->pool = ma_string_memory_pool_create(newSize);
-    if (!str->pool) {
-        printf("Error: Failed to create a new memory pool in string_set_pool_size.\n");
-        return false; // Return false if memory pool creation fails
-    }
-    // If the string already has data, reallocate it in the new pool
-    if (str->size > 0 && str->dataStr) {
-        char* newData = ma_string_memory_pool_allocate(str->pool, str->size + 1); // +1 for null terminator
-        if (!newData) {
-            printf("Error: Failed to allocate memory for string data in the new pool in string_set_pool_size.\n");
-            ma_string_memory_pool_destroy(str->pool);
-            str->pool = NULL;
-            return false; // Return false if allocation fails
+    const uint32_t *transitions = matcher->transitions;
+    size_t classes = matcher->classCount;
+    uint32_t state = 0;
+    bool found = false;
+    size_t bestStart = 0;
+    size_t bestLength = 0;
+    size_t bestPattern = 0;
+
+    for (size_t i = pos; i < size; i++) {
+        state = transitions[state * classes + matcher->classMap[(unsigned char)data[i]]];
+        size_t stateStart = i + 1 - matcher->depth[state];
+        if (found && stateStart > bestStart) {
+            break;
+        }
+
+        uint32_t output = matcher->output[state];
+        if (output != 0) {
+            size_t length = matcher->patternLengths[output - 1];
+            size_t start = i + 1 - length;
+            if (!found || start < bestStart || (start == bestStart && length > bestLength)) {
+                found = true;
+                bestStart = start;
+                bestLength = length;
+                bestPattern = output - 1;
+            }
         }
-        memcpy(newData, str->dataStr, str->size);
-        newData[str->size] = '\0';
-        str->dataStr = newData;
     }
-    return true; // Return true on successful pool resize
-}
 
-void ma_string_concatenate(String *str1, const String *str2) {
-    if (str1 == NULL) {
-        printf("Error: Null String object 'str1' in string_concatenate.\n");
-        return;
+    if (found && match) {
+        match->offset = bestStart;
+        match->length = bestLength;
+        match->pattern = bestPattern;
     }
+    return found;
+}
 
-    if (str2 == NULL) {
-        printf("Error: Null String object 'str2' in string_concatenate.\n");
-        return;
+size_t ma_string_matcher_count(const StringMatcher* matcher, const char* data, size_t size) {
+    StringMatch match;
+    size_t count = 0;
+    for (size_t pos = 0; ma_string_matcher_find(matcher, data, size, pos, &match); pos = match.offset + match.length) {
+        count++;
     }
-    ma_string_append(str1, str2->dataStr);
+    return count;
 }
 
-void ma_string_trim_left(String *str) {
+bool ma_string_matcher_find_string(const StringMatcher* matcher, const String* str, size_t pos, StringMatch* match) {
     if (str == NULL) {
-        printf("Error: Null String object in string_trim_left.\n");
-        return;
-    }
-    if (str->size == 0) {
-        return;
+        printf("Error: The String object is NULL in string_matcher_find_string.\n");
+        return false;
     }
+    return ma_string_matcher_find(matcher, str->dataStr, str->size, pos, match);
+}
 
-    size_t i = 0;
-    while (i < str->size && isspace((unsigned char)str->dataStr[i])) {
-        i++;
+size_t ma_string_matcher_count_string(const StringMatcher* matcher, const String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_matcher_count_string.\n");
+        return 0;
     }
+    return ma_string_matcher_count(matcher, str->dataStr, str->size);
+}
 
-    if (i > 0) {
-        memmove(str->dataStr, str->dataStr + i, str->size - i);
-        str->size -= i;
-        str->dataStr[str->size] = '\0';
+typedef struct StringMatcherRewrite {
+    const StringMatcher *matcher;
+    const char **replacements;
+    const size_t *lengths;
+} StringMatcherRewrite;
+
+static bool ma_string_matcher_rewrite_next(const void *context, const char *data, size_t size, size_t pos, size_t *offset, size_t *length, const char **replacement, size_t *replacementLength) {
+    const StringMatcherRewrite *rewrite = context;
+    StringMatch match;
+    if (!ma_string_matcher_find(rewrite->matcher, data, size, pos, &match)) {
+        return false;
     }
+    *offset = match.offset;
+    *length = match.length;
+    *replacement = rewrite->replacements[match.pattern];
+    *replacementLength = rewrite->lengths[match.pattern];
+    return true;
 }
 
-void ma_string_trim_right(String *str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_trim_right.\n");
-        return;
+size_t ma_string_matcher_replace(const StringMatcher* matcher, String* str, const char** replacements) {
+    if (matcher == NULL || replacements == NULL) {
+        printf("Error: The matcher or the replacements are NULL in string_matcher_replace.\n");
+        return 0;
     }
-    if (str->size == 0) {
-        return;
+
+    size_t *lengths = ma_allocator_alloc(matcher->patternCount * sizeof(size_t));
+    if (lengths == NULL) {
+        printf("Error: Memory allocation failed in string_matcher_replace.\n");
+        return 0;
+    }
+    for (size_t i = 0; i < matcher->patternCount; i++) {
+        lengths[i] = replacements[i] ? strlen(replacements[i]) : 0;
     }
 
-    size_t i = str->size;
-    while (i > 0 && isspace((unsigned char)str->dataStr[i - 1])) {
-        i--;
+    size_t count = ma_string_matcher_replace_len(matcher, str, replacements, lengths);
+    ma_allocator_free(lengths);
+    return count;
+}
+
+size_t ma_string_matcher_replace_len(const StringMatcher* matcher, String* str, const char** replacements, const size_t* lengths) {
+    if (matcher == NULL || str == NULL || replacements == NULL || lengths == NULL) {
+        printf("Error: NULL argument in string_matcher_replace.\n");
+        return 0;
     }
 
-    if (i < str->size) {
-        str->dataStr[i] = '\0';
-        str->size = i;
+    bool shrinking = true;
+    for (size_t i = 0; i < matcher->patternCount; i++) {
+        if (replacements[i] == NULL && lengths[i] != 0) {
+            printf("Error: Replacement %zu is NULL in string_matcher_replace.\n", i);
+            return 0;
+        }
+        shrinking = shrinking && lengths[i] <= matcher->patternLengths[i];
     }
+
+    StringMatcherRewrite rewrite = { matcher, replacements, lengths };
+    return ma_string_rewrite(str, ma_string_matcher_rewrite_next, &rewrite, shrinking);
 }
 
-void ma_string_trim(String *str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_trim.\n");
-        return;
-    }
+// ------------------------------------------------------------------------- //
+//                          String number parsing                            //
+// ------------------------------------------------------------------------- //
 
-    ma_string_trim_left(str);
-    ma_string_trim_right(str);
+// 128-bit approximations of 5^q for q in [MA_NUMBER_MIN_POWER_OF_TEN, MA_NUMBER_MAX_POWER_OF_TEN],
+// high word first, normalized so that the top bit is set. They are truncated,
+// except for q in [-27, -1] where they are rounded up, as the Eisel-Lemire
+// algorithm requires. The same normalized values serve as 10^q for formatting.
+#define MA_NUMBER_MIN_POWER_OF_TEN (-342)
+#define MA_NUMBER_MAX_POWER_OF_TEN 324
+
+static const uint64_t number_powers_of_five[] = {
+    0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL,
+    0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+    0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+    0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+    0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL,
+    0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+    0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL,
+    0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+    0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+    0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+    0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL,
+    0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+    0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL,
+    0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+    0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+    0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+    0x84a57695fe98746dULL, 0x014bb630f7604b57ULL,
+    0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+    0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL,
+    0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+    0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+    0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+    0xfd00b897478238d0ULL, 0x8920b098955522b4ULL,
+    0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+    0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL,
+    0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+    0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+    0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+    0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL,
+    0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+    0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL,
+    0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+    0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+    0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+    0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL,
+    0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+    0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL,
+    0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+    0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+    0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+    0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL,
+    0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+    0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL,
+    0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+    0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+    0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+    0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL,
+    0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+    0xa37fce126597973cULL, 0xe50ff107bab528a0ULL,
+    0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+    0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL,
+    0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL,
+    0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+    0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL,
+    0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL,
+    0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+    0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL,
+    0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL,
+    0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+    0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL,
+    0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL,
+    0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+    0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL,
+    0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL,
+    0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+    0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL,
+    0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL,
+    0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+    0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL,
+    0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL,
+    0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+    0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL,
+    0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL,
+    0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+    0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429603ULL,
+    0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL,
+    0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+    0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL,
+    0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL,
+    0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+    0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL,
+    0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL,
+    0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+    0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL,
+    0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e3fULL,
+    0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+    0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL,
+    0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL,
+    0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+    0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828bULL,
+    0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL,
+    0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+    0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8bULL,
+    0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL,
+    0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+    0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL,
+    0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL,
+    0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+    0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca109ULL,
+    0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL,
+    0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+    0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL,
+    0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL,
+    0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+    0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL,
+    0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL,
+    0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+    0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL,
+    0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL,
+    0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+    0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL,
+    0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL,
+    0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+    0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL,
+    0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL,
+    0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+    0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fbULL,
+    0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL,
+    0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+    0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL,
+    0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL,
+    0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+    0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL,
+    0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL,
+    0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+    0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL,
+    0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135823ULL,
+    0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+    0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL,
+    0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL,
+    0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+    0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL,
+    0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL,
+    0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+    0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL,
+    0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL,
+    0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+    0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL,
+    0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL,
+    0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+    0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL,
+    0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL,
+    0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+    0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL,
+    0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL,
+    0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+    0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL,
+    0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL,
+    0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+    0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL,
+    0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL,
+    0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+    0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL,
+    0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL,
+    0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+    0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+    0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL,
+    0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b68ULL,
+    0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+    0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL,
+    0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL,
+    0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+    0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL,
+    0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL,
+    0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+    0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+    0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+    0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+    0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL,
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL,
+    0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL,
+    0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL,
+    0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL,
+    0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+    0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL,
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL,
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+    0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL,
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+    0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+    0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+    0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+    0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+    0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+    0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+    0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+    0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+    0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+    0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL,
+    0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946590ULL,
+    0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+    0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL,
+    0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL,
+    0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+    0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL,
+    0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL,
+    0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+    0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL,
+    0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL,
+    0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+    0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL,
+    0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL,
+    0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+    0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL,
+    0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL,
+    0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+    0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL,
+    0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL,
+    0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+    0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c56ULL,
+    0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL,
+    0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+    0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL,
+    0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL,
+    0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+    0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL,
+    0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL,
+    0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+    0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL,
+    0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL,
+    0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+    0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL,
+    0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL,
+    0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+    0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL,
+    0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL,
+    0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+    0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL,
+    0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL,
+    0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+    0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL,
+    0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL,
+    0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+    0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+    0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL,
+    0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efbULL,
+    0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+    0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL,
+    0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL,
+    0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+    0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL,
+    0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL,
+    0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+    0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL,
+    0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL,
+    0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+    0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699095ULL,
+    0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL,
+    0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+    0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL,
+    0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL,
+    0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+    0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL,
+    0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL,
+    0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+    0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bcULL,
+    0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL,
+    0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+    0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL,
+    0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL,
+    0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+    0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173473ULL,
+    0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL,
+    0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+    0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL,
+    0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL,
+    0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+    0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL,
+    0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL,
+    0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+    0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL,
+    0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL,
+    0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+    0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL,
+    0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL,
+    0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+    0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL,
+    0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL,
+    0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+    0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL,
+    0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL,
+    0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+    0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL,
+    0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL,
+    0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+    0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL,
+    0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL,
+    0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+    0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL,
+    0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+    0x8533285c936b35deULL, 0xd53a88958f87275fULL,
+    0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+    0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL,
+    0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL,
+    0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+    0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL,
+    0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL,
+    0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+    0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL,
+    0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL,
+    0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+    0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL,
+    0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL,
+    0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+    0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL,
+    0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL,
+    0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+    0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL,
+    0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL,
+    0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+    0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL,
+    0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL,
+    0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+    0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL,
+    0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL,
+    0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+    0xb201833b35d63f73ULL, 0x2cd2cc6551e513daULL,
+    0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d1ULL,
+    0x8b112e86420f6191ULL, 0xfb04afaf27faf782ULL,
+    0xadd57a27d29339f6ULL, 0x79c5db9af1f9b563ULL,
+    0xd94ad8b1c7380874ULL, 0x18375281ae7822bcULL,
+    0x87cec76f1c830548ULL, 0x8f2293910d0b15b5ULL,
+    0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb22ULL,
+    0xd433179d9c8cb841ULL, 0x5fa60692a46151ebULL,
+    0x849feec281d7f328ULL, 0xdbc7c41ba6bcd333ULL,
+    0xa5c7ea73224deff3ULL, 0x12b9b522906c0800ULL,
+    0xcf39e50feae16befULL, 0xd768226b34870a00ULL,
+    0x81842f29f2cce375ULL, 0xe6a1158300d46640ULL,
+    0xa1e53af46f801c53ULL, 0x60495ae3c1097fd0ULL,
+    0xca5e89b18b602368ULL, 0x385bb19cb14bdfc4ULL,
+    0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b5ULL,
+    0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d1ULL,
+};
+
+// Binary layout and decision bounds of one IEEE-754 format.
+typedef struct NumberFloatFormat {
+    int mantissaBits;                // Explicit mantissa bits
+    int minimumExponent;             // Exponent bias, negated
+    int infinitePower;               // Biased exponent of infinity
+    int minRoundToEven;              // Decimal exponents where a product can fall exactly between two values
+    int maxRoundToEven;
+    int smallestPowerOfTen;          // Below this any value rounds to zero
+    int largestPowerOfTen;           // Above this any value overflows
+    int maxFastExponent;             // Powers of ten that are exact in this format
+    uint64_t maxFastMantissa;        // Mantissas that are exact in this format
+} NumberFloatFormat;
+
+static const NumberFloatFormat number_format_double = { 52, -1023, 0x7FF, -4, 23, -342, 308, 22, (uint64_t)2 << 52 };
+static const NumberFloatFormat number_format_float = { 23, -127, 0xFF, -17, 10, -65, 38, 10, (uint64_t)2 << 23 };
+
+static inline uint64_t ma_number_load8(const char *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
 }
 
-String** ma_string_split(String *str, const char *delimiter, int *count) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_split.\n");
-        return NULL;
-    }
-    if (delimiter == NULL) {
-        printf("Error: Null delimiter in string_split.\n");
-        return NULL;
+// Whether the 8 bytes loaded by ma_number_load8 are all ASCII digits.
+static inline bool ma_number_is_eight_digits(uint64_t value) {
+    return (((value + 0x4646464646464646ULL) | (value - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+}
+
+// Value of 8 ASCII digits in three multiplications instead of eight.
+static inline uint32_t ma_number_parse_eight_digits(uint64_t value) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+    value -= 0x3030303030303030ULL;
+    value = (value * 10) + (value >> 8);
+    value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+    return (uint32_t)value;
+}
+
+static inline bool ma_number_is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// Low 64 bits of a * b, the high 64 bits go to `high`.
+static inline uint64_t ma_number_multiply(uint64_t a, uint64_t b, uint64_t *high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, high);
+#else
+    uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+    uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t cross = (lowLow >> 32) + (uint32_t)highLow + lowHigh;
+    *high = aHigh * bHigh + (highLow >> 32) + (cross >> 32);
+    return (cross << 32) | (uint32_t)lowLow;
+#endif
+}
+
+static inline int ma_number_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while ((value & 0x8000000000000000ULL) == 0) {
+        value <<= 1;
+        count++;
     }
+    return count;
+#endif
+}
 
-    size_t num_splits = 0;
-    char *temp = ma_string_strdup(str->dataStr);
-    if (temp == NULL) {
-        printf("Error: Memory allocation failed in string_split.\n");
-        return NULL;
+// floor(log2(10^q)) + 63, computed without relying on arithmetic shifts of negative values.
+static inline int32_t ma_number_binary_power(int32_t q) {
+    int64_t scaled = (int64_t)(152170 + 65536) * q;
+    int64_t floored = (scaled >= 0) ? (scaled >> 16) : -((-scaled + 65535) >> 16);
+    return (int32_t)floored + 63;
+}
+
+// Eisel-Lemire: rounds w * 10^q to the nearest value of `format`, storing the
+// biased exponent and the explicit mantissa. Returns false in the rare cases
+// where the 128-bit product is too coarse to decide the rounding.
+static bool ma_number_eisel_lemire(const NumberFloatFormat *format, uint64_t w, int64_t q, int32_t *power2, uint64_t *mantissa) {
+    if (w == 0 || q < format->smallestPowerOfTen) {
+        *power2 = 0;
+        *mantissa = 0;
+        return true;
+    }
+    if (q > format->largestPowerOfTen) {
+        *power2 = format->infinitePower;
+        *mantissa = 0;
+        return true;
     }
 
-    char *token = strtok(temp, delimiter);
+    int lz = ma_number_leading_zeros(w);
+    w <<= lz;
 
-    while (token != NULL) {
-        num_splits++;
-        token = strtok(NULL, delimiter);
+    size_t index = 2 * (size_t)(q - MA_NUMBER_MIN_POWER_OF_TEN);
+    uint64_t productHigh;
+    uint64_t productLow = ma_number_multiply(w, number_powers_of_five[index], &productHigh);
+    uint64_t precisionMask = UINT64_MAX >> (format->mantissaBits + 3);
+    if ((productHigh & precisionMask) == precisionMask) {
+        uint64_t secondHigh;
+        ma_number_multiply(w, number_powers_of_five[index + 1], &secondHigh);
+        productLow += secondHigh;
+        if (secondHigh > productLow) {
+            productHigh++;
+        }
+        if (productLow == UINT64_MAX && (q < -27 || q > 55)) {
+            return false;
+        }
     }
-    free(temp);
 
-    if (num_splits == 0) {
-        return NULL;
+    int upperBit = (int)(productHigh >> 63);
+    int shift = upperBit + 64 - format->mantissaBits - 3;
+    uint64_t m = productHigh >> shift;
+    int32_t p2 = ma_number_binary_power((int32_t)q) + upperBit - lz - format->minimumExponent;
+
+    if (p2 <= 0) {
+        // Subnormal, or a normal value reached only by rounding up.
+        if (-p2 + 1 >= 64) {
+            *power2 = 0;
+            *mantissa = 0;
+            return true;
+        }
+        m >>= -p2 + 1;
+        m += (m & 1);
+        m >>= 1;
+        *power2 = (m < ((uint64_t)1 << format->mantissaBits)) ? 0 : 1;
+        *mantissa = m & ~((uint64_t)1 << format->mantissaBits);
+        return true;
     }
 
-    String** splits = malloc(sizeof(String*) * num_splits);
-    if (splits == NULL) {
-        printf("Error: Memory allocation failed for splits in string_split.\n");
-        return NULL;
+    // Exactly halfway between two values: round to even.
+    if (productLow <= 1 && q >= format->minRoundToEven && q <= format->maxRoundToEven && (m & 3) == 1 && (m << shift) == productHigh) {
+        m &= ~(uint64_t)1;
     }
 
-    temp = ma_string_strdup(str->dataStr);
-    if (temp == NULL) {
-        printf("Error: Memory allocation failed in string_split.\n");
-        free(splits);
-        return NULL;
+    m += (m & 1);
+    m >>= 1;
+    if (m >= ((uint64_t)2 << format->mantissaBits)) {
+        m = (uint64_t)1 << format->mantissaBits;
+        p2++;
+    }
+    m &= ~((uint64_t)1 << format->mantissaBits);
+    if (p2 >= format->infinitePower) {
+        p2 = format->infinitePower;
+        m = 0;
     }
 
-    token = strtok(temp, delimiter);
-    size_t index = 0;
+    *power2 = p2;
+    *mantissa = m;
+    return true;
+}
 
-    while (token != NULL && index < num_splits) {
-        splits[index] = ma_string_create(token);
+static const double number_exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
 
-        if (splits[index] == NULL) {
-            printf("Error: Failed to create string in string_split.\n");
-            // Free previously allocated strings and array
-            for (size_t i = 0; i < index; i++) {
-                ma_string_deallocate(splits[i]); // Assuming string_free is defined
-            }
-            free(splits);
-            free(temp);
-            return NULL;
+// Decimal number split by ma_number_scan_decimal.
+typedef struct NumberDecimal {
+    bool negative;
+    uint64_t mantissa;           // First 19 significant digits at most
+    int64_t exponent;            // Power of ten applied to mantissa
+    bool truncated;              // Digits were dropped from the mantissa
+    size_t consumed;
+} NumberDecimal;
+
+static inline bool ma_number_match_word(const char *data, size_t size, const char *word) {
+    size_t length = strlen(word);
+    if (size < length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if ((data[i] | 0x20) != word[i]) {
+            return false;
         }
-        index++;
-        token = strtok(NULL, delimiter);
     }
-    free(temp);
-    *count = num_splits;
-
-    return splits;
+    return true;
 }
 
-String* ma_string_join(String **strings, int count, const char *delimiter) {
-    if (strings == NULL) {
-        printf("Error: Null string array in string_join.\n");
-        return NULL;
+static const char *ma_number_skip_digits(const char *p, const char *end, uint64_t *value) {
+    uint64_t v = *value;
+    while (end - p >= 8 && ma_number_is_eight_digits(ma_number_load8(p))) {
+        v = v * 100000000 + ma_number_parse_eight_digits(ma_number_load8(p));
+        p += 8;
+    }
+    while (p < end && ma_number_is_digit(*p)) {
+        v = v * 10 + (uint64_t)(*p - '0');
+        p++;
     }
+    *value = v;
+    return p;
+}
 
-    if (count <= 0) {
-        printf("Error: Invalid count in string_join.\n");
-        return NULL;
+// Splits `[sign] digits [. digits] [(e|E) [sign] digits]` into a mantissa and
+// a power of ten. Returns false when no digit starts the input.
+static bool ma_number_scan_decimal(const char *data, size_t size, NumberDecimal *decimal) {
+    const char *p = data;
+    const char *end = data + size;
+    memset(decimal, 0, sizeof(NumberDecimal));
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        decimal->negative = (*p == '-');
+        p++;
     }
 
-    if (delimiter == NULL) {
-        printf("Error: Null delimiter in string_join.\n");
-        return NULL;
+    // Digits are accumulated modulo 2^64 first; the mantissa is redone below
+    // in the rare case where there are more than 19 of them.
+    uint64_t w = 0;
+    const char *integerStart = p;
+    p = ma_number_skip_digits(p, end, &w);
+    const char *integerEnd = p;
+    const char *fractionStart = p;
+    const char *fractionEnd = p;
+    if (p < end && *p == '.') {
+        fractionStart = ++p;
+        p = ma_number_skip_digits(p, end, &w);
+        fractionEnd = p;
     }
 
-    String* result = ma_string_create("");
-    if (result == NULL) {
-        printf("Error: Memory allocation failed in string_join.\n");
-        return NULL;
+    size_t digitCount = (size_t)(integerEnd - integerStart) + (size_t)(fractionEnd - fractionStart);
+    if (digitCount == 0) {
+        return false;
+    }
+    int64_t explicitExponent = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '-' || *q == '+')) {
+            negativeExponent = (*q == '-');
+            q++;
+        }
+        if (q < end && ma_number_is_digit(*q)) {
+            int64_t value = 0;
+            while (q < end && ma_number_is_digit(*q)) {
+                if (value < 0x10000000) {
+                    value = value * 10 + (*q - '0');
+                }
+                q++;
+            }
+            explicitExponent = negativeExponent ? -value : value;
+            p = q;
+        }
     }
+    int64_t exponent = explicitExponent - (int64_t)(fractionEnd - fractionStart);
 
-    for (int i = 0; i < count; i++) {
-        ma_string_append(result, strings[i]->dataStr);
-        if (i < count - 1) {
-            ma_string_append(result, delimiter);
+    if (digitCount > 19) {
+        const char *start = integerStart;
+        while (start < fractionEnd && (*start == '0' || *start == '.')) {
+            if (*start == '0') {
+                digitCount--;
+            }
+            start++;
+        }
+        if (digitCount > 19) {
+            const uint64_t minNineteenDigits = 1000000000000000000ULL;
+            const char *q = integerStart;
+            decimal->truncated = true;
+            w = 0;
+            while (w < minNineteenDigits && q < integerEnd) {
+                w = w * 10 + (uint64_t)(*q++ - '0');
+            }
+            if (w >= minNineteenDigits) {
+                exponent = explicitExponent + (int64_t)(integerEnd - q);
+            }
+            else {
+                q = fractionStart;
+                while (w < minNineteenDigits && q < fractionEnd) {
+                    w = w * 10 + (uint64_t)(*q++ - '0');
+                }
+                exponent = explicitExponent - (int64_t)(q - fractionStart);
+            }
         }
     }
-    return result;
+
+    decimal->mantissa = w;
+    decimal->exponent = exponent;
+    decimal->consumed = (size_t)(p - data);
+    return true;
 }
 
-void ma_string_replace_all(String *str, const char *oldStr, const char *newStr) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_replace_all.\n");
-        return;
+// Correctly rounded libc conversion of the scanned text, used when the fast
+// paths cannot decide. The '.' is swapped for the locale's decimal point.
+static double ma_number_fallback(const char *data, size_t length, bool single) {
+    char local[128];
+    char *copy = (length < sizeof(local)) ? local : ma_allocator_alloc(length + 1);
+    if (copy == NULL) {
+        return 0.0;
     }
+    memcpy(copy, data, length);
+    copy[length] = '\0';
 
-    if (oldStr == NULL || newStr == NULL) {
-        printf("Error: Null substring in string_replace_all.\n");
-        return;
+    const char *point = localeconv()->decimal_point;
+    char *dot = memchr(copy, '.', length);
+    if (dot != NULL && point != NULL && point[0] != '\0') {
+        *dot = point[0];
     }
 
-    String* temp = ma_string_create("");
-    if (temp == NULL) {
-        printf("Error: Memory allocation failed in string_replace_all.\n");
-        return;
+    double value = single ? (double)strtof(copy, NULL) : strtod(copy, NULL);
+    if (copy != local) {
+        ma_allocator_free(copy);
     }
+    return value;
+}
 
-    char *start = str->dataStr;
-    char *end;
+static StringParseResult ma_string_parse_floating(const char *data, size_t length, const NumberFloatFormat *format, double *value) {
+    StringParseResult result = { STRING_PARSE_INVALID, 0 };
+    bool single = (format == &number_format_float);
+    NumberDecimal decimal;
 
-    while ((end = strstr(start, oldStr)) != NULL) {
-        *end = '\0';
-        ma_string_append(temp, start);
-        ma_string_append(temp, newStr);
-        start = end + strlen(oldStr);
+    if (data == NULL || !ma_number_scan_decimal(data, length, &decimal)) {
+        // Not a decimal number, maybe infinity or NaN.
+        const char *p = data;
+        const char *end = data + length;
+        bool negative = false;
+        if (p != NULL && p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            p++;
+        }
+        if (p != NULL && ma_number_match_word(p, (size_t)(end - p), "inf")) {
+            p += ma_number_match_word(p, (size_t)(end - p), "infinity") ? 8 : 3;
+            *value = negative ? -HUGE_VAL : HUGE_VAL;
+        }
+        else if (p != NULL && ma_number_match_word(p, (size_t)(end - p), "nan")) {
+            p += 3;
+            *value = negative ? -NAN : NAN;
+        }
+        else {
+            return result;
+        }
+        result.status = STRING_PARSE_OK;
+        result.consumed = (size_t)(p - data);
+        return result;
+    }
+    result.status = STRING_PARSE_OK;
+    result.consumed = decimal.consumed;
+
+#if FLT_EVAL_METHOD == 0
+    // Clinger's fast path: mantissa and power of ten are both exact in the
+    // target format, so a single correctly rounded operation gives the result.
+    if (!decimal.truncated && decimal.mantissa <= format->maxFastMantissa &&
+        decimal.exponent >= -format->maxFastExponent && decimal.exponent <= format->maxFastExponent) {
+        double v;
+        if (single) {
+            float f = (float)decimal.mantissa;
+            float power = (float)number_exact_powers_of_ten[(decimal.exponent < 0) ? -decimal.exponent : decimal.exponent];
+            v = (double)((decimal.exponent < 0) ? f / power : f * power);
+        }
+        else {
+            double power = number_exact_powers_of_ten[(decimal.exponent < 0) ? -decimal.exponent : decimal.exponent];
+            v = (decimal.exponent < 0) ? (double)decimal.mantissa / power : (double)decimal.mantissa * power;
+        }
+        *value = decimal.negative ? -v : v;
+        return result;
     }
+#endif
 
-    ma_string_append(temp, start);
-    ma_string_assign(str, temp->dataStr);
-    ma_string_deallocate(temp);
-}
+    int32_t power2;
+    uint64_t mantissa;
+    bool decided = ma_number_eisel_lemire(format, decimal.mantissa, decimal.exponent, &power2, &mantissa);
+    if (decided && decimal.truncated) {
+        // The dropped digits only matter when they could change the rounding.
+        int32_t upperPower2;
+        uint64_t upperMantissa;
+        decided = ma_number_eisel_lemire(format, decimal.mantissa + 1, decimal.exponent, &upperPower2, &upperMantissa) &&
+                  upperPower2 == power2 && upperMantissa == mantissa;
+    }
 
-int ma_string_to_int(String *str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_to_int.\n");
-        return 0;
+    if (!decided) {
+        *value = ma_number_fallback(data, decimal.consumed, single);
     }
-    if (ma_string_empty(str)) {
-        printf("Error: Empty string in string_to_int.\n");
-        return 0;
+    else if (single) {
+        uint32_t bits = (uint32_t)mantissa | ((uint32_t)power2 << 23) | ((uint32_t)decimal.negative << 31);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        *value = (double)f;
     }
-    return atoi(str->dataStr);
-}
-
-float ma_string_to_float(String *str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_to_float.\n");
-        return 0.0f;
+    else {
+        uint64_t bits = mantissa | ((uint64_t)power2 << 52) | ((uint64_t)decimal.negative << 63);
+        memcpy(value, &bits, sizeof(*value));
     }
-    if (ma_string_empty(str)) {
-        printf("Error: Empty string in string_to_float.\n");
-        return 0.0f;
+
+    // Nonzero digits that round to infinity or to zero are out of range, as
+    // strtod reports them with ERANGE.
+    if (isinf(*value) || (*value == 0.0 && decimal.mantissa != 0)) {
+        result.status = STRING_PARSE_OUT_OF_RANGE;
     }
-    return atof(str->dataStr);
+    return result;
 }
 
-double ma_string_to_double(String* str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_to_double.\n");
-        return 0.0;
-    }
-    if (ma_string_empty(str)) {
-        printf("Error: Empty string in string_to_double.\n");
-        return 0.0;
+// Digits of an unsigned magnitude. The first 19 significant digits cannot
+// overflow and go through the 8-digit SWAR step; only a 20th is checked.
+static StringParseResult ma_number_parse_magnitude(const char *p, const char *end, uint64_t *magnitude) {
+    StringParseResult result = { STRING_PARSE_INVALID, 0 };
+    const char *start = p;
+    while (p < end && *p == '0') {
+        p++;
     }
-    return strtod(str->dataStr, NULL);
-}
 
-void ma_string_pad_left(String *str, size_t totalLength, char padChar) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_pad_left.\n");
-        return;
+    const char *significant = p;
+    uint64_t v = 0;
+    while (end - p >= 8 && p - significant <= 11 && ma_number_is_eight_digits(ma_number_load8(p))) {
+        v = v * 100000000 + ma_number_parse_eight_digits(ma_number_load8(p));
+        p += 8;
     }
-    if (str->size >= totalLength) {
-        printf("Error: Size of String object is bigger or equal that total Length in string_pad_left.\n");
-        return;
+    while (p < end && ma_number_is_digit(*p) && p - significant < 19) {
+        v = v * 10 + (uint64_t)(*p - '0');
+        p++;
     }
-    size_t padSize = totalLength - str->size;
-    size_t newSize = str->size + padSize;
-    char *newData = (char *)malloc(newSize + 1); // +1 for null terminator
 
-    if (newData == NULL) {
-        printf("Error: Failed to allocate memory in string_pad_left.\n");
-        return;
+    result.status = STRING_PARSE_OK;
+    while (p < end && ma_number_is_digit(*p)) {
+        uint64_t digit = (uint64_t)(*p - '0');
+        if (result.status == STRING_PARSE_OK && v <= (UINT64_MAX - digit) / 10) {
+            v = v * 10 + digit;
+        }
+        else {
+            result.status = STRING_PARSE_OUT_OF_RANGE;
+        }
+        p++;
     }
 
-    memset(newData, padChar, padSize);
-    memcpy(newData + padSize, str->dataStr, str->size);
-    newData[newSize] = '\0';
-
-    free(str->dataStr);
-    str->dataStr = newData;
-    str->size = newSize;
-    str->capacitySize = newSize + 1;
+    if (p == start) {
+        result.status = STRING_PARSE_INVALID;
+        return result;
+    }
+    result.consumed = (size_t)(p - start);
+    *magnitude = (result.status == STRING_PARSE_OK) ? v : UINT64_MAX;
+    return result;
 }
 
-void ma_string_pad_right(String *str, size_t totalLength, char padChar) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_pad_right.\n");
-        return;
-    }
-    if (str->size >= totalLength) {
-        printf("Error: Size of String object is bigger or equal that total Length in string_pad_right.\n");
-        return;
+StringParseResult ma_string_parse_uint64_len(const char* data, size_t length, uint64_t* value) {
+    StringParseResult result = { STRING_PARSE_INVALID, 0 };
+    if (data == NULL || value == NULL) {
+        printf("Error: The data or the value is NULL in string_parse_uint64.\n");
+        return result;
     }
 
-    size_t padSize = totalLength - str->size;
-    size_t newSize = str->size + padSize;
-    char* newData = (char *)realloc(str->dataStr, newSize + 1); // +1 for null terminator
-
-    if (newData == NULL) {
-        printf("Error: Failed to allocate memory in string_pad_right.\n");
-        return;
+    size_t sign = (length > 0 && data[0] == '+') ? 1 : 0;
+    uint64_t magnitude = 0;
+    result = ma_number_parse_magnitude(data + sign, data + length, &magnitude);
+    if (result.status == STRING_PARSE_INVALID) {
+        return result;
     }
 
-    memset(newData + str->size, padChar, padSize);
-    newData[newSize] = '\0';
-
-    str->dataStr = newData;
-    str->size = newSize;
-    str->capacitySize = newSize + 1;
+    result.consumed += sign;
+    *value = magnitude;
+    return result;
 }
 
-String* ma_string_to_hex(String *str) {
-    if (str == NULL) {
-        printf("Error: Null String object in string_to_hex.\n");
-        return NULL;
+StringParseResult ma_string_parse_int64_len(const char* data, size_t length, int64_t* value) {
+    StringParseResult result = { STRING_PARSE_INVALID, 0 };
+    if (data == NULL || value == NULL) {
+        printf("Error: The data or the value is NULL in string_parse_int64.\n");
+        return result;
     }
-    if (ma_string_empty(str)) {
-        return ma_string_create(""); // Return an empty string for an empty input.
+
+    bool negative = (length > 0 && data[0] == '-');
+    size_t sign = (length > 0 && (data[0] == '-' || data[0] == '+')) ? 1 : 0;
+    uint64_t magnitude = 0;
+    result = ma_number_parse_magnitude(data + sign, data + length, &magnitude);
+    if (result.status == STRING_PARSE_INVALID) {
+        return result;
     }
 
-    String *hexStr = ma_string_create("");
-    if (hexStr == NULL) {
-        printf("Error: Memory allocation failed in string_to_hex.\n");
-        return NULL;
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (magnitude > limit) {
+        result.status = STRING_PARSE_OUT_OF_RANGE;
+        magnitude = limit;
     }
 
-    for (size_t i = 0; i < str->size; ++i) {
-        char buffer[3];  // Each char can be represented by max 2 hex digits + null terminator
+    result.consumed += sign;
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return result;
+}
 
-        sprintf(buffer, "%02x", (unsigned char)str->dataStr[i]);
-        ma_string_append(hexStr, buffer);
+StringParseResult ma_string_parse_double_len(const char* data, size_t length, double* value) {
+    if (value == NULL) {
+        printf("Error: The value is NULL in string_parse_double.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
-    return hexStr;
+    return ma_string_parse_floating(data, length, &number_format_double, value);
 }
 
-String* ma_string_from_hex(String *hexStr) {
-    if (hexStr == NULL) {
-        printf("Error: Null String object in string_from_hex.\n");
-        return NULL;
-    }
-    if (ma_string_empty(hexStr) || (hexStr->size % 2) != 0) {
-        printf("Error: Invalid hex string in string_from_hex.\n");
-        return NULL; // Hex string should have an even number of characters
+StringParseResult ma_string_parse_float_len(const char* data, size_t length, float* value) {
+    double parsed = 0.0;
+    if (value == NULL) {
+        printf("Error: The value is NULL in string_parse_float.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
 
-    String *str = ma_string_create("");
-    if (str == NULL) {
-        printf("Error: Memory allocation failed in string_from_hex.\n");
-        return NULL;
+    StringParseResult result = ma_string_parse_floating(data, length, &number_format_float, &parsed);
+    if (result.status != STRING_PARSE_INVALID) {
+        *value = (float)parsed;
     }
+    return result;
+}
 
-    for (size_t i = 0; i < hexStr->size; i += 2) {
-        char buffer[3] = {hexStr->dataStr[i], hexStr->dataStr[i + 1], '\0'};
-        char ch = (char)strtol(buffer, NULL, 16);
-
-        ma_string_push_back(str, ch);
+StringParseResult ma_string_parse_int64(const String* str, int64_t* value) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_parse_int64.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
-    return str;
+    return ma_string_parse_int64_len(str->dataStr, str->size, value);
 }
 
-size_t ma_string_count(String* str, const char* substr) {
+StringParseResult ma_string_parse_uint64(const String* str, uint64_t* value) {
     if (str == NULL) {
-        printf("Error: Null String object in string_count.\n");
-        return 0;
-    }
-    if (substr == NULL) {
-        printf("Error: Null substring in string_count.\n");
-        return 0;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: Null data string in String object in string_count.\n");
-        return 0;
+        printf("Error: The String object is NULL in string_parse_uint64.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
-    size_t count = 0;
-    const char* temp = str->dataStr;
-    const char* found;
+    return ma_string_parse_uint64_len(str->dataStr, str->size, value);
+}
 
-    while ((found = strstr(temp, substr)) != NULL) {
-        count++;
-        temp = found + strlen(substr);
+StringParseResult ma_string_parse_double(const String* str, double* value) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_parse_double.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
-    return count;
+    return ma_string_parse_double_len(str->dataStr, str->size, value);
 }
 
-void ma_string_remove(String* str, const char* substr) {
+StringParseResult ma_string_parse_float(const String* str, float* value) {
     if (str == NULL) {
-        printf("Error: Null String object in string_remove.\n");
-        return;
-    }
-    if (substr == NULL) {
-        printf("Error: Null substring in string_remove.\n");
-        return;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: Null data string in String object in string_remove.\n");
-        return;
-    }
-    if (strlen(substr) == 0) {
-        printf("Error: Empty substring in string_remove.\n");
-        return;
+        printf("Error: The String object is NULL in string_parse_float.\n");
+        StringParseResult result = { STRING_PARSE_INVALID, 0 };
+        return result;
     }
-    size_t len = strlen(substr);
-    char* p = str->dataStr;
+    return ma_string_parse_float_len(str->dataStr, str->size, value);
+}
+
+// ------------------------------------------------------------------------- //
+//                        String number formatting                           //
+// ------------------------------------------------------------------------- //
 
-    while ((p = strstr(p, substr)) != NULL) {
-        memmove(p, p + len, strlen(p + len) + 1);
+static const char number_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline int ma_number_digit_count(uint64_t value) {
+    int count = 1;
+    while (value >= 10000) {
+        value /= 10000;
+        count += 4;
     }
+    return count + (value >= 10) + (value >= 100) + (value >= 1000);
 }
 
-void ma_string_remove_range(String* str, size_t startPos, size_t endPos) {
-    if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Null String object in string_remove_range.\n");
-        return;
+// Writes the digits of `value` so that they end right before `end`, two at a time.
+static void ma_number_write_digits(char *end, uint64_t value) {
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        memcpy(end, number_digit_pairs + pair, 2);
     }
-    if (startPos >= endPos || endPos > str->size) {
-        printf("Error: Invalid range in string_remove_range.\n");
-        return;
+    if (value >= 10) {
+        memcpy(end - 2, number_digit_pairs + value * 2, 2);
+    }
+    else {
+        end[-1] = (char)('0' + value);
     }
-    size_t length = endPos - startPos;
-
-    memmove(str->dataStr + startPos, str->dataStr + endPos, str->size - endPos + 1); // +1 for null terminator
-    str->size -= length;
 }
 
-String* ma_string_from_int(int value) {
-    char buffer[12]; // Enough to hold any 32-bit integer
-    sprintf(buffer, "%d", value);
+size_t ma_string_write_uint64(char* buffer, uint64_t value) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_write_uint64.\n");
+        return 0;
+    }
 
-    return ma_string_create(buffer);
+    size_t length = (size_t)ma_number_digit_count(value);
+    ma_number_write_digits(buffer + length, value);
+    buffer[length] = '\0';
+    return length;
 }
 
-char* ma_string_from_int_cstr(int value) {
-    char buffer[12]; // Enough to hold any 32-bit integer
-    sprintf(buffer, "%d", value);
-
-    char* result = malloc(strlen(buffer) + 1); // +1 for null-terminator
-    if (result) {
-        strcpy(result, buffer);
+size_t ma_string_write_int64(char* buffer, int64_t value) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_write_int64.\n");
+        return 0;
     }
 
-    return result;
+    if (value < 0) {
+        buffer[0] = '-';
+        return 1 + ma_string_write_uint64(buffer + 1, 0 - (uint64_t)value);
+    }
+    return ma_string_write_uint64(buffer, (uint64_t)value);
 }
 
-String* ma_string_from_float(float value) {
-    char buffer[32]; // A general buffer size for a float
-    sprintf(buffer, "%f", value);
-
-    return ma_string_create(buffer);
+static inline int32_t ma_number_floor_div_pow2(int32_t value, int shift) {
+    return (value >= 0) ? (value >> shift) : -((-value + (1 << shift) - 1) >> shift);
 }
 
-String* ma_string_from_double(double value) {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%f", value);
-
-    return ma_string_create(buffer);
+// floor(log10(2^e)), minus floor(log10(4/3)) worth when `closer` is set.
+static inline int32_t ma_number_decimal_power(int32_t e, bool closer) {
+    return ma_number_floor_div_pow2(e * 1262611 - (closer ? 524031 : 0), 22);
 }
 
-String** ma_string_tokenize(String* str, const char* delimiters, int* count) {
-    if (str == NULL || delimiters == NULL) {
-        printf("Error: Invalid input in string_tokenize.\n");
-        return NULL;
-    }
+// floor(log2(10^e))
+static inline int32_t ma_number_floor_log2_pow10(int32_t e) {
+    return ma_number_floor_div_pow2(e * 1741647, 19);
+}
 
-    size_t num_tokens = 0;
-    char* temp_str = ma_string_strdup(str->dataStr); // strdup
-    if (temp_str == NULL) {
-        printf("Error: Memory allocation failed in string_tokenize.\n");
-        return NULL;
+// floor(10^q normalized to 128 bits) + 1, the significand Schubfach works with.
+static void ma_number_pow10_significand(int32_t q, uint64_t *high, uint64_t *low) {
+    size_t index = 2 * (size_t)(q - MA_NUMBER_MIN_POWER_OF_TEN);
+    uint64_t h = number_powers_of_five[index];
+    uint64_t l = number_powers_of_five[index + 1];
+    if (q < -27 || q >= 0) {
+        l++;
+        h += (l == 0);
     }
+    *high = h;
+    *low = l;
+}
 
-    char* token = strtok(temp_str, delimiters);
-
-    while (token != NULL) {
-        num_tokens++;
-        token = strtok(NULL, delimiters);
-    }
+static inline uint64_t ma_number_round_to_odd(uint64_t gHigh, uint64_t gLow, uint64_t cp) {
+    uint64_t xHigh;
+    ma_number_multiply(gLow, cp, &xHigh);
+    uint64_t yHigh;
+    uint64_t yLow = ma_number_multiply(gHigh, cp, &yHigh);
+    uint64_t z = yLow + xHigh;
+    yHigh += (z < yLow);
+    return yHigh | (z > 1);
+}
 
-    free(temp_str);
+static inline uint32_t ma_number_round_to_odd32(uint64_t g, uint32_t cp) {
+    uint64_t low = (uint64_t)cp * (uint32_t)g;
+    uint64_t high = (uint64_t)cp * (g >> 32) + (low >> 32);
+    return (uint32_t)(high >> 32) | ((uint32_t)high > 1);
+}
 
-    // Allocate array of String pointers
-    String** tokens = malloc(num_tokens * sizeof(String*));
-    if (tokens == NULL) {
-        printf("Error: Memory allocation failed for tokens in string_tokenize.\n");
-        return NULL;
+// Schubfach: the shortest decimal digits * 10^exponent that rounds back to
+// the finite, non-zero double whose fields are given, the closest one when
+// several are as short.
+static void ma_number_shortest_double(uint64_t ieeeMantissa, uint32_t ieeeExponent, uint64_t *digits, int32_t *exponent) {
+    uint64_t c;
+    int32_t q;
+    if (ieeeExponent != 0) {
+        c = ((uint64_t)1 << 52) | ieeeMantissa;
+        q = (int32_t)ieeeExponent - 1075;
+        if (q <= 0 && q > -53 && (c & (((uint64_t)1 << -q) - 1)) == 0) {
+            *digits = c >> -q; // Small integer
+            *exponent = 0;
+            return;
+        }
     }
-
-    // Tokenize again to fill the array
-    temp_str = ma_string_strdup(str->dataStr);
-    if (temp_str == NULL) {
-        printf("Error: Memory allocation failed in string_tokenize.\n");
-        free(tokens);
-        return NULL;
+    else {
+        c = ieeeMantissa;
+        q = 1 - 1075;
+    }
+
+    bool even = (c % 2) == 0;
+    bool closer = (ieeeMantissa == 0 && ieeeExponent > 1);
+    uint64_t cbl = 4 * c - 2 + closer;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+
+    int32_t k = ma_number_decimal_power(q, closer);
+    int32_t h = q + ma_number_floor_log2_pow10(-k) + 1;
+    uint64_t gHigh, gLow;
+    ma_number_pow10_significand(-k, &gHigh, &gLow);
+
+    uint64_t vbl = ma_number_round_to_odd(gHigh, gLow, cbl << h);
+    uint64_t vb = ma_number_round_to_odd(gHigh, gLow, cb << h);
+    uint64_t vbr = ma_number_round_to_odd(gHigh, gLow, cbr << h);
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+
+    uint64_t s = vb / 4;
+    if (s >= 10) {
+        uint64_t sp = s / 10;
+        bool upInside = lower <= 40 * sp;
+        bool wpInside = 40 * sp + 40 <= upper;
+        if (upInside != wpInside) {
+            *digits = sp + wpInside;
+            *exponent = k + 1;
+            return;
+        }
     }
 
-    token = strtok(temp_str, delimiters);
-    size_t idx = 0;
-
-    while (token != NULL && idx < num_tokens) {
-        tokens[idx] = ma_string_create(token);
-        if (tokens[idx] == NULL) {
-            printf("Error: string_create failed in string_tokenize.\n");
-            for (size_t i = 0; i < idx; ++i) {
-                // Assuming a function to free String* is available
-                ma_string_deallocate(tokens[i]);
-            }
-            free(tokens);
-            free(temp_str);
-            return NULL;
-        }
-        idx++;
-        token = strtok(NULL, delimiters);
+    bool uInside = lower <= 4 * s;
+    bool wInside = 4 * s + 4 <= upper;
+    if (uInside != wInside) {
+        *digits = s + wInside;
+        *exponent = k;
+        return;
     }
-    free(temp_str);
-    *count = num_tokens;
 
-    return tokens;
+    uint64_t mid = 4 * s + 2;
+    bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+    *digits = s + roundUp;
+    *exponent = k;
 }
 
-int ma_string_compare_ignore_case(String* str1, String* str2) {
-    if (str1 == NULL || str2 == NULL) {
-        if (str1 == str2) {
-            return 0;
+// Same as ma_number_shortest_double for a float, with 64-bit arithmetic.
+static void ma_number_shortest_float(uint32_t ieeeMantissa, uint32_t ieeeExponent, uint64_t *digits, int32_t *exponent) {
+    uint32_t c;
+    int32_t q;
+    if (ieeeExponent != 0) {
+        c = ((uint32_t)1 << 23) | ieeeMantissa;
+        q = (int32_t)ieeeExponent - 150;
+        if (q <= 0 && q > -24 && (c & (((uint32_t)1 << -q) - 1)) == 0) {
+            *digits = c >> -q;
+            *exponent = 0;
+            return;
         }
-        return (str1 == NULL) ? -1 : 1;
     }
-    if (str1->dataStr == NULL || str2->dataStr == NULL) {
-        if (str1->dataStr == str2->dataStr) {
-            return 0; // Both dataStr are NULL, considered equal
+    else {
+        c = ieeeMantissa;
+        q = 1 - 150;
+    }
+
+    bool even = (c % 2) == 0;
+    bool closer = (ieeeMantissa == 0 && ieeeExponent > 1);
+    uint32_t cbl = 4 * c - 2 + closer;
+    uint32_t cb = 4 * c;
+    uint32_t cbr = 4 * c + 2;
+
+    int32_t k = ma_number_decimal_power(q, closer);
+    int32_t h = q + ma_number_floor_log2_pow10(-k) + 1;
+
+    // 64-bit significand: floor of the exact 128-bit value's high word, plus one.
+    size_t index = 2 * (size_t)(-k - MA_NUMBER_MIN_POWER_OF_TEN);
+    uint64_t g = number_powers_of_five[index];
+    if (-k >= -27 && -k < 0 && number_powers_of_five[index + 1] == 0) {
+        g--; // The table entry was rounded up across the word boundary
+    }
+    g++;
+
+    uint32_t vbl = ma_number_round_to_odd32(g, cbl << h);
+    uint32_t vb = ma_number_round_to_odd32(g, cb << h);
+    uint32_t vbr = ma_number_round_to_odd32(g, cbr << h);
+    uint32_t lower = vbl + !even;
+    uint32_t upper = vbr - !even;
+
+    uint32_t s = vb / 4;
+    if (s >= 10) {
+        uint32_t sp = s / 10;
+        bool upInside = lower <= 40 * sp;
+        bool wpInside = 40 * sp + 40 <= upper;
+        if (upInside != wpInside) {
+            *digits = sp + wpInside;
+            *exponent = k + 1;
+            return;
         }
-        return (str1->dataStr == NULL) ? -1 : 1; // One dataStr is NULL, the other is not
     }
-    return strcasecmp(str1->dataStr, str2->dataStr);
-}
 
-String* ma_string_base64_encode(const String *input) {
-    if (input == NULL) {
-        printf("Error: The String object is NULL in string_baes64_encode.\n");
-        return NULL;
-    }
-    if (input->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_base64_encode.\n");
-        return NULL;
+    bool uInside = lower <= 4 * s;
+    bool wInside = 4 * s + 4 <= upper;
+    if (uInside != wInside) {
+        *digits = s + wInside;
+        *exponent = k;
+        return;
     }
-    String *encoded = ma_string_create("");
-    int val = 0, valb = -6;
-    size_t i;
 
-    for (i = 0; i < input->size; i++) {
-        unsigned char c = input->dataStr[i];
-        val = (val << 8) + c;
-        valb += 8;
+    uint32_t mid = 4 * s + 2;
+    bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+    *digits = s + roundUp;
+    *exponent = k;
+}
 
-        while (valb >= 0) {
-            ma_string_push_back(encoded, base64_chars[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
+// Lays out digits * 10^exponent the way ECMAScript prints numbers: plain
+// notation for magnitudes in [1e-6, 1e21), scientific notation otherwise.
+static size_t ma_number_write_decimal(char *buffer, bool negative, uint64_t digits, int32_t exponent) {
+    char *p = buffer;
+    if (negative) {
+        *p++ = '-';
     }
 
-    if (valb > -6) {
-        ma_string_push_back(encoded, base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
+    while (digits % 10 == 0) {
+        digits /= 10;
+        exponent++;
     }
+    int count = ma_number_digit_count(digits);
+    int point = count + exponent; // Digits before the decimal point
 
-    while (encoded->size % 4) {
-        ma_string_push_back(encoded, '=');
+    if (point >= count && point <= 21) {
+        ma_number_write_digits(p + count, digits);
+        p += count;
+        memset(p, '0', (size_t)(point - count));
+        p += point - count;
     }
-    return encoded;
+    else if (point > 0 && point <= 21) {
+        ma_number_write_digits(p + count + 1, digits);
+        memmove(p, p + 1, (size_t)point);
+        p[point] = '.';
+        p += count + 1;
+    }
+    else if (point > -6 && point <= 0) {
+        p[0] = '0';
+        p[1] = '.';
+        memset(p + 2, '0', (size_t)-point);
+        p += 2 - point;
+        ma_number_write_digits(p + count, digits);
+        p += count;
+    }
+    else {
+        ma_number_write_digits(p + count + 1, digits);
+        p[0] = p[1];
+        if (count > 1) {
+            p[1] = '.';
+            p += count + 1;
+        }
+        else {
+            p += 1;
+        }
+        int32_t scientific = point - 1;
+        *p++ = 'e';
+        *p++ = (scientific < 0) ? '-' : '+';
+        p += ma_string_write_uint64(p, (uint64_t)((scientific < 0) ? -scientific : scientific));
+    }
+
+    *p = '\0';
+    return (size_t)(p - buffer);
 }
 
-String* ma_string_base64_decode(const String* encodedStr) {
-    if (encodedStr == NULL) {
-        printf("Error: encodedStr param is null in string_base64_decode\n");
-        return NULL;
+// Infinity, NaN and zero, which the shortest-digit searches do not handle.
+static size_t ma_number_write_special(char *buffer, bool negative, bool nan, bool infinite) {
+    const char *text = nan ? "nan" : infinite ? "inf" : "0";
+    size_t length = 0;
+    if (negative && !nan) {
+        buffer[length++] = '-';
     }
+    size_t textLength = strlen(text);
+    memcpy(buffer + length, text, textLength + 1);
+    return length + textLength;
+}
 
-    if (encodedStr->dataStr == NULL) {
-        printf("Error: dataStr item of encodedStr object is null in string_base64_decode\n");
-        return NULL;
+size_t ma_string_write_double(char* buffer, double value) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_write_double.\n");
+        return 0;
     }
 
-    char* decodedStr = (char*)malloc(encodedStr->size * 3 / 4 + 1);
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 63) != 0;
+    uint32_t ieeeExponent = (uint32_t)(bits >> 52) & 0x7FF;
+    uint64_t ieeeMantissa = bits & (((uint64_t)1 << 52) - 1);
 
-    if (decodedStr == NULL) {
-        printf("Error: Failed to allocate memory for base64 decoding");
-        return NULL;
+    if (ieeeExponent == 0x7FF || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+        return ma_number_write_special(buffer, negative, ieeeExponent == 0x7FF && ieeeMantissa != 0, ieeeExponent == 0x7FF);
     }
 
-    int val = 0, valb = -8;
-    size_t i = 0;
-    size_t j = 0;
-
-    for (i = 0; i < encodedStr->size; i++) {
-        char c = encodedStr->dataStr[i];
-        if (c == '=')
-            break;
+    uint64_t digits;
+    int32_t exponent;
+    ma_number_shortest_double(ieeeMantissa, ieeeExponent, &digits, &exponent);
+    return ma_number_write_decimal(buffer, negative, digits, exponent);
+}
 
-        if (c >= 'A' && c <= 'Z') {
-            c -= 'A';
-        } else if (c >= 'a' && c <= 'z') {
-            c = c - 'a' + 26;
-        } else if (c >= '0' && c <= '9') {
-            c = c - '0' + 52;
-        } else if (c == '+') {
-            c = 62;
-        } else if (c == '/') {
-            c = 63;
-        } else {
-            continue;
-        }
+size_t ma_string_write_float(char* buffer, float value) {
+    if (buffer == NULL) {
+        printf("Error: The buffer is NULL in string_write_float.\n");
+        return 0;
+    }
 
-        val = (val << 6) | c;
-        valb += 6;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 31) != 0;
+    uint32_t ieeeExponent = (bits >> 23) & 0xFF;
+    uint32_t ieeeMantissa = bits & (((uint32_t)1 << 23) - 1);
 
-        if (valb >= 0) {
-            decodedStr[j++] = (char)((val >> valb) & 0xFF);
-            valb -= 8;
-        }
+    if (ieeeExponent == 0xFF || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+        return ma_number_write_special(buffer, negative, ieeeExponent == 0xFF && ieeeMantissa != 0, ieeeExponent == 0xFF);
     }
-    decodedStr[j] = '\0';
 
-    String* decodedStringObject = ma_string_create(decodedStr);
-    free(decodedStr);
+    uint64_t digits;
+    int32_t exponent;
+    ma_number_shortest_float(ieeeMantissa, ieeeExponent, &digits, &exponent);
+    return ma_number_write_decimal(buffer, negative, digits, exponent);
+}
 
-    return decodedStringObject;
+void ma_string_append_int64(String* str, int64_t value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_append_len(str, buffer, ma_string_write_int64(buffer, value));
 }
 
-void ma_string_format(String* str, const char* format, ...) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_format.\n");
-        return;
-    }
-    if (format == NULL) {
-        printf("Error: The format string is NULL in string_format.\n");
-        return;
-    }
-    // Start variadic argument processing
-    va_list args;
-    va_start(args, format);
+void ma_string_append_uint64(String* str, uint64_t value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_append_len(str, buffer, ma_string_write_uint64(buffer, value));
+}
 
-    // Calculate the required length of the result string
-    int length = vsnprintf(NULL, 0, format, args);
-    if (length < 0) {
-        printf("Error: vsnprintf failed in string_format.\n");
-        va_end(args);
-        return;
-    }
+void ma_string_append_double(String* str, double value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_append_len(str, buffer, ma_string_write_double(buffer, value));
+}
 
-    // Allocate memory for the formatted string
-    char* buffer = (char*)malloc(length + 1);
-    if (!buffer) {
-        printf("Error: Failed to allocate memory in string_format.\n");
-        va_end(args);
-        return;
-    }
+void ma_string_append_float(String* str, float value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_append_len(str, buffer, ma_string_write_float(buffer, value));
+}
 
-    // Actually format the string
-    vsnprintf(buffer, length + 1, format, args);
+// ------------------------------------------------------------------------- //
+//                             String hashing                                //
+// ------------------------------------------------------------------------- //
 
-    // Assign the formatted string to the String object
-    // Assuming you have a function like string_assign to replace the string's content
-    ma_string_assign(str, buffer);
+// wyhash (final version 4): 64-bit multiply-and-fold mixing, one 128-bit
+// product per 16 input bytes, three independent lanes for long inputs.
+static const uint64_t string_hash_secret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL,
+};
 
-    // Clean up
-    free(buffer);
-    va_end(args);
+static inline uint64_t ma_string_hash_mix(uint64_t a, uint64_t b) {
+    uint64_t high;
+    uint64_t low = ma_number_multiply(a, b, &high);
+    return low ^ high;
 }
 
-String* ma_ma_string_repeat(const String* str, size_t count) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_repeat.\n");
-        return NULL;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_repeat.\n");
-        return NULL;
-    }
+static inline uint64_t ma_string_hash_load4(const uint8_t *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
 
-    size_t newLength = str->size * count;
-    char* repeatedStr = (char*)malloc(newLength + 1);
+// Up to three bytes, each of them reaching the result whatever the length.
+static inline uint64_t ma_string_hash_load3(const uint8_t *p, size_t length) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+}
 
-    if (repeatedStr == NULL) {
-        printf("Failed to allocate memory in string_repeat\n");
-        return NULL;
+uint64_t ma_string_hash_seeded(const char* data, size_t length, uint64_t seed) {
+    if (data == NULL && length != 0) {
+        printf("Error: The data is NULL in string_hash.\n");
+        return 0;
     }
 
-    char* current = repeatedStr;
-    for (size_t i = 0; i < count; ++i) {
-        memcpy(current, str->dataStr, str->size);
-        current += str->size;
+    const uint8_t *p = (const uint8_t *)data;
+    const uint64_t *secret = string_hash_secret;
+    uint64_t a, b;
+    seed ^= ma_string_hash_mix(seed ^ secret[0], secret[1]);
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+            a = (ma_string_hash_load4(p) << 32) | ma_string_hash_load4(p + middle);
+            b = (ma_string_hash_load4(p + length - 4) << 32) | ma_string_hash_load4(p + length - 4 - middle);
+        }
+        else if (length > 0) {
+            a = ma_string_hash_load3(p, length);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t remaining = length;
+        if (remaining >= 48) {
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = ma_string_hash_mix(ma_number_load8((const char *)p) ^ secret[1], ma_number_load8((const char *)p + 8) ^ seed);
+                lane1 = ma_string_hash_mix(ma_number_load8((const char *)p + 16) ^ secret[2], ma_number_load8((const char *)p + 24) ^ lane1);
+                lane2 = ma_string_hash_mix(ma_number_load8((const char *)p + 32) ^ secret[3], ma_number_load8((const char *)p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining >= 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16) {
+            seed = ma_string_hash_mix(ma_number_load8((const char *)p) ^ secret[1], ma_number_load8((const char *)p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last 16 bytes of the input, overlapping what was already mixed
+        a = ma_number_load8((const char *)p + remaining - 16);
+        b = ma_number_load8((const char *)p + remaining - 8);
     }
-    *current = '\0';
 
-    String* result = ma_string_create(repeatedStr);
-    free(repeatedStr);
+    uint64_t high;
+    a = ma_number_multiply(a ^ secret[1], b ^ seed, &high);
+    b = high;
+    uint64_t hash = ma_string_hash_mix(a ^ secret[0] ^ length, b ^ secret[1]);
 
-    return result;
+    // Zero marks a String whose hash is not cached yet
+    return (hash != 0) ? hash : 1;
 }
 
-String* ma_string_join_variadic(size_t count, ...) {
-    va_list args;
-    va_start(args, count);
+uint64_t ma_string_hash_len(const char* data, size_t length) {
+    return ma_string_hash_seeded(data, length, 0);
+}
 
-    size_t totalLength = 0;
-    for (size_t i = 0; i < count; ++i) {
-        String* str = va_arg(args, String*);
-        totalLength += str->size;
+uint64_t ma_string_hash(String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_hash.\n");
+        return 0;
     }
-    va_end(args);
-
-    char* joinedStr = (char*)malloc(totalLength + 1);
-    if (joinedStr == NULL) {
-        perror("Failed to allocate memory in string_join_variadic");
-        return NULL;
+    if (str->hash == 0) {
+        str->hash = ma_string_hash_seeded(str->dataStr, str->size, 0);
     }
+    return str->hash;
+}
 
-    char* current = joinedStr;
-    va_start(args, count);
-    for (size_t i = 0; i < count; ++i) {
-        String* str = va_arg(args, String*);
+uint64_t ma_string_view_hash(StringView view) {
+    return ma_string_hash_seeded(view.data, view.size, 0);
+}
 
-        memcpy(current, str->dataStr, str->size);
-        current += str->size;
+void ma_string_invalidate_hash(String* str) {
+    if (str != NULL) {
+        str->hash = 0;
     }
-    *current = '\0';
-    va_end(args);
+}
 
-    String* result = ma_string_create(joinedStr);
-    free(joinedStr);
+// ------------------------------------------------------------------------- //
+//                               String rope                                 //
+// ------------------------------------------------------------------------- //
 
-    return result;
+static inline size_t ma_rope_height(const RopeNode *node) {
+    return node ? node->height : 0;
 }
 
-void ma_string_trim_characters(String* str, const char* chars) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_trim_characters.\n");
-        return;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_trim_characters.\n");
-        return;
-    }
-    if (chars == NULL) {
-        printf("Error: The chars parameter is NULL in string_trim_characters.\n");
-        return;
-    }
-    char* start = str->dataStr;
-    char* end = str->dataStr + str->size - 1;
+static inline bool ma_rope_is_leaf(const RopeNode *node) {
+    return node->left == NULL;
+}
+
+static inline char *ma_rope_leaf_data(RopeNode *node) {
+    return (char *)(node + 1);
+}
 
-    while (start <= end && strchr(chars, *start)) {
-        start++;
-    }
-    while (end > start && strchr(chars, *end)) {
-        end--;
+static RopeNode *ma_rope_node_alloc(const Allocator *allocator, size_t dataSize) {
+    RopeNode *node = ma_allocator_alloc_with(allocator, sizeof(RopeNode) + dataSize);
+    if (node == NULL) {
+        // A half-spliced tree cannot be handed back, so this mirrors the String constructors.
+        printf("Error: Memory allocation failed in rope_node_alloc.\n");
+        exit(-1);
     }
-    size_t newLength = end - start + 1;
+    node->left = NULL;
+    node->right = NULL;
+    node->length = 0;
+    node->height = 1;
+    return node;
+}
 
-    memmove(str->dataStr, start, newLength);
-    str->dataStr[newLength] = '\0';
-    str->size = newLength;
+static RopeNode *ma_rope_leaf_create(const Allocator *allocator, const char *data, size_t length) {
+    RopeNode *leaf = ma_rope_node_alloc(allocator, MA_ROPE_LEAF_SIZE);
+    memcpy(ma_rope_leaf_data(leaf), data, length);
+    leaf->length = length;
+    return leaf;
 }
 
-void ma_string_shuffle(String* str){
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_shuffle.\n");
-        return;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_shuffle.\n");
+static void ma_rope_node_update(RopeNode *node) {
+    size_t leftHeight = ma_rope_height(node->left);
+    size_t rightHeight = ma_rope_height(node->right);
+    node->length = node->left->length + node->right->length;
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+static RopeNode *ma_rope_branch_create(const Allocator *allocator, RopeNode *left, RopeNode *right) {
+    RopeNode *node = ma_rope_node_alloc(allocator, 0);
+    node->left = left;
+    node->right = right;
+    ma_rope_node_update(node);
+    return node;
+}
+
+static void ma_rope_node_free(const Allocator *allocator, RopeNode *node) {
+    if (node == NULL) {
         return;
     }
+    ma_rope_node_free(allocator, node->left);
+    ma_rope_node_free(allocator, node->right);
+    ma_allocator_free_with(allocator, node);
+}
 
-    srand(time(NULL));
-    size_t length = strlen(str->dataStr);
-    for (size_t i = length - 1; i > 0; i--) {
-        size_t j = rand() % (i + 1);
+static RopeNode *ma_rope_rotate_left(RopeNode *node) {
+    RopeNode *pivot = node->right;
+    node->right = pivot->left;
+    ma_rope_node_update(node);
+    pivot->left = node;
+    ma_rope_node_update(pivot);
+    return pivot;
+}
 
-        // Swap characters at positions i and j
-        char temp = str->dataStr[i];
-        str->dataStr[i] = str->dataStr[j];
-        str->dataStr[j] = temp;
+static RopeNode *ma_rope_rotate_right(RopeNode *node) {
+    RopeNode *pivot = node->left;
+    node->left = pivot->right;
+    ma_rope_node_update(node);
+    pivot->right = node;
+    ma_rope_node_update(pivot);
+    return pivot;
+}
+
+// Restores the AVL invariant of a branch whose children differ in height by at most two.
+static RopeNode *ma_rope_rebalance(RopeNode *node) {
+    ma_rope_node_update(node);
+    size_t leftHeight = ma_rope_height(node->left);
+    size_t rightHeight = ma_rope_height(node->right);
+
+    if (leftHeight > rightHeight + 1) {
+        if (ma_rope_height(node->left->left) < ma_rope_height(node->left->right)) {
+            node->left = ma_rope_rotate_left(node->left);
+        }
+        return ma_rope_rotate_right(node);
     }
+    if (rightHeight > leftHeight + 1) {
+        if (ma_rope_height(node->right->right) < ma_rope_height(node->right->left)) {
+            node->right = ma_rope_rotate_right(node->right);
+        }
+        return ma_rope_rotate_left(node);
+    }
+    return node;
 }
 
-void ma_string_to_title(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_to_title.\n");
-        return;
+// Concatenates two trees, taking ownership of both. The shorter tree is hung
+// off the spine of the taller one at a matching height, so the cost is the
+// difference in heights. Adjacent leaves that fit together are merged, which
+// keeps many small edits from fragmenting the text into tiny leaves.
+static RopeNode *ma_rope_concat(const Allocator *allocator, RopeNode *left, RopeNode *right) {
+    if (left == NULL) {
+        return right;
     }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_to_title.\n");
-        return;
+    if (right == NULL) {
+        return left;
+    }
+    if (ma_rope_is_leaf(left) && ma_rope_is_leaf(right) && left->length + right->length <= MA_ROPE_LEAF_SIZE) {
+        memcpy(ma_rope_leaf_data(left) + left->length, ma_rope_leaf_data(right), right->length);
+        left->length += right->length;
+        ma_allocator_free_with(allocator, right);
+        return left;
     }
 
-    bool capitalize = true;
-    for (size_t i = 0; i < str->size; i++) {
-        if (capitalize && isalpha(str->dataStr[i])) {
-            str->dataStr[i] = toupper(str->dataStr[i]);
-            capitalize = false;
-        }
-        else if (!isalpha(str->dataStr[i])) {
-            capitalize = true;
-        }
-        else {
-            str->dataStr[i] = tolower(str->dataStr[i]);
-        }
+    if (left->height > right->height + 1) {
+        left->right = ma_rope_concat(allocator, left->right, right);
+        return ma_rope_rebalance(left);
     }
+    if (right->height > left->height + 1) {
+        right->left = ma_rope_concat(allocator, left, right->left);
+        return ma_rope_rebalance(right);
+    }
+    return ma_rope_branch_create(allocator, left, right);
 }
 
-void ma_string_to_capitalize(String* str) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_to_capitalize.\n");
+// Cuts a tree into the bytes before `pos` and the bytes from `pos` on.
+static void ma_rope_split(const Allocator *allocator, RopeNode *node, size_t pos, RopeNode **left, RopeNode **right) {
+    if (node == NULL || pos == 0) {
+        *left = NULL;
+        *right = node;
         return;
     }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_to_capitalize.\n");
+    if (pos >= node->length) {
+        *left = node;
+        *right = NULL;
         return;
     }
-    if (str->size == 0) {
-        printf("Error: The size of String object is zero in string_to_capitalize.\n");
+
+    if (ma_rope_is_leaf(node)) {
+        *right = ma_rope_leaf_create(allocator, ma_rope_leaf_data(node) + pos, node->length - pos);
+        node->length = pos;
+        *left = node;
         return;
     }
-    str->dataStr[0] = toupper(str->dataStr[0]);
-}
 
-void ma_string_to_casefold(String* str) {
-     if (str == NULL || str->dataStr == NULL) {
-        printf("Error: Invalid string input in string_to_casefold.\n");
-        return;
+    RopeNode *leftChild = node->left;
+    RopeNode *rightChild = node->right;
+    ma_allocator_free_with(allocator, node);
+
+    if (pos < leftChild->length) {
+        RopeNode *middle;
+        ma_rope_split(allocator, leftChild, pos, left, &middle);
+        *right = ma_rope_concat(allocator, middle, rightChild);
     }
-    for (size_t i = 0; i < str->size; i++) {
-        str->dataStr[i] = tolower(str->dataStr[i]);
+    else {
+        RopeNode *middle;
+        ma_rope_split(allocator, rightChild, pos - leftChild->length, &middle, right);
+        *left = ma_rope_concat(allocator, leftChild, middle);
     }
 }
 
-bool ma_string_starts_with(const String* str, const char* substr) {
-    if (str == NULL) {
-        printf("Error: The String object is NULL in string_starts_with.\n");
-        return false;
+// Builds a perfectly balanced tree of full leaves over `length` bytes.
+static RopeNode *ma_rope_build(const Allocator *allocator, const char *data, size_t length) {
+    if (length == 0) {
+        return NULL;
     }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_starts_with.\n");
-        return false;
+    if (length <= MA_ROPE_LEAF_SIZE) {
+        return ma_rope_leaf_create(allocator, data, length);
     }
-    if (substr == NULL) {
-        printf("Error: The substring is NULL in string_starts_with.\n");
-        return false;
+
+    size_t leafCount = (length + MA_ROPE_LEAF_SIZE - 1) / MA_ROPE_LEAF_SIZE;
+    size_t leftLength = (leafCount / 2) * MA_ROPE_LEAF_SIZE;
+    return ma_rope_branch_create(allocator, ma_rope_build(allocator, data, leftLength), ma_rope_build(allocator, data + leftLength, length - leftLength));
+}
+
+Rope* ma_rope_create_len(const char* data, size_t length) {
+    if (data == NULL && length != 0) {
+        printf("Error: The data is NULL in rope_create.\n");
+        return NULL;
     }
 
-    size_t substrLen = strlen(substr);
-    if (substrLen > str->size) {
-        return false;
+    const Allocator *allocator = ma_allocator_get();
+    Rope *rope = ma_allocator_alloc_with(allocator, sizeof(Rope));
+    if (rope == NULL) {
+        printf("Error: Memory allocation failed in rope_create.\n");
+        return NULL;
     }
-    return strncmp(str->dataStr, substr, substrLen) == 0;
+    rope->allocator = allocator;
+    rope->root = ma_rope_build(allocator, data, length);
+    return rope;
 }
 
-bool ma_string_ends_with(const String* str, const char* substr) {
+Rope* ma_rope_create(const char* initialStr) {
+    return ma_rope_create_len(initialStr, initialStr ? strlen(initialStr) : 0);
+}
+
+Rope* ma_rope_from_string(const String* str) {
     if (str == NULL) {
-        printf("Error: The String object is NULL in string_ends_with.\n");
-        return false;
-    }
-    if (str->dataStr == NULL) {
-        printf("Error: The dataStr of String object is NULL in string_ends_with.\n");
-        return false;
-    }
-    if (substr == NULL) {
-        printf("Error: The substring is NULL in string_ends_with.\n");
-        return false;
+        printf("Error: The String object is NULL in rope_from_string.\n");
+        return NULL;
     }
+    return ma_rope_create_len(str->dataStr, str->size);
+}
 
-    size_t substrLen = strlen(substr);
-    size_t strLen = str->size;
-    if (substrLen > strLen) {
-        return false;
+void ma_rope_destroy(Rope* rope) {
+    if (rope == NULL) {
+        return;
     }
+    ma_rope_node_free(rope->allocator, rope->root);
+    ma_allocator_free_with(rope->allocator, rope);
+}
 
-    return strncmp(str->dataStr + strLen - substrLen, substr, substrLen) == 0;
+size_t ma_rope_length(const Rope* rope) {
+    return (rope == NULL || rope->root == NULL) ? 0 : rope->root->length;
 }
 
-void ma_string_swap_case(String* str) {
-    if (str == NULL) {
-        printf("Error: str is NULL in string_swap_case\n");
+void ma_rope_insert_len(Rope* rope, size_t pos, const char* data, size_t length) {
+    if (rope == NULL) {
+        printf("Error: The Rope object is NULL in rope_insert.\n");
         return;
     }
-    if (str->dataStr == NULL) {
-        printf("Error: str->dataStr is NULL in string_swap_case\n");
+    if (data == NULL && length != 0) {
+        printf("Error: The data is NULL in rope_insert.\n");
+        return;
+    }
+    if (pos > ma_rope_length(rope)) {
+        printf("Error: Position out of bounds in rope_insert.\n");
+        return;
+    }
+    if (length == 0) {
         return;
     }
 
-    for (size_t i = 0; i < str->size; i++) {
-        if (islower(str->dataStr[i])) {
-            str->dataStr[i] = toupper(str->dataStr[i]);
+    // Most edits land in a leaf with room to spare: shift the leaf's tail and
+    // fix up the lengths on the path, without touching the shape of the tree.
+    RopeNode *path[MA_ROPE_MAX_DEPTH];
+    size_t depth = 0;
+    RopeNode *node = rope->root;
+    size_t offset = pos;
+    while (node && !ma_rope_is_leaf(node)) {
+        path[depth++] = node;
+        if (offset <= node->left->length) {
+            node = node->left;
         }
-        else if (isupper(str->dataStr[i])) {
-            str->dataStr[i] = tolower(str->dataStr[i]);
+        else {
+            offset -= node->left->length;
+            node = node->right;
         }
     }
-}
 
-wchar_t* ma_string_to_unicode(const char* str) {
-    if (str == NULL) {
-        printf("Error: Input string is NULL in string_to_unicode.\n");
-        return NULL;
+    if (node && node->length + length <= MA_ROPE_LEAF_SIZE) {
+        char *leafData = ma_rope_leaf_data(node);
+        memmove(leafData + offset + length, leafData + offset, node->length - offset);
+        memcpy(leafData + offset, data, length);
+        node->length += length;
+        while (depth != 0) {
+            path[--depth]->length += length;
+        }
+        return;
     }
-    // Calculate the length of the wide string
-    size_t len = mbstowcs(NULL, str, 0) + 1;
-    if (len == (size_t)-1) {
-        printf("Error: Conversion failed in string_to_unicode.\n");
-        return NULL;
+
+    RopeNode *left;
+    RopeNode *right;
+    ma_rope_split(rope->allocator, rope->root, pos, &left, &right);
+    rope->root = ma_rope_concat(rope->allocator, ma_rope_concat(rope->allocator, left, ma_rope_build(rope->allocator, data, length)), right);
+}
+
+void ma_rope_insert(Rope* rope, size_t pos, const char* strItem) {
+    if (strItem == NULL) {
+        printf("Error: The strItem is NULL in rope_insert.\n");
+        return;
     }
-    wchar_t* wstr = malloc(len * sizeof(wchar_t));
-    if (!wstr) {
-        printf("Error: Memory allocation failed in string_to_unicode.\n");
-        return NULL;
+    ma_rope_insert_len(rope, pos, strItem, strlen(strItem));
+}
+
+void ma_rope_insert_string(Rope* rope, size_t pos, const String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in rope_insert_string.\n");
+        return;
     }
+    ma_rope_insert_len(rope, pos, str->dataStr, str->size);
+}
 
-    mbstowcs(wstr, str, len);
-    return wstr;
+void ma_rope_append_len(Rope* rope, const char* data, size_t length) {
+    ma_rope_insert_len(rope, ma_rope_length(rope), data, length);
 }
 
-String* ma_string_from_unicode(const wchar_t* wstr) {
-    if (wstr == NULL) {
-        printf("Error: Input wide string is NULL in string_from_unicode.\n");
-        return NULL;
+void ma_rope_erase(Rope* rope, size_t pos, size_t len) {
+    if (rope == NULL) {
+        printf("Error: The Rope object is NULL in rope_erase.\n");
+        return;
     }
-    // Calculate the length of the string
-    size_t len = wcstombs(NULL, wstr, 0);
-    if (len == (size_t)-1) {
-        printf("Error: Conversion failed in string_from_unicode.\n");
-        return NULL;
+    size_t size = ma_rope_length(rope);
+    if (pos >= size) {
+        printf("Error: Position out of bounds in rope_erase.\n");
+        return;
+    }
+    if (len > size - pos) {
+        len = size - pos;  // Adjust len to not go beyond the rope end
     }
 
-    char* str = malloc(len + 1); // +1 for null terminator
-    if (!str) {
-        printf("Error: Memory allocation failed in string_from_unicode.\n");
-        return NULL;
+    RopeNode *path[MA_ROPE_MAX_DEPTH];
+    size_t depth = 0;
+    RopeNode *node = rope->root;
+    size_t offset = pos;
+    while (!ma_rope_is_leaf(node)) {
+        path[depth++] = node;
+        if (offset < node->left->length) {
+            node = node->left;
+        }
+        else {
+            offset -= node->left->length;
+            node = node->right;
+        }
     }
-    wcstombs(str, wstr, len + 1); // Convert and include the null terminator
 
-    String* stringObj = ma_string_create(str);
-    free(str); // Free the temporary char* buffer
+    // A range inside one leaf that leaves it non-empty is erased in place.
+    if (offset + len <= node->length && len < node->length) {
+        char *leafData = ma_rope_leaf_data(node);
+        memmove(leafData + offset, leafData + offset + len, node->length - offset - len);
+        node->length -= len;
+        while (depth != 0) {
+            path[--depth]->length -= len;
+        }
+        return;
+    }
 
-    return stringObj;
+    RopeNode *left;
+    RopeNode *middle;
+    RopeNode *right;
+    ma_rope_split(rope->allocator, rope->root, pos, &left, &middle);
+    ma_rope_split(rope->allocator, middle, len, &middle, &right);
+    ma_rope_node_free(rope->allocator, middle);
+    rope->root = ma_rope_concat(rope->allocator, left, right);
 }
 
-String** ma_string_create_from_initializer(size_t count, ...) {
-    if (count == 0) {
-        printf("Error: count is zero in string_create_from_initializer.\n");
-        return NULL;
+char ma_rope_at(const Rope* rope, size_t index) {
+    if (rope == NULL || index >= ma_rope_length(rope)) {
+        printf("Error: Index out of bounds in rope_at.\n");
+        return '\0';
     }
 
-    va_list args;
-    va_start(args, count);
+    RopeNode *node = rope->root;
+    while (!ma_rope_is_leaf(node)) {
+        if (index < node->left->length) {
+            node = node->left;
+        }
+        else {
+            index -= node->left->length;
+            node = node->right;
+        }
+    }
+    return ma_rope_leaf_data(node)[index];
+}
 
-    // Allocate memory for the array of String pointers
-    String** strings = (String**)malloc(sizeof(String*) * (count + 1)); // +1 for NULL termination
-    if (!strings) {
-        printf("Error: Memory allocation failed for strings array in string_create_from_initializer.\n");
-        va_end(args);
-        return NULL;
+void ma_rope_iterator_init(RopeIterator* it, const Rope* rope, size_t pos) {
+    if (it == NULL) {
+        printf("Error: The iterator is NULL in rope_iterator_init.\n");
+        return;
     }
 
-    // Create each string and add it to the array
-    for (size_t i = 0; i < count; i++) {
-        char* str = va_arg(args, char*);
-        strings[i] = ma_string_create(str);
-        if (!strings[i]) {
-            printf("Error: string_create failed for string: %s in string_create_from_initializer.\n", str);
+    it->depth = 0;
+    it->leaf = NULL;
+    it->offset = 0;
+    if (rope == NULL || pos >= ma_rope_length(rope)) {
+        return;
+    }
 
-            // Handle allocation failure: cleanup and exit
-            for (size_t j = 0; j < i; j++) {
-                ma_string_deallocate(strings[j]);
-            }
-            free(strings);
-            va_end(args);
-            return NULL;
+    // Every right subtree passed on the way down is still to be visited.
+    RopeNode *node = rope->root;
+    while (!ma_rope_is_leaf(node)) {
+        if (pos < node->left->length) {
+            it->stack[it->depth++] = node->right;
+            node = node->left;
+        }
+        else {
+            pos -= node->left->length;
+            node = node->right;
         }
     }
-
-    // Null-terminate the array
-    strings[count] = NULL;
-
-    va_end(args);
-    return strings;
+    it->leaf = node;
+    it->offset = pos;
 }
 
-char* ma_string_strdup(const char* s)
-{
-    if (s == NULL) {
-        printf("Error: Parameter 's' is NULL in string_strdup.\n");
-        return NULL;
+bool ma_rope_iterator_next(RopeIterator* it, const char** data, size_t* length) {
+    if (it == NULL || data == NULL || length == NULL) {
+        printf("Error: NULL argument in rope_iterator_next.\n");
+        return false;
     }
 
-    char* new_str = malloc(strlen(s) + 1);
-    if (new_str == NULL) {
-        printf("Error: Memory allocation failed in string_strdup for string: %s\n", s);
-        return NULL;
+    if (it->leaf == NULL) {
+        if (it->depth == 0) {
+            return false;
+        }
+        RopeNode *node = it->stack[--it->depth];
+        while (!ma_rope_is_leaf(node)) {
+            it->stack[it->depth++] = node->right;
+            node = node->left;
+        }
+        it->leaf = node;
+        it->offset = 0;
     }
-    strcpy(new_str, s);
 
-    return new_str;
+    *data = ma_rope_leaf_data(it->leaf) + it->offset;
+    *length = it->leaf->length - it->offset;
+    it->leaf = NULL;
+    return true;
 }
 
-size_t ma_string_length_cstr(const char* str) {
-    if (!str) {
-        printf("Error: str is null in string_length_cstr.\n");
-        return 0;
+// Copies `len` bytes starting at `pos` into `out`.
+static void ma_rope_copy(const Rope *rope, size_t pos, size_t len, char *out) {
+    RopeIterator it;
+    const char *chunk;
+    size_t chunkLength;
+
+    ma_rope_iterator_init(&it, rope, pos);
+    while (len != 0 && ma_rope_iterator_next(&it, &chunk, &chunkLength)) {
+        size_t n = (chunkLength < len) ? chunkLength : len;
+        memcpy(out, chunk, n);
+        out += n;
+        len -= n;
     }
-    return (size_t)strlen(str);
 }
 
-size_t ma_string_length_utf8(const char* str) {
-    if (!str) {
-        printf("Error: str is null in string_length_cstr.\n");
-        return 0;
+String* ma_rope_substr(const Rope* rope, size_t pos, size_t len) {
+    if (rope == NULL) {
+        printf("Error: The Rope object is NULL in rope_substr.\n");
+        return NULL;
     }
-    size_t length = 0;
-
-    while (*str) {
-        if ((*str & 0xC0) != 0x80) {
-            length++;
-        }
-        str++;
+    size_t size = ma_rope_length(rope);
+    if (pos > size) {
+        printf("Error: Position out of bounds in rope_substr.\n");
+        return NULL;
+    }
+    if (len > size - pos) {
+        len = size - pos;
     }
-    return length;
-}
 
-bool ma_string_to_bool_from_cstr(const char* boolstr) {
-    if (!boolstr) {
-        printf("Error: bool str is NULL and invalid in string_to_bool_cstr.\n");
-        return false;
+    String *result = ma_string_create("");
+    if (result == NULL) {
+        return NULL;
     }
-
-    if (strcmp(boolstr, "true") == 0) {
-        return true;
-    } else if (strcmp(boolstr, "false") == 0) {
-        return false;
+    if (!ma_string_reserve(result, len + 1)) {
+        ma_string_deallocate(result);
+        return NULL;
     }
 
-    return false;
+    ma_rope_copy(rope, pos, len, result->dataStr);
+    result->dataStr[len] = '\0';
+    result->size = len;
+    return result;
 }
 
-size_t ma_string_utf8_char_len(char c) {
-    if ((c & 0x80) == 0) {
-        return 1;
-    }
+String* ma_rope_to_string(const Rope* rope) {
+    return ma_rope_substr(rope, 0, ma_rope_length(rope));
+}
 
-    if ((c & 0xE0) == 0xC0) {
-        return 2;
+// Compares `length` bytes of the rope, starting at `pos`, with `data`.
+static bool ma_rope_equals_at(const Rope *rope, size_t pos, const char *data, size_t length) {
+    RopeIterator it;
+    const char *chunk;
+    size_t chunkLength;
+
+    ma_rope_iterator_init(&it, rope, pos);
+    while (length != 0 && ma_rope_iterator_next(&it, &chunk, &chunkLength)) {
+        size_t n = (chunkLength < length) ? chunkLength : length;
+        if (memcmp(chunk, data, n) != 0) {
+            return false;
+        }
+        data += n;
+        length -= n;
     }
+    return length == 0;
+}
 
-    if ((c & 0xF0) == 0xE0) {
-        return 3;
+size_t ma_rope_find_len(const Rope* rope, const char* needle, size_t needleLength, size_t pos) {
+    if (rope == NULL || (needle == NULL && needleLength != 0)) {
+        printf("Error: NULL argument in rope_find.\n");
+        return MA_STRING_NPOS;
+    }
+    size_t size = ma_rope_length(rope);
+    if (pos > size || needleLength > size - pos) {
+        return MA_STRING_NPOS;
+    }
+    if (needleLength == 0) {
+        return pos;
     }
 
-    if ((c & 0xF8) == 0xF0) {
-        return 4;
+    // Matches inside a leaf go through the String search engine. Only the
+    // last needleLength - 1 starts of each leaf can run into the next ones;
+    // those are filtered on the first byte and compared across the chunks.
+    RopeIterator it;
+    const char *chunk;
+    size_t chunkLength;
+    size_t base = pos;
+
+    ma_rope_iterator_init(&it, rope, pos);
+    while (ma_rope_iterator_next(&it, &chunk, &chunkLength)) {
+        const char *found = ma_string_search(chunk, chunkLength, needle, needleLength);
+        if (found) {
+            return base + (size_t)(found - chunk);
+        }
+
+        size_t start = (chunkLength >= needleLength) ? chunkLength - needleLength + 1 : 0;
+        for (size_t i = start; i < chunkLength; i++) {
+            if (base + i + needleLength > size) {
+                return MA_STRING_NPOS;
+            }
+            if (chunk[i] == needle[0] && ma_rope_equals_at(rope, base + i, needle, needleLength)) {
+                return base + i;
+            }
+        }
+        base += chunkLength;
     }
+    return MA_STRING_NPOS;
+}
 
-    return 0;
+size_t ma_rope_find(const Rope* rope, const char* needle, size_t pos) {
+    if (needle == NULL) {
+        printf("Error: The needle is NULL in rope_find.\n");
+        return MA_STRING_NPOS;
+    }
+    return ma_rope_find_len(rope, needle, strlen(needle), pos);
 }
 
 // ------------------------------------------------------------------------- //
@@ -3779,7 +8573,7 @@ FileWriter* file_writer_open(const char* filename, const WriteMode mode) {
         exit(-1);
     }
 
-    FileWriter* writer = (FileWriter*) malloc(sizeof(FileWriter));
+    FileWriter* writer = (FileWriter*) ma_object_slab_allocate(OBJECT_SLAB_FILE_WRITER, sizeof(FileWriter));
     if (!writer) {
         printf("Error: Can not allocate memory for FileWriter in file_writer_open.\n");
         exit(-1);
@@ -3838,15 +8632,15 @@ FileWriter* file_writer_open(const char* filename, const WriteMode mode) {
             exit(-1);
         }
         writer->file_writer = _wfopen(wFileName, wMode);
-        free(wMode);
-        free(wFileName);
+        ma_allocator_free(wMode);
+        ma_allocator_free(wFileName);
     #else
         writer->file_writer = fopen(filename, modeStr);
     #endif
 
     if (writer->file_writer == NULL) {
         printf("Error: Can not open file in file_writer_open.\n");
-        free(writer);
+        ma_object_slab_free(OBJECT_SLAB_FILE_WRITER, writer);
         exit(-1);
     }
 
@@ -3865,7 +8659,7 @@ FileWriter* ma_file_writer_append(const char *filename, const WriteMode mode) {
         return NULL;
     }
 
-    FileWriter* writer = (FileWriter*) malloc(sizeof(FileWriter));
+    FileWriter* writer = (FileWriter*) ma_object_slab_allocate(OBJECT_SLAB_FILE_WRITER, sizeof(FileWriter));
     if (!writer) {
         printf("Error: Can not allocate memory for FileWriter in file_writer_open.\n");
         return NULL;
@@ -3919,15 +8713,15 @@ FileWriter* ma_file_writer_append(const char *filename, const WriteMode mode) {
         }
 
         writer->file_writer = _wfopen(wFileName, wMode);
-        free(wMode);
-        free(wFileName);
+        ma_allocator_free(wMode);
+        ma_allocator_free(wFileName);
     #else
         writer->file_writer = fopen(filename, modeStr);
     #endif
 
     if (writer->file_writer == NULL) {
         printf("Error: Can not open file in file_writer_open.\n");
-        free(writer);
+        ma_object_slab_free(OBJECT_SLAB_FILE_WRITER, writer);
         return NULL;
     }
 
@@ -3948,7 +8742,14 @@ bool ma_file_writer_close(FileWriter *writer) {
         printf("Error: Failed to close file in file_writer_close.\n");
         return false;
     }
+
+    if (writer->file_path) {
+        ma_allocator_free(writer->file_path);
+        writer->file_path = NULL;
+    }
+
     writer->is_open = false;
+    ma_object_slab_free(OBJECT_SLAB_FILE_WRITER, writer); // Release the FileWriter object itself
     return true;
 }
 
@@ -3991,7 +8792,7 @@ size_t ma_file_writer_write(void *buffer, size_t size, size_t count, FileWriter
                 return 0;
             }
             written = fwrite(utf32Buffer, sizeof(uint32_t), wcslen((wchar_t*)utf32Buffer), writer->file_writer);
-            free(utf32Buffer);
+            ma_allocator_free(utf32Buffer);
             break;
         }
 
@@ -4005,7 +8806,7 @@ size_t ma_file_writer_write(void *buffer, size_t size, size_t count, FileWriter
                     return 0;
                 }
                 written = fwrite(wBuffer, sizeof(wchar_t), wcslen(wBuffer), writer->file_writer);
-                free(wBuffer);
+                ma_allocator_free(wBuffer);
             }
             else {
                 // For non-Unicode modes, write directly
@@ -4020,7 +8821,7 @@ size_t ma_file_writer_write(void *buffer, size_t size, size_t count, FileWriter
                     return 0;
                 }
                 written = fwrite(utf16Buffer, sizeof(uint16_t), wcslen((wchar_t*)utf16Buffer), writer->file_writer);
-                free(utf16Buffer);
+                ma_allocator_free(utf16Buffer);
             }
             else {
                 // For non-Unicode modes, write directly
@@ -4063,7 +8864,7 @@ bool ma_file_writer_write_line(char *buffer, size_t size, FileWriter *writer) {
 
             elementToWriteSize = wcslen(wBuffer);
             written = fwrite(wBuffer, sizeof(wchar_t), elementToWriteSize, writer->file_writer);
-            free(wBuffer);
+            ma_allocator_free(wBuffer);
         } else {
             written = fwrite(buffer, sizeof(char), elementToWriteSize, writer->file_writer);
         }
@@ -4447,7 +9248,7 @@ bool ma_file_writer_write_batch(FileWriter* writer, const void** buffers, const
 
         // Write the buffer to the file
         written = fwrite(convertedBuffer, 1, convertedSize, writer->file_writer);
-        free(convertedBuffer);
+        ma_allocator_free(convertedBuffer);
 
         if (written != convertedSize) {
             printf("Error: Partial or failed write in file_writer_write_batch at index %zu.\n", i);
@@ -4494,7 +9295,7 @@ FileReader* ma_file_reader_open(const char* filename, const ReadMode mode) {
         exit(-1);
     }
 
-    FileReader* reader = (FileReader*) malloc(sizeof(FileReader));
+    FileReader* reader = (FileReader*) ma_object_slab_allocate(OBJECT_SLAB_FILE_READER, sizeof(FileReader));
     if (!reader) {
         
         exit(-1);
@@ -4544,15 +9345,15 @@ FileReader* ma_file_reader_open(const char* filename, const ReadMode mode) {
         exit(-1);
     }
     reader->file_reader = _wfopen(wFileName, wMode);
-    free(wMode);
-    free(wFileName);
+    ma_allocator_free(wMode);
+    ma_allocator_free(wFileName);
     #else 
     reader->file_reader = fopen(filename, modeStr);
     #endif 
 
     if (reader->file_reader == NULL) {
         
-        free(reader);
+        ma_object_slab_free(OBJECT_SLAB_FILE_READER, reader);
         exit(-1);
     }
     reader->mode = mode;
@@ -4585,12 +9386,12 @@ bool ma_file_reader_close(FileReader *reader) {
     }
     
     if (reader->file_path) {
-        free(reader->file_path);
+        ma_allocator_free(reader->file_path);
         reader->file_path = NULL;
     }
 
     reader->is_open = false;
-    free(reader); // Optionally free the FileReader object itself if it's dynamically allocated
+    ma_object_slab_free(OBJECT_SLAB_FILE_READER, reader); // Release the FileReader object itself
     
     
     return true;
@@ -4816,7 +9617,7 @@ size_t ma_file_reader_read(void* buffer, size_t size, size_t count, FileReader*
 
     // For Unicode (UTF-16) reading, handle conversion to UTF-8
     if (reader->mode == READ_UNICODE) {
-        wchar_t* rawBuffer = (wchar_t*)malloc(sizeof(wchar_t) * (count + 1)); // Buffer for UTF-16 data
+        wchar_t* rawBuffer = (wchar_t*)ma_allocator_alloc(sizeof(wchar_t) * (count + 1)); // Buffer for UTF-16 data
         if (!rawBuffer) {
             
             return 0;
@@ -4827,7 +9628,7 @@ size_t ma_file_reader_read(void* buffer, size_t size, size_t count, FileReader*
 
         // Convert UTF-16 to UTF-8
         char* utf8Buffer = (char*) ma_encoding_utf16_to_utf8((uint16_t*)rawBuffer, actualRead);
-        free(rawBuffer);
+        ma_allocator_free(rawBuffer);
 
         if (!utf8Buffer) {
             
@@ -4840,7 +9641,7 @@ size_t ma_file_reader_read(void* buffer, size_t size, size_t count, FileReader*
         size_t bytesToCopy = (utf8Length < count * size) ? utf8Length : count * size - 1;
         memcpy(buffer, utf8Buffer, bytesToCopy);
         ((char*)buffer)[bytesToCopy] = '\0'; // Null-terminate the output buffer
-        free(utf8Buffer);
+        ma_allocator_free(utf8Buffer);
 
         
         return bytesToCopy;
@@ -4884,7 +9685,7 @@ bool ma_file_reader_read_line(char* buffer, size_t size, FileReader* reader) {
 
         strncpy(buffer, utf8Buffer, size - 1);
         buffer[size - 1] = '\0';
-        free(utf8Buffer);
+        ma_allocator_free(utf8Buffer);
 
         
     } 
@@ -4940,7 +9741,7 @@ size_t ma_file_reader_read_fmt(FileReader* reader, const char* format, ...) {
     size_t read = vsscanf(utf8Buffer, format, args);
 
     va_end(args);
-    free(utf8Buffer);
+    ma_allocator_free(utf8Buffer);
 
     
     return read; 
@@ -4988,7 +9789,7 @@ bool ma_file_reader_copy(FileReader* src_reader, FileWriter* dest_writer) {
         // Write the UTF-8 data to the destination file
         bytesToWrite = utf8BufferSize;
         size_t bytesWritten = ma_file_writer_write(utf8Buffer, sizeof(char), bytesToWrite, dest_writer);
-        free(utf8Buffer);
+        ma_allocator_free(utf8Buffer);
 
         if (bytesWritten < bytesToWrite) {
             
@@ -5026,7 +9827,7 @@ bool ma_file_reader_read_lines(FileReader* reader, char*** buffer, size_t num_li
         return false;
     }
 
-    *buffer = (char**) malloc(num_lines * sizeof(char*));
+    *buffer = (char**) ma_allocator_alloc(num_lines * sizeof(char*));
     if (!*buffer) {
         
         return false;
@@ -5042,9 +9843,9 @@ bool ma_file_reader_read_lines(FileReader* reader, char*** buffer, size_t num_li
                 
                 // Free previously allocated lines
                 for (size_t i = 0; i < lines_read; ++i) {
-                    free((*buffer)[i]);
+                    ma_allocator_free((*buffer)[i]);
                 }
-                free(*buffer);
+                ma_allocator_free(*buffer);
                 return false;
             }
             
@@ -5065,12 +9866,386 @@ bool ma_file_reader_read_lines(FileReader* reader, char*** buffer, size_t num_li
     return lines_read == num_lines;
 }
 
+// ------------------------------------------------------------------------- //
+//                            String builder                                 //
+// ------------------------------------------------------------------------- //
+
+static StringBuilder *ma_string_builder_create_internal(size_t chunkSize, FileWriter *writer) {
+    const Allocator *allocator = ma_allocator_get();
+    StringBuilder *builder = ma_allocator_alloc_with(allocator, sizeof(StringBuilder));
+    if (builder == NULL) {
+        printf("Error: Memory allocation failed in string_builder_create.\n");
+        return NULL;
+    }
+
+    builder->head = NULL;
+    builder->tail = NULL;
+    builder->size = 0;
+    builder->nextChunkSize = (chunkSize != 0) ? chunkSize : MA_STRING_BUILDER_CHUNK_SIZE;
+    builder->writer = writer;
+    builder->allocator = allocator;
+    builder->failed = false;
+    return builder;
+}
+
+StringBuilder* ma_string_builder_create(size_t sizeHint) {
+    return ma_string_builder_create_internal(sizeHint, NULL);
+}
+
+StringBuilder* ma_string_builder_create_for_writer(FileWriter* writer, size_t chunkSize) {
+    if (writer == NULL) {
+        printf("Error: The FileWriter is NULL in string_builder_create_for_writer.\n");
+        return NULL;
+    }
+    return ma_string_builder_create_internal(chunkSize, writer);
+}
+
+void ma_string_builder_destroy(StringBuilder* builder) {
+    if (builder == NULL) {
+        return;
+    }
+
+    StringBuilderChunk *chunk = builder->head;
+    while (chunk) {
+        StringBuilderChunk *next = chunk->next;
+        ma_allocator_free_with(builder->allocator, chunk);
+        chunk = next;
+    }
+    ma_allocator_free_with(builder->allocator, builder);
+}
+
+// Chains a chunk with room for at least `required` bytes. Chunks double in
+// size up to MA_STRING_BUILDER_MAX_CHUNK_SIZE, so the number of chunks stays
+// logarithmic in small outputs and nothing is ever copied to make room.
+static StringBuilderChunk *ma_string_builder_add_chunk(StringBuilder *builder, size_t required) {
+    size_t capacity = (builder->nextChunkSize > required) ? builder->nextChunkSize : required;
+    StringBuilderChunk *chunk = ma_allocator_alloc_with(builder->allocator, sizeof(StringBuilderChunk) + capacity);
+    if (chunk == NULL) {
+        printf("Error: Memory allocation failed in string_builder_add_chunk.\n");
+        return NULL;
+    }
+
+    chunk->next = NULL;
+    chunk->size = 0;
+    chunk->capacity = capacity;
+    if (builder->tail) {
+        builder->tail->next = chunk;
+    }
+    else {
+        builder->head = chunk;
+    }
+    builder->tail = chunk;
+
+    if (builder->writer == NULL && builder->nextChunkSize < MA_STRING_BUILDER_MAX_CHUNK_SIZE) {
+        builder->nextChunkSize *= 2;
+    }
+    return chunk;
+}
+
+static inline char *ma_string_builder_chunk_data(StringBuilderChunk *chunk) {
+    return (char *)(chunk + 1);
+}
+
+// Writes bytes to the builder's FileWriter and returns how many of them were
+// written. Writers that convert to UTF-16 or UTF-32 count encoded units rather
+// than input bytes, so for them only a write that fails outright shows.
+static size_t ma_string_builder_write(StringBuilder *builder, const char *data, size_t length) {
+    FileWriter *writer = builder->writer;
+    size_t written = ma_file_writer_write((void *)data, 1, length, writer);
+    if (written != 0 && writer->mode != WRITE_BINARY &&
+        (writer->encoding == WRITE_ENCODING_UTF16 || writer->encoding == WRITE_ENCODING_UTF32)) {
+        return length;
+    }
+    return (written < length) ? written : length;
+}
+
+// Hands the single chunk of a writer-backed builder to its FileWriter. On a
+// failed or short write the unwritten bytes stay buffered, so a later flush
+// can retry them.
+static bool ma_string_builder_drain(StringBuilder *builder) {
+    StringBuilderChunk *chunk = builder->tail;
+    if (chunk == NULL || chunk->size == 0) {
+        return true;
+    }
+
+    char *data = ma_string_builder_chunk_data(chunk);
+    size_t written = ma_string_builder_write(builder, data, chunk->size);
+    if (written < chunk->size) {
+        printf("Error: Writing to the FileWriter failed in string_builder_drain.\n");
+        memmove(data, data + written, chunk->size - written);
+        chunk->size -= written;
+        return false;
+    }
+    chunk->size = 0;
+    return true;
+}
+
+// Records bytes that could be neither buffered nor written, so they are not
+// counted in the length and the next flush reports the loss.
+static void ma_string_builder_fail(StringBuilder *builder, size_t lost) {
+    builder->size -= lost;
+    builder->failed = true;
+}
+
+bool ma_string_builder_reserve(StringBuilder* builder, size_t size) {
+    if (builder == NULL) {
+        printf("Error: The StringBuilder is NULL in string_builder_reserve.\n");
+        return false;
+    }
+
+    StringBuilderChunk *tail = builder->tail;
+    if (tail && tail->capacity - tail->size >= size) {
+        return true;
+    }
+    if (builder->writer && tail) {
+        // Writer-backed builders keep their one chunk, so room is only made
+        // by draining it.
+        return ma_string_builder_drain(builder) && tail->capacity >= size;
+    }
+    return ma_string_builder_add_chunk(builder, size) != NULL;
+}
+
+void ma_string_builder_append_len(StringBuilder* builder, const char* data, size_t length) {
+    if (builder == NULL) {
+        printf("Error: The StringBuilder is NULL in string_builder_append.\n");
+        return;
+    }
+    if (data == NULL && length != 0) {
+        printf("Error: The data is NULL in string_builder_append.\n");
+        return;
+    }
+
+    builder->size += length;
+    while (length != 0) {
+        StringBuilderChunk *tail = builder->tail;
+        size_t room = tail ? tail->capacity - tail->size : 0;
+
+        if (room == 0) {
+            if (builder->writer == NULL) {
+                tail = ma_string_builder_add_chunk(builder, length);
+            }
+            else if (tail == NULL) {
+                tail = ma_string_builder_add_chunk(builder, 0);
+            }
+            else if (!ma_string_builder_drain(builder)) {
+                ma_string_builder_fail(builder, length);
+                return;
+            }
+            else if (length >= tail->capacity) {
+                size_t written = ma_string_builder_write(builder, data, length);
+                if (written < length) {
+                    printf("Error: Writing to the FileWriter failed in string_builder_append.\n");
+                    ma_string_builder_fail(builder, length - written);
+                }
+                return;
+            }
+            if (tail == NULL) {
+                ma_string_builder_fail(builder, length);
+                return;
+            }
+            room = tail->capacity - tail->size;
+        }
+
+        size_t n = (length < room) ? length : room;
+        memcpy(ma_string_builder_chunk_data(tail) + tail->size, data, n);
+        tail->size += n;
+        data += n;
+        length -= n;
+    }
+}
+
+void ma_string_builder_append(StringBuilder* builder, const char* str) {
+    if (str == NULL) {
+        printf("Error: The string is NULL in string_builder_append.\n");
+        return;
+    }
+    ma_string_builder_append_len(builder, str, strlen(str));
+}
+
+void ma_string_builder_append_string(StringBuilder* builder, const String* str) {
+    if (str == NULL) {
+        printf("Error: The String object is NULL in string_builder_append_string.\n");
+        return;
+    }
+    ma_string_builder_append_len(builder, str->dataStr, str->size);
+}
+
+void ma_string_builder_append_char(StringBuilder* builder, char c) {
+    ma_string_builder_append_len(builder, &c, 1);
+}
+
+void ma_string_builder_append_int64(StringBuilder* builder, int64_t value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_builder_append_len(builder, buffer, ma_string_write_int64(buffer, value));
+}
+
+void ma_string_builder_append_double(StringBuilder* builder, double value) {
+    char buffer[MA_STRING_NUMBER_BUFFER_SIZE];
+    ma_string_builder_append_len(builder, buffer, ma_string_write_double(buffer, value));
+}
+
+void ma_string_builder_append_format(StringBuilder* builder, const char* format, ...) {
+    if (builder == NULL || format == NULL) {
+        printf("Error: The StringBuilder or the format is NULL in string_builder_append_format.\n");
+        return;
+    }
+
+    // Formats straight into the free space of the last chunk, and only
+    // formats a second time, into a chunk of the exact size, when it is short.
+    va_list args;
+    va_start(args, format);
+    StringBuilderChunk *tail = builder->tail;
+    size_t room = tail ? tail->capacity - tail->size : 0;
+    char scratch[1];
+    int length = vsnprintf(room ? ma_string_builder_chunk_data(tail) + tail->size : scratch, room ? room : 1, format, args);
+    va_end(args);
+    if (length < 0) {
+        printf("Error: vsnprintf failed in string_builder_append_format.\n");
+        return;
+    }
+    if ((size_t)length < room) {
+        tail->size += (size_t)length;
+        builder->size += (size_t)length;
+        return;
+    }
+
+    char local[256];
+    char *buffer = ((size_t)length < sizeof(local)) ? local : ma_allocator_alloc_with(builder->allocator, (size_t)length + 1);
+    if (buffer == NULL) {
+        printf("Error: Memory allocation failed in string_builder_append_format.\n");
+        builder->failed = true;
+        return;
+    }
+    va_start(args, format);
+    vsnprintf(buffer, (size_t)length + 1, format, args);
+    va_end(args);
+
+    ma_string_builder_append_len(builder, buffer, (size_t)length);
+    if (buffer != local) {
+        ma_allocator_free_with(builder->allocator, buffer);
+    }
+}
+
+void ma_string_builder_append_join(StringBuilder* builder, String** strings, size_t count, const char* delimiter, size_t delimiterLength) {
+    if (builder == NULL || (strings == NULL && count != 0) || (delimiter == NULL && delimiterLength != 0)) {
+        printf("Error: NULL argument in string_builder_append_join.\n");
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    size_t total = delimiterLength * (count - 1);
+    for (size_t i = 0; i < count; i++) {
+        if (strings[i] == NULL) {
+            printf("Error: NULL argument in string_builder_append_join.\n");
+            return;
+        }
+        total += strings[i]->size;
+    }
+    ma_string_builder_reserve(builder, total);
+
+    for (size_t i = 0; i < count; i++) {
+        if (i != 0) {
+            ma_string_builder_append_len(builder, delimiter, delimiterLength);
+        }
+        ma_string_builder_append_len(builder, strings[i]->dataStr, strings[i]->size);
+    }
+}
+
+void ma_string_builder_append_repeat(StringBuilder* builder, const char* data, size_t length, size_t count) {
+    if (builder == NULL || (data == NULL && length != 0)) {
+        printf("Error: NULL argument in string_builder_append_repeat.\n");
+        return;
+    }
+    if (length != 0 && count > SIZE_MAX / length) {
+        printf("Error: The result is too large in string_builder_append_repeat.\n");
+        return;
+    }
+
+    ma_string_builder_reserve(builder, length * count);
+    for (size_t i = 0; i < count; i++) {
+        ma_string_builder_append_len(builder, data, length);
+    }
+}
+
+size_t ma_string_builder_length(const StringBuilder* builder) {
+    return (builder == NULL) ? 0 : builder->size;
+}
+
+String* ma_string_builder_to_string(const StringBuilder* builder) {
+    if (builder == NULL) {
+        printf("Error: The StringBuilder is NULL in string_builder_to_string.\n");
+        return NULL;
+    }
+    if (builder->writer) {
+        printf("Error: The StringBuilder writes to a FileWriter in string_builder_to_string.\n");
+        return NULL;
+    }
+
+    String *result = ma_string_create("");
+    if (result == NULL) {
+        return NULL;
+    }
+    if (!ma_string_reserve(result, builder->size + 1)) {
+        ma_string_deallocate(result);
+        return NULL;
+    }
+
+    char *out = result->dataStr;
+    for (StringBuilderChunk *chunk = builder->head; chunk; chunk = chunk->next) {
+        memcpy(out, ma_string_builder_chunk_data(chunk), chunk->size);
+        out += chunk->size;
+    }
+    *out = '\0';
+    result->size = builder->size;
+    return result;
+}
+
+bool ma_string_builder_flush(StringBuilder* builder) {
+    if (builder == NULL || builder->writer == NULL) {
+        printf("Error: The StringBuilder has no FileWriter in string_builder_flush.\n");
+        return false;
+    }
+
+    // A loss is reported once; bytes still buffered after a failed write are
+    // kept and reported again by the next flush that cannot write them.
+    bool lost = builder->failed;
+    builder->failed = false;
+    return ma_string_builder_drain(builder) && !lost;
+}
+
+void ma_string_builder_clear(StringBuilder* builder) {
+    if (builder == NULL) {
+        return;
+    }
+
+    // The first chunk is kept for the next round of appends.
+    StringBuilderChunk *chunk = builder->head ? builder->head->next : NULL;
+    while (chunk) {
+        StringBuilderChunk *next = chunk->next;
+        ma_allocator_free_with(builder->allocator, chunk);
+        chunk = next;
+    }
+    if (builder->head) {
+        builder->head->next = NULL;
+        builder->head->size = 0;
+    }
+    builder->tail = builder->head;
+    builder->size = 0;
+    builder->failed = false;
+}
+
 // ------------------------------------------------------------------------- //
 //                  CPP vector implementation in C                           //
 // ------------------------------------------------------------------------- //
 
 Vector* ma_vector_create(size_t itemSize) {
-    Vector* vec = (Vector*)malloc(sizeof(Vector));
+    return ma_vector_create_aligned(itemSize, MA_MEMORY_POOL_ALIGN_CACHE_LINE);
+}
+
+Vector* ma_vector_create_aligned(size_t itemSize, size_t alignment) {
+    Vector* vec = (Vector*)ma_object_slab_allocate(OBJECT_SLAB_VECTOR, sizeof(Vector));
 
     if (!vec){
         #ifdef VECTOR_LOGGING_ENABLE
@@ -5082,11 +10257,12 @@ Vector* ma_vector_create(size_t itemSize) {
     vec->size = 0;
     vec->capacitySize = 32; // Initial capacity
     vec->itemSize = itemSize;
+    vec->alignment = alignment;
 
     size_t initialPoolSize = 100000;
     vec->pool = ma_vector_memory_pool_create(initialPoolSize);
     if (!vec->pool) {
-        free(vec);
+        ma_object_slab_free(OBJECT_SLAB_VECTOR, vec);
         #ifdef VECTOR_LOGGING_ENABLE
             printf("Can not allocate memory for Vector pool");
         #endif
@@ -5094,15 +10270,56 @@ Vector* ma_vector_create(size_t itemSize) {
     }
 
     // Instead of malloc, use memory pool for initial allocation
-    vec->items = ma_vector_memory_pool_allocate(vec->pool, vec->capacitySize * itemSize);
+    vec->items = ma_vector_memory_pool_allocate_aligned(vec->pool, vec->capacitySize * itemSize, alignment);
     if (!vec->items) {
         ma_vector_memory_pool_destroy(vec->pool);
-        free(vec);
+        ma_object_slab_free(OBJECT_SLAB_VECTOR, vec);
         #ifdef VECTOR_LOGGING_ENABLE
             printf("Error: Can not allocate memory for Vector items");
         #endif
         exit(-1);
     }
+    vec->ownsPool = true;
+    vec->headerPool = NULL;
+
+    return vec;
+}
+
+// Header and items are allocated from `pool`, which the caller keeps alive for
+// the lifetime of the vector and may rewind or reset to release it in bulk.
+Vector* ma_vector_create_with_pool(size_t itemSize, MemoryPoolVector* pool) {
+    if (!pool) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Memory pool is NULL in vector_create_with_pool.\n");
+        #endif
+        return NULL;
+    }
+
+    Vector* vec = ma_vector_memory_pool_allocate(pool, sizeof(Vector));
+    if (!vec) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Can not allocate memory for Vector structure in vector_create_with_pool.\n");
+        #endif
+        return NULL;
+    }
+
+    vec->size = 0;
+    vec->capacitySize = 32; // Initial capacity
+    vec->itemSize = itemSize;
+    vec->alignment = MA_MEMORY_POOL_ALIGN_CACHE_LINE;
+    vec->pool = pool;
+    vec->ownsPool = false;
+    vec->headerPool = pool;
+
+    vec->items = ma_vector_memory_pool_allocate_aligned(pool, vec->capacitySize * itemSize, vec->alignment);
+    if (!vec->items) {
+        ma_vector_memory_pool_free(pool, vec, sizeof(Vector));
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Can not allocate memory for Vector items in vector_create_with_pool.\n");
+        #endif
+        return NULL;
+    }
+
     return vec;
 }
 
@@ -5242,7 +10459,7 @@ void ma_vector_insert(Vector *vec, size_t pos, void *item) {
     if (vec->size == vec->capacitySize) {
         // Allocate new space from the memory pool
         size_t newCapacity = vec->capacitySize * 2; // Double the capacity
-        void *newItems = ma_vector_memory_pool_allocate(vec->pool, newCapacity * vec->itemSize);
+        void *newItems = ma_vector_memory_pool_allocate_aligned(vec->pool, newCapacity * vec->itemSize, vec->alignment);
 
         if (!newItems) {
             #ifdef VECTOR_LOGGING_ENABLE
@@ -5257,8 +10474,14 @@ void ma_vector_insert(Vector *vec, size_t pos, void *item) {
                (char *)vec->items + pos * vec->itemSize,
                (vec->size - pos) * vec->itemSize); // Copy elements after insertion position
 
+        // Place the item before releasing the old block, it may point into it
+        memcpy((char *)newItems + pos * vec->itemSize, item, vec->itemSize);
+        ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
+
         vec->items = newItems;
         vec->capacitySize = newCapacity;
+        vec->size++;
+        return;
     }
     else {
         char *base = (char *)vec->items;  // Shift elements to make space for the new element
@@ -5283,7 +10506,7 @@ bool ma_vector_reserve(Vector *vec, size_t size) {
         return true;
     }
 
-    void *newItems = ma_vector_memory_pool_allocate(vec->pool, size * vec->itemSize);
+    void *newItems = ma_vector_memory_pool_allocate_aligned(vec->pool, size * vec->itemSize, vec->alignment);
     if (!newItems) {
         #ifdef VECTOR_LOGGING_ENABLE
             printf("Error: Failed to allocate memory for vector_reserve.\n");
@@ -5293,12 +10516,25 @@ bool ma_vector_reserve(Vector *vec, size_t size) {
     if (vec->size > 0) {
         memcpy(newItems, vec->items, vec->size * vec->itemSize);
     }
+    ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
 
     vec->items = newItems;
     vec->capacitySize = size;
     return true;
 }
 
+bool ma_vector_set_pool_growth(Vector *vec, size_t growthFactor, size_t maxChunkSize) {
+    if (!vec) {
+        #ifdef VECTOR_LOGGING_ENABLE
+            printf("Error: Vector is NULL in vector_set_pool_growth.\n");
+        #endif
+        return false;
+    }
+
+    ma_vector_memory_pool_set_growth(vec->pool, growthFactor, maxChunkSize);
+    return true;
+}
+
 void ma_vector_resize(Vector *vec, size_t size) {
     if (!vec) {
         #ifdef VECTOR_LOGGING_ENABLE
@@ -5327,14 +10563,14 @@ void ma_vector_shrink_to_fit(Vector *vec) {
     }
 
     if (vec->size == 0) {
-        free(vec->items); // Assuming this memory is not part of the pool
+        ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
         vec->items = NULL;
         vec->capacitySize = 0;
 
         return;
     }
 
-    void *newItems = ma_vector_memory_pool_allocate(vec->pool, vec->size * vec->itemSize);
+    void *newItems = ma_vector_memory_pool_allocate_aligned(vec->pool, vec->size * vec->itemSize, vec->alignment);
     if (!newItems) {
         #ifdef VECTOR_LOGGING_ENABLE
             printf("Error: Failed to allocate memory for vector_shrink_to_fit.\n");
@@ -5343,6 +10579,7 @@ void ma_vector_shrink_to_fit(Vector *vec) {
     }
 
     memcpy(newItems, vec->items, vec->size * vec->itemSize);
+    ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
     vec->items = newItems;
     vec->capacitySize = vec->size;
 }
@@ -5370,6 +10607,19 @@ void ma_vector_swap(Vector *vec1, Vector *vec2) {
     size_t tempItemSize = vec1->itemSize;
     vec1->itemSize = vec2->itemSize;
     vec2->itemSize = tempItemSize;
+
+    size_t tempAlignment = vec1->alignment;
+    vec1->alignment = vec2->alignment;
+    vec2->alignment = tempAlignment;
+
+    // The items live in their pool, so the pools are swapped along with them
+    MemoryPoolVector *tempPool = vec1->pool;
+    vec1->pool = vec2->pool;
+    vec2->pool = tempPool;
+
+    bool tempOwnsPool = vec1->ownsPool;
+    vec1->ownsPool = vec2->ownsPool;
+    vec2->ownsPool = tempOwnsPool;
 }
 
 void ma_vector_assign(Vector *vec, size_t pos, void *item) {
@@ -5449,7 +10699,7 @@ bool ma_vector_push_back(Vector *vec, const void *item) {
     if (vec->size >= vec->capacitySize) {
         size_t newCapacity = vec->capacitySize * 2; // Example growth strategy
         // Allocate new space from the memory pool
-        void *newItems = ma_vector_memory_pool_allocate(vec->pool, newCapacity * vec->itemSize);
+        void *newItems = ma_vector_memory_pool_allocate_aligned(vec->pool, newCapacity * vec->itemSize, vec->alignment);
         if (!newItems) {
             #ifdef VECTOR_LOGGING_ENABLE
                 printf("Error: Failed to allocate memory in vector_push_back.\n");
@@ -5458,8 +10708,13 @@ bool ma_vector_push_back(Vector *vec, const void *item) {
         }
 
         memcpy(newItems, vec->items, vec->size * vec->itemSize); // Copy existing items to the new space
+        memcpy((char *)newItems + (vec->size * vec->itemSize), item, vec->itemSize); // The item may point into the old block
+        ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
         vec->items = newItems;
         vec->capacitySize = newCapacity;
+        vec->size++;
+
+        return true;
     }
 
     // Proceed with adding the new item
@@ -5477,15 +10732,21 @@ void ma_vector_deallocate(Vector *vec) {
         return; // Handle the error as per your application's needs
     }
 
-    if (vec->pool != NULL) {
+    if (vec->pool != NULL && vec->ownsPool) {
         ma_vector_memory_pool_destroy(vec->pool);
-        vec->pool = NULL;
     }
+    else if (vec->pool != NULL) {
+        ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
+    }
+    vec->pool = NULL;
+    vec->items = NULL;   // The items are part of the pool, so no need to free them separately
 
-    if (vec->items != NULL) {
-        vec->items = NULL;   // The items are part of the pool, so no need to free them separately
+    if (vec->headerPool != NULL) {
+        ma_vector_memory_pool_free(vec->headerPool, vec, sizeof(Vector));
+    }
+    else {
+        ma_object_slab_free(OBJECT_SLAB_VECTOR, vec);
     }
-    free(vec);
 }
 
 void *vector_at(const Vector *vec, size_t pos) {
@@ -5648,8 +10909,9 @@ void ma_vector_clear(Vector *vec) {
     // Optionally reduce capacity. Choose an appropriate size for your use case.
     size_t reducedCapacity = 4; // Or some other small size
     if (vec->capacitySize > reducedCapacity) {
-        void *newItems = ma_vector_memory_pool_allocate(vec->pool, reducedCapacity * vec->itemSize);
+        void *newItems = ma_vector_memory_pool_allocate_aligned(vec->pool, reducedCapacity * vec->itemSize, vec->alignment);
         if (newItems != NULL || reducedCapacity == 0) {
+            ma_vector_memory_pool_free(vec->pool, vec->items, vec->capacitySize * vec->itemSize);
             vec->items = newItems;
             vec->capacitySize = reducedCapacity;
         }
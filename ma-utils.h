@@ -28,31 +28,198 @@
 #include <stdint.h>
 #include <locale.h>
 
+// ------------------------------------------------------------------------- //
+//                              Allocator                                    //
+// ------------------------------------------------------------------------- //
+
+// Every heap allocation of the library goes through an Allocator: the calling
+// thread's override when one is installed, the process-wide allocator
+// otherwise. Install the process-wide allocator before any other call, and use
+// a thread override to route some calls to another allocator such as a
+// per-request arena.
+//
+// Memory pools, Ropes and StringBuilders remember the allocator current when
+// they are created and release everything through it, whatever is current
+// when they are destroyed.
+//
+// Plain buffers handed to the caller (ma_string_to_upper, ma_string_to_lower,
+// ma_string_strdup, the encoders, the lines of ma_file_reader_read_lines, ...)
+// come from the allocator current at the call. Unlike earlier versions, they
+// are only malloc blocks while the default allocator is in use, so passing
+// them to free() breaks as soon as another allocator is installed. Release
+// them with ma_allocator_free_with and the allocator they were created with,
+// or with ma_allocator_free while that allocator is still current.
+typedef struct Allocator {
+    void* (*alloc)(void* context, size_t size);
+    void* (*realloc)(void* context, void* ptr, size_t size);
+    void (*free)(void* context, void* ptr);
+    void* context;                  // Passed back to every callback
+} Allocator;
+
+const Allocator* ma_allocator_default(void);                                       // Returns the malloc based allocator used until another one is installed.
+const Allocator* ma_allocator_get(void);                                           // Returns the allocator used by the calling thread.
+const Allocator* ma_allocator_set_thread(const Allocator* allocator);              // Overrides the allocator on the calling thread, NULL removes the override. Returns the previous override.
+void ma_allocator_set(const Allocator* allocator);                                 // Installs the process-wide allocator, NULL restores the default. It must outlive its use.
+
+void* ma_allocator_alloc(size_t size);                                             // Allocates through the current allocator.
+void* ma_allocator_realloc(void* ptr, size_t size);                                // Resizes a block obtained from the current allocator.
+void ma_allocator_free(void* ptr);                                                 // Releases a block obtained from the current allocator, including library results.
+
+void* ma_allocator_alloc_with(const Allocator* allocator, size_t size);            // Allocates through the given allocator.
+void* ma_allocator_realloc_with(const Allocator* allocator, void* ptr, size_t size); // Resizes a block obtained from the given allocator.
+void ma_allocator_free_with(const Allocator* allocator, void* ptr);                // Releases a block obtained from the given allocator, whatever the current one is.
+
+// ------------------------------------------------------------------------- //
+//                             Object slab                                   //
+// ------------------------------------------------------------------------- //
+
+// String, Vector, FileReader and FileWriter headers are not malloc'd one by
+// one: they are carved out of blocks holding this many headers of a type and
+// recycled through per-thread free lists. The blocks come from the process-wide
+// allocator, and the headers a thread still holds when it exits are handed to
+// the other threads.
+#define MA_OBJECT_SLAB_BLOCK_OBJECTS 64
+
 // ------------------------------------------------------------------------- //
 //                           Memory pool                                     //
 // ------------------------------------------------------------------------- //
 
+// Pools never run out: when the current chunk is full a new one is chained
+// in front of it, each chunk `growthFactor` times larger than the previous
+// (capped at `maxChunkSize` when it is not zero).
+#define MA_MEMORY_POOL_GROWTH_FACTOR 2
+
+// Allocations are rounded up to power-of-two size classes starting at
+// 1 << MA_MEMORY_POOL_MIN_CLASS_SHIFT bytes. Blocks handed back with the
+// pool's free function are kept on a per-class free list and reused by the
+// next allocation of the same class. Requests above the largest class are
+// bump-allocated as-is and are not recycled.
+#define MA_MEMORY_POOL_MIN_CLASS_SHIFT 4
+#define MA_MEMORY_POOL_SIZE_CLASSES 32
+
+// Every pool allocation is aligned to at least MA_MEMORY_POOL_MIN_ALIGNMENT
+// bytes. The aligned allocators take any power of two on top of that, and
+// MA_MEMORY_POOL_ALIGN_CACHE_LINE selects the cache line size so that blocks
+// written by different threads never share a line.
+#define MA_MEMORY_POOL_MIN_ALIGNMENT 16
+#define MA_MEMORY_POOL_CACHE_LINE_SIZE 64
+#define MA_MEMORY_POOL_ALIGN_CACHE_LINE 0
+
+// Where a pool takes its chunks from. Pools created with the `_reserved`
+// constructors use the mmap backends: the first chunk reserves the whole size
+// up front without costing resident memory, and resetting such a pool hands
+// its pages back to the kernel.
+typedef enum {
+    MEMORY_POOL_BACKEND_HEAP,     // Chunks are malloc'd and freed with the pool
+    MEMORY_POOL_BACKEND_GLOBAL,   // Chunks are refill blocks of the process-wide region, released with it
+    MEMORY_POOL_BACKEND_MMAP,     // Chunks are reserved with mmap and committed page by page on first touch
+    MEMORY_POOL_BACKEND_MMAP_HUGE, // Like MEMORY_POOL_BACKEND_MMAP, backed by transparent huge pages when available
+} MemoryPoolBackend;
+
+// Boundary huge page chunks are aligned to, the x86-64 and AArch64 huge page size.
+#define MA_MEMORY_POOL_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Size of the blocks a thread takes from the process-wide region at a time.
+// The region comes from the process-wide allocator, never a thread override.
+// Refill blocks are not returned when their thread exits: Strings allocated in
+// them may outlive the thread, so they stay part of the region until
+// ma_string_destroy_global_memory_pool releases it.
+#define MA_MEMORY_POOL_GLOBAL_REFILL_SIZE (64 * 1024)
+
+typedef struct MemoryPoolChunk MemoryPoolChunk;
+struct MemoryPoolChunk {
+    MemoryPoolChunk *next;   // Previously filled chunk
+    size_t size;             // Usable bytes in this chunk
+    size_t used;             // Bytes handed out from this chunk
+};
+
+// Counters kept by every pool. Rounding to size classes shows up as the gap
+// between `bytesAllocated` and `bytesRequested`; `wastedBytes` are bytes the
+// pool can no longer hand out: alignment padding, chunk tails abandoned when a
+// request did not fit, and oversized blocks given back. Process-wide totals
+// are only collected when the library is built with MEMORY_POOL_STATS_ENABLE.
+typedef struct MemoryPoolStats {
+    size_t allocations;       // Blocks handed out
+    size_t frees;             // Blocks handed back
+    size_t bytesRequested;    // Bytes asked for
+    size_t bytesAllocated;    // Bytes handed out after rounding to size classes
+    size_t liveBytes;         // Bytes handed out and not yet given back
+    size_t wastedBytes;       // Bytes lost to padding, abandoned chunk tails and unrecycled blocks
+    size_t highWaterMark;     // Peak of the pool's `used`, of the live bytes for the global totals
+    size_t exhaustions;       // Times the current chunk was full and another one was chained
+} MemoryPoolStats;
+
+MemoryPoolStats ma_memory_pool_global_stats(void);                                          // Returns the totals over every pool, zero without MEMORY_POOL_STATS_ENABLE.
+void ma_memory_pool_stats_dump(FILE* stream, const char* name, const MemoryPoolStats* stats); // Prints the counters on a single line.
+void ma_memory_pool_set_stats_dump(bool enable);                                             // Dumps the counters of every pool to stderr when it is destroyed.
+
+// Checkpoint of a pool. Rewinding to it releases, in O(1) per chunk, every
+// allocation made after the mark was taken; chunks that become unused are kept
+// as spares and reused before new memory is requested. Free lists are emptied
+// by a rewind, and objects allocated after the mark must not be touched again.
+typedef struct MemoryPoolMark {
+    MemoryPoolChunk *chunk;   // Current chunk when the mark was taken
+    size_t chunkUsed;         // Bytes used in that chunk
+    size_t used;              // Bytes used in the whole pool
+    size_t liveBytes;         // Live bytes of the pool's statistics
+    size_t wastedBytes;       // Wasted bytes of the pool's statistics
+} MemoryPoolMark;
+
 // Vector memory pool
 typedef struct MemoryPoolVector {
-    void *pool;        // Pointer to the memory pool
-    size_t poolSize;   // Total size of the pool
-    size_t used;       // Memory used so far
+    void *pool;               // Pointer to the memory of the current chunk
+    size_t poolSize;          // Total size of all chunks in the pool
+    size_t used;              // Memory used so far
+    MemoryPoolChunk *chunks;  // Current chunk, older chunks are chained behind it
+    size_t nextChunkSize;     // Size of the next chunk to chain
+    size_t growthFactor;      // Multiplier applied to the chunk size on every growth
+    size_t maxChunkSize;      // Upper bound for the chunk size, 0 for no bound
+    void *freeLists[MA_MEMORY_POOL_SIZE_CLASSES]; // Released blocks, one list per size class
+    MemoryPoolBackend backend; // Where chunks come from
+    MemoryPoolChunk *spareChunks; // Chunks released by a rewind, reused before growing
+    MemoryPoolStats stats;    // Allocation counters
+    const Allocator *allocator; // Allocator current at creation, the pool and its heap chunks are released through it
 } MemoryPoolVector;
 
 
-static MemoryPoolVector *ma_vector_memory_pool_create(size_t size);
-static void *ma_vector_memory_pool_allocate(MemoryPoolVector *pool, size_t size);
-static void ma_vector_memory_pool_destroy(MemoryPoolVector *pool);
+MemoryPoolVector *ma_vector_memory_pool_create(size_t size);
+MemoryPoolVector *ma_vector_memory_pool_create_reserved(size_t reserveSize, bool hugePages);
+void *ma_vector_memory_pool_allocate(MemoryPoolVector *pool, size_t size);
+void *ma_vector_memory_pool_allocate_aligned(MemoryPoolVector *pool, size_t size, size_t alignment);
+void ma_vector_memory_pool_free(MemoryPoolVector *pool, void *ptr, size_t size);
+void ma_vector_memory_pool_set_growth(MemoryPoolVector *pool, size_t growthFactor, size_t maxChunkSize);
+MemoryPoolStats ma_vector_memory_pool_stats(const MemoryPoolVector *pool);
+MemoryPoolMark ma_vector_memory_pool_mark(MemoryPoolVector *pool);
+void ma_vector_memory_pool_rewind(MemoryPoolVector *pool, MemoryPoolMark mark);
+void ma_vector_memory_pool_reset(MemoryPoolVector *pool);
+void ma_vector_memory_pool_destroy(MemoryPoolVector *pool);
 
 // String memory pool
 typedef struct MemoryPoolString {
-    void *pool;        // Pointer to the memory pool
-    size_t poolSize;   // Total size of the pool
-    size_t used;       // Memory used so far
+    void *pool;               // Pointer to the memory of the current chunk
+    size_t poolSize;          // Total size of all chunks in the pool
+    size_t used;              // Memory used so far
+    MemoryPoolChunk *chunks;  // Current chunk, older chunks are chained behind it
+    size_t nextChunkSize;     // Size of the next chunk to chain
+    size_t growthFactor;      // Multiplier applied to the chunk size on every growth
+    size_t maxChunkSize;      // Upper bound for the chunk size, 0 for no bound
+    void *freeLists[MA_MEMORY_POOL_SIZE_CLASSES]; // Released blocks, one list per size class
+    MemoryPoolBackend backend; // Where chunks come from
+    MemoryPoolChunk *spareChunks; // Chunks released by a rewind, reused before growing
+    MemoryPoolStats stats;    // Allocation counters
+    const Allocator *allocator; // Allocator current at creation, the pool and its heap chunks are released through it
 } MemoryPoolString;
 
 MemoryPoolString* ma_string_memory_pool_create(size_t size);
+MemoryPoolString* ma_string_memory_pool_create_reserved(size_t reserveSize, bool hugePages);
 void* ma_string_memory_pool_allocate(MemoryPoolString *pool, size_t size);
+void* ma_string_memory_pool_allocate_aligned(MemoryPoolString *pool, size_t size, size_t alignment);
+void ma_string_memory_pool_free(MemoryPoolString *pool, void *ptr, size_t size);
+void ma_string_memory_pool_set_growth(MemoryPoolString *pool, size_t growthFactor, size_t maxChunkSize);
+MemoryPoolStats ma_string_memory_pool_stats(const MemoryPoolString *pool);
+MemoryPoolMark ma_string_memory_pool_mark(MemoryPoolString *pool);
+void ma_string_memory_pool_rewind(MemoryPoolString *pool, MemoryPoolMark mark);
+void ma_string_memory_pool_reset(MemoryPoolString *pool);
 void ma_string_memory_pool_destroy(MemoryPoolString *pool);
 
 // ------------------------------------------------------------------------ //
@@ -132,6 +299,32 @@ extern const char* STRING_HEXDIGITS;
 extern const char* STRING_WHITESPACE;
 extern const char* STRING_PUNCTUATION;
 
+// First chunk size of the per-thread arena used in arena mode.
+#define MA_STRING_ARENA_CHUNK_SIZE (64 * 1024)
+
+// Contents shorter than MA_STRING_INLINE_CAPACITY bytes (terminator included)
+// are stored in the String header itself; no pool memory is touched until they
+// outgrow it, and a String created with ma_string_create only gets its own pool
+// of MA_STRING_OWNED_POOL_SIZE bytes at that point.
+#define MA_STRING_INLINE_CAPACITY 24
+#define MA_STRING_OWNED_POOL_SIZE 1000000
+
+// Default factor a String's capacity is multiplied by when its contents outgrow it.
+#define MA_STRING_GROWTH_FACTOR 2
+
+// Needles at least this long are searched with the Two-Way algorithm, which is
+// linear in the worst case; shorter ones go through the SIMD byte filter.
+#define MA_STRING_TWO_WAY_THRESHOLD 256
+
+// Returned by the find functions when there is no match.
+#define MA_STRING_NPOS ((size_t)-1)
+
+typedef enum {
+    STRING_POOL_OWNED,    // The String owns its pool and destroys it on deallocation
+    STRING_POOL_SHARED,   // The pool is shared, buffers are handed back to it on deallocation
+    STRING_POOL_GLOBAL,   // Process-wide pool, every thread allocates from its own refill blocks (pool is NULL)
+} StringPoolKind;
+
 typedef struct String String;
 struct String
 {
@@ -139,6 +332,10 @@ struct String
     size_t size;
     size_t capacitySize;
     MemoryPoolString* pool;
+    StringPoolKind poolKind;
+    MemoryPoolString* headerPool;   // Pool holding this header, NULL when the header comes from the object slab
+    uint64_t hash;                  // Cached ma_string_hash of the contents, 0 until computed
+    char inlineStr[MA_STRING_INLINE_CAPACITY]; // Storage of short contents, dataStr points here while they fit
 };
 
 char ma_string_at(String* str, size_t index);                                           //
@@ -147,13 +344,18 @@ double ma_string_to_double(String* str);
 wchar_t* ma_string_to_unicode(const char* str);                                         //
 
 String* ma_string_create(const char* initialStr);                                       // Creates a new String object with an initial value.
+String* ma_string_create_len(const char* initialStr, size_t length);                    // Creates a String from `length` bytes, which may contain NUL bytes.
 String* ma_string_create_with_pool(size_t size);                                        // Creates a new String object with a specified memory pool size.
+String* ma_string_create_in_pool(MemoryPoolString* pool, const char* initialStr);        // Creates a String whose header and data live in a caller-owned pool.
+void ma_string_init_global_memory_pool(size_t size);                                    // Creates the process-wide pool used by string_create_with_pool, safe to race.
+void ma_string_destroy_global_memory_pool(void);                                        // Releases the process-wide pool once no thread uses pooled Strings anymore.
+MemoryPoolString* ma_string_thread_arena(void);                                         // Returns the calling thread's shared String arena, creating it on first use.
 String* ma_string_substr(String* str, size_t pos, size_t len);                          // Creates a substring from a String object.
 String** ma_string_split(String *str, const char *delimiter, int *count);               // Splits a String into an array of String objects.
 String* ma_string_join(String **strings, int count, const char *delimiter);             // Joins several String objects into one.
 String* ma_string_from_int(int value);                                                  // Creates a String from an integer.
-String* ma_string_from_float(float value);                                              // Creates a String from a float.
-String* ma_string_from_double(double value);                                            // Creates a String from a double.
+String* ma_string_from_float(float value);                                              // Creates a String from the shortest text that reads back as the same float.
+String* ma_string_from_double(double value);                                            // Creates a String from the shortest text that reads back as the same double.
 String** ma_string_tokenize(String* str, const char* delimiters, int* count);           // Splits a string into tokens based on multiple delimiters.
 String* ma_string_from_unicode(const wchar_t* wstr);                                    // Converts a wide string back to a regular string.
 String** ma_string_create_from_initializer(size_t count, ...);                          // The string_create_from_initializer function dynamically creates an array of String pointers, each initialized with a string passed as a variadic argument.
@@ -176,14 +378,19 @@ bool ma_string_is_lower(String* str);
 bool ma_string_is_upper(String* str);                                                   // Checks if all characters in a String are uppercase.
 bool ma_string_empty(String* str);                                                      // Checks if a String is empty.
 bool ma_string_contains(String* str, const char* substr);                               // Checks if a String contains a specific substring.
+bool ma_string_contains_len(String* str, const char* substr, size_t length);             // Checks if a String contains `length` bytes of substr.
 bool ma_string_set_pool_size(String* str, size_t newSize);                              // Sets the size of the memory pool for a String.
 bool ma_string_starts_with(const String* str, const char* substr);                      // Checks if a String starts with a specified substring.
 bool ma_string_ends_with(const String* str, const char* substr);                        // Checks if a String ends with a specified substring.
 bool ma_string_to_bool_from_cstr(const char* boolstr);                                  //
+bool ma_string_arena_mode_enabled(void);                                                // Checks if Strings created on the calling thread use the thread arena.
+bool ma_string_reserve(String* str, size_t capacity);                                   // Makes room for `capacity` bytes, terminator included, without changing the contents.
 
 int ma_string_compare(const String* str1, const String* str2);                          // Compares two Strings.
-int ma_string_find(String* str, const char* buffer, size_t pos);                        // Finds string in String and return position.
-int ma_string_rfind(String* str, const char* buffer, size_t pos);                       //
+size_t ma_string_find(String* str, const char* buffer, size_t pos);                     // Finds string at or after pos, MA_STRING_NPOS when absent.
+size_t ma_string_find_len(String* str, const char* buffer, size_t length, size_t pos);  // Finds `length` bytes at or after pos, MA_STRING_NPOS when absent.
+size_t ma_string_rfind(String* str, const char* buffer, size_t pos);                    // Finds the last occurrence starting at or before pos, MA_STRING_NPOS when absent.
+size_t ma_string_rfind_len(String* str, const char* buffer, size_t length, size_t pos); // Finds the last occurrence of `length` bytes starting at or before pos.
 int ma_string_find_first_of(String* str, const char* buffer, size_t pos);               // Finds the first occurrence of any of the characters in the given string.
 int ma_string_find_last_of(String* str, const char* buffer, size_t pos);                // Finds the last occurrence of any of the characters in the given string.
 int ma_string_find_first_not_of(String* str, const char* buffer, size_t pos);           // Finds the first character that does not match any of the characters in the given string.
@@ -195,25 +402,32 @@ void ma_string_reverse(String* str);
 void ma_string_resize(String* str, size_t newSize);                                     // Resizes a String to a specified size.
 void ma_string_shrink_to_fit(String* str);                                              // Reduces the capacity of a String to fit its size.
 void ma_string_append(String* str, const char* strItem);                                // Appends a string to the end of a String.
+void ma_string_append_len(String* str, const char* strItem, size_t length);             // Appends `length` bytes to the end of a String.
 void ma_string_push_back(String* str, const char chItem);                               // Appends a character to the end of a String.
 void ma_string_assign(String* str, const char* newStr);                                 // Assigns a new value to a String.
+void ma_string_assign_len(String* str, const char* newStr, size_t length);              // Assigns `length` bytes to a String.
 void ma_string_insert(String* str, size_t pos, const char* strItem);                    // Inserts a string at a specified position.
+void ma_string_insert_len(String* str, size_t pos, const char* strItem, size_t length); // Inserts `length` bytes at a specified position.
 void ma_string_erase(String* str, size_t pos, size_t len);                              // Erases a portion of a String.
 void ma_string_replace(String* str1, const char* oldStr, const char* newStr);           // Replaces occurrences of a substring.
+void ma_string_replace_len(String* str1, const char* oldStr, size_t oldLength, const char* newStr, size_t newLength); // Replaces the first occurrence of `oldLength` bytes with `newLength` bytes.
 void ma_string_swap(String* str1, String* str2);                                        // Swaps the contents of two String objects.
 void ma_string_pop_back(String* str);                                                   // Removes the last character of a String.
 void ma_string_deallocate(String* str);                                                 // Deallocates the memory used by a String object.
 void ma_string_clear(String* str);                                                      // Clears the contents of a String object.
+void ma_string_set_arena_mode(bool enable);                                             // Makes Strings created on the calling thread draw from the thread arena.
+void ma_string_thread_arena_destroy(void);                                              // Releases the calling thread's arena and every String allocated in it.
+void ma_string_set_growth_factor(size_t growthFactor);                                  // Sets the process-wide factor String capacities grow by, at least 2.
 
-char* ma_string_to_upper(String* str);                                                  // Converts a String to uppercase.
-char* ma_string_to_lower(String* str);                                                  // Converts a String to lowercase.
+char* ma_string_to_upper(String* str);                                                  // Returns an uppercase copy, released like every caller-owned buffer (see Allocator).
+char* ma_string_to_lower(String* str);                                                  // Returns a lowercase copy, released like every caller-owned buffer (see Allocator).
 char* ma_string_begin(String* str);                                                     // Returns an iterator to the beginning.
 char* ma_string_end(String* str);                                                       // Returns an iterator to the end.
 char* ma_string_rbegin(String* str);                                                    // Returns a reverse iterator to the beginning.
 char* ma_string_rend(String* str);                                                      // Returns a reverse iterator to the end.
 char* ma_string_back(String* str);                                                      // Returns a reference to the last character.
 char* ma_string_front(String* str);                                                     // Returns a reference to the first character.
-char* ma_string_strdup(const char* s);                                                  //
+char* ma_string_strdup(const char* s);                                                  // Duplicates a null-terminated string, released like every caller-owned buffer (see Allocator).
 char* ma_string_from_int_cstr(int value);                                               //
 
 size_t ma_string_length_cstr(const char* str);                                          // Returns the length of a char*.
@@ -223,6 +437,7 @@ size_t ma_string_capacity(String* str);
 size_t ma_string_max_size(String* str);                                                 // Returns the maximum size of a String.
 size_t ma_string_copy(String* str, char* buffer, size_t pos, size_t len);               // Copies parts of a string into an other.
 size_t ma_string_count(String* str, const char* substr);                                // Count number of substr appears in String object 'str'.
+size_t ma_string_count_len(String* str, const char* substr, size_t length);              // Counts non-overlapping occurrences of `length` bytes of substr.
 size_t ma_string_utf8_char_len(char c);                                                 // Return the len of each unicode character.
 
 const char* ma_string_data(String* str);                                                // Returns a pointer to the data stored in a String.
@@ -238,6 +453,7 @@ void ma_string_trim_left(String *str);
 void ma_string_trim_right(String *str);                                                 // Trims trailing whitespace characters from the end of the String object str
 void ma_string_trim(String *str);                                                       // Trims whitespace from both ends of a String.
 void ma_string_replace_all(String *str, const char *oldStr, const char *newStr);        // Replace occurrences of all substr in String object.
+void ma_string_replace_all_len(String *str, const char *oldStr, size_t oldLength, const char *newStr, size_t newLength); // Replaces every occurrence of `oldLength` bytes with `newLength` bytes.
 void ma_string_pad_left(String *str, size_t totalLength, char padChar);                 // Pads a String from the left.
 void ma_string_pad_right(String *str, size_t totalLength, char padChar);                // Pads a String from the right.
 void ma_string_trim_characters(String* str, const char* chars);                         // Trims specified characters from both ends of a String.
@@ -246,10 +462,230 @@ void ma_string_to_title(String* str);
 void ma_string_to_capitalize(String* str);                                              // Capitalizes the first character of a String.
 void ma_string_to_casefold(String* str);                                                // Converts a String to a case-insensitive form for comparisons.
 void ma_string_format(String* str, const char* format, ...);                            // Formats a String using given format specifiers.
+void ma_string_format_append(String* str, const char* format, ...);                     // Appends formatted text to a String.
+void ma_string_vformat(String* str, const char* format, va_list args);                  // Formats a String from a va_list.
+void ma_string_vformat_append(String* str, const char* format, va_list args);           // Appends formatted text from a va_list.
 void ma_string_remove(String* str, const char* substr);                                 // Removes all occurrences of a substring.
+void ma_string_remove_len(String* str, const char* substr, size_t length);              // Removes all occurrences of `length` bytes of substr.
 void ma_string_remove_range(String* str, size_t startPos, size_t endPos);               // Removes a range of characters from a String object, starting from startPos and ending at endPos.
 void ma_string_swap_case(String* str);                                                  // Swaps the case of each character in a String.
 
+// ------------------------------------------------------------------------- //
+//                            String view                                    //
+// ------------------------------------------------------------------------- //
+
+// Non-owning slice of characters. A view never allocates and stays valid only
+// as long as the memory it looks at, so a view of a String is invalidated by
+// anything that modifies or releases that String.
+typedef struct StringView {
+    const char* data;
+    size_t size;
+} StringView;
+
+// Returned by ma_string_view_find when there is no match; the same value as MA_STRING_NPOS.
+#define MA_STRING_VIEW_NPOS MA_STRING_NPOS
+
+StringView ma_string_view_create(const char* str);                                 // Creates a view of a null-terminated string.
+StringView ma_string_view_from_buffer(const char* data, size_t size);              // Creates a view of `size` bytes.
+StringView ma_string_view_from_string(const String* str);                          // Creates a view of the contents of a String.
+StringView ma_string_view_substr(StringView view, size_t pos, size_t len);         // Returns the part of the view starting at pos, at most len bytes long.
+StringView ma_string_view_trim_left(StringView view);                              // Drops leading whitespace.
+StringView ma_string_view_trim_right(StringView view);                             // Drops trailing whitespace.
+StringView ma_string_view_trim(StringView view);                                   // Drops whitespace at both ends.
+
+bool ma_string_view_starts_with(StringView view, StringView prefix);               // Checks if the view starts with prefix.
+bool ma_string_view_ends_with(StringView view, StringView suffix);                 // Checks if the view ends with suffix.
+bool ma_string_view_is_equal(StringView view1, StringView view2);                  // Checks if two views hold the same bytes.
+
+int ma_string_view_compare(StringView view1, StringView view2);                    // Compares two views lexicographically.
+int ma_string_view_compare_ignore_case(StringView view1, StringView view2);        // Compares two views lexicographically, ignoring ASCII case.
+size_t ma_string_view_find(StringView view, StringView needle, size_t pos);        // Finds needle at or after pos, MA_STRING_VIEW_NPOS when absent.
+String* ma_string_view_to_string(StringView view);                                 // Copies the view into a new String.
+
+// ------------------------------------------------------------------------- //
+//                          String split iterator                            //
+// ------------------------------------------------------------------------- //
+
+typedef enum {
+    STRING_SPLIT_CHAR,        // Fields are separated by the first byte of the delimiter
+    STRING_SPLIT_SEQUENCE,    // Fields are separated by the whole delimiter
+    STRING_SPLIT_ANY_OF,      // Fields are separated by any byte of the delimiter
+} StringSplitMode;
+
+// Walks the fields of a buffer without allocating or modifying it. Empty fields
+// are kept, so "a,,b" yields "a", "" and "b". The buffer and the delimiter must
+// outlive the iterator.
+typedef struct StringSplitIterator {
+    const char* data;
+    size_t size;
+    size_t pos;                     // Start of the next field
+    const char* delimiter;
+    size_t delimiterLength;
+    StringSplitMode mode;
+    bool done;
+    uint8_t delimiterSet[32];       // Bytes of the delimiter in STRING_SPLIT_ANY_OF mode, one bit each
+} StringSplitIterator;
+
+void ma_string_split_iterator_init(StringSplitIterator* it, const char* data, size_t size, const char* delimiter, size_t delimiterLength, StringSplitMode mode); // Prepares an iterator over `size` bytes.
+void ma_string_split_iterator_init_string(StringSplitIterator* it, const String* str, const char* delimiter, StringSplitMode mode);                             // Prepares an iterator over the contents of a String.
+bool ma_string_split_next(StringSplitIterator* it, size_t* offset, size_t* length); // Yields the offset and length of the next field, false once every field was returned.
+bool ma_string_split_next_view(StringSplitIterator* it, StringView* field);         // Yields the next field as a view.
+
+// ------------------------------------------------------------------------- //
+//                            String matcher                                 //
+// ------------------------------------------------------------------------- //
+
+// A set of patterns compiled into a single Aho-Corasick automaton. Finding,
+// counting or replacing all of them takes one pass over the input, whatever
+// the number of patterns. Matches never overlap: the leftmost one wins, and
+// the longest pattern among those starting at the same offset.
+typedef struct StringMatcher {
+    uint32_t* transitions;      // stateCount rows of classCount next states
+    uint32_t* depth;            // Length of the pattern prefix each state stands for
+    uint32_t* output;           // 1 + index of the longest pattern ending in each state, 0 for none
+    size_t* patternLengths;
+    size_t patternCount;
+    size_t stateCount;
+    size_t classCount;          // Distinct bytes of the patterns, plus one for every other byte
+    uint16_t classMap[256];     // Column of each byte in the transition table
+} StringMatcher;
+
+typedef struct StringMatch {
+    size_t offset;              // Start of the match in the searched data
+    size_t length;
+    size_t pattern;             // Index of the matched pattern in the set
+} StringMatch;
+
+StringMatcher* ma_string_matcher_create(const char** patterns, size_t count);                               // Compiles `count` null-terminated patterns.
+StringMatcher* ma_string_matcher_create_len(const char** patterns, const size_t* lengths, size_t count);    // Compiles `count` patterns of the given lengths.
+void ma_string_matcher_destroy(StringMatcher* matcher);                                                     // Frees the matcher.
+
+bool ma_string_matcher_find(const StringMatcher* matcher, const char* data, size_t size, size_t pos, StringMatch* match); // Finds the first match at or after pos.
+size_t ma_string_matcher_count(const StringMatcher* matcher, const char* data, size_t size);                // Counts the matches in `size` bytes.
+bool ma_string_matcher_find_string(const StringMatcher* matcher, const String* str, size_t pos, StringMatch* match);     // Finds the first match in a String at or after pos.
+size_t ma_string_matcher_count_string(const StringMatcher* matcher, const String* str);                     // Counts the matches in a String.
+
+size_t ma_string_matcher_replace(const StringMatcher* matcher, String* str, const char** replacements);     // Replaces each match with the null-terminated replacement of its pattern, returns the number of replacements.
+size_t ma_string_matcher_replace_len(const StringMatcher* matcher, String* str, const char** replacements, const size_t* lengths); // Same with replacements of the given lengths.
+
+// ------------------------------------------------------------------------- //
+//                          String number parsing                            //
+// ------------------------------------------------------------------------- //
+
+// The parsers read a number from the start of the input and never look at the
+// locale: '.' is always the decimal point and no whitespace is skipped. Integers
+// accept `[+-]digits` (no '-' for unsigned), floating point values
+// `[+-]digits[.digits][(e|E)[+-]digits]`, "inf", "infinity" and "nan" in any
+// case. Values out of range saturate (to infinity for floating point; nonzero
+// values too small for the type become a signed zero).
+typedef enum {
+    STRING_PARSE_OK,
+    STRING_PARSE_INVALID,         // The input does not start with a number, the value is left untouched
+    STRING_PARSE_OUT_OF_RANGE,    // The number does not fit the result type
+} StringParseStatus;
+
+typedef struct StringParseResult {
+    StringParseStatus status;
+    size_t consumed;              // Bytes that make up the number, 0 when invalid
+} StringParseResult;
+
+StringParseResult ma_string_parse_int64(const String* str, int64_t* value);                         // Parses a signed 64-bit integer from the start of a String.
+StringParseResult ma_string_parse_uint64(const String* str, uint64_t* value);                       // Parses an unsigned 64-bit integer from the start of a String.
+StringParseResult ma_string_parse_double(const String* str, double* value);                         // Parses a correctly rounded double from the start of a String.
+StringParseResult ma_string_parse_float(const String* str, float* value);                           // Parses a correctly rounded float from the start of a String.
+StringParseResult ma_string_parse_int64_len(const char* data, size_t length, int64_t* value);       // Parses a signed 64-bit integer from `length` bytes.
+StringParseResult ma_string_parse_uint64_len(const char* data, size_t length, uint64_t* value);     // Parses an unsigned 64-bit integer from `length` bytes.
+StringParseResult ma_string_parse_double_len(const char* data, size_t length, double* value);       // Parses a double from `length` bytes.
+StringParseResult ma_string_parse_float_len(const char* data, size_t length, float* value);         // Parses a float from `length` bytes.
+
+// ------------------------------------------------------------------------- //
+//                        String number formatting                           //
+// ------------------------------------------------------------------------- //
+
+// Large enough for any number written by the ma_string_write functions,
+// terminator included.
+#define MA_STRING_NUMBER_BUFFER_SIZE 32
+
+// Floating point values are written with the fewest digits that parse back to
+// the same value, in plain notation for magnitudes in [1e-6, 1e21) and as
+// d.ddde+x otherwise; "inf", "-inf" and "nan" for the special values. None of
+// the functions depend on the locale.
+size_t ma_string_write_int64(char* buffer, int64_t value);              // Writes value and a terminator to buffer, returns the length.
+size_t ma_string_write_uint64(char* buffer, uint64_t value);            // Writes value and a terminator to buffer, returns the length.
+size_t ma_string_write_double(char* buffer, double value);              // Writes the shortest round-trip form of value, returns the length.
+size_t ma_string_write_float(char* buffer, float value);                // Writes the shortest round-trip form of value, returns the length.
+
+void ma_string_append_int64(String* str, int64_t value);                // Appends value to a String.
+void ma_string_append_uint64(String* str, uint64_t value);              // Appends value to a String.
+void ma_string_append_double(String* str, double value);                // Appends the shortest round-trip form of value to a String.
+void ma_string_append_float(String* str, float value);                  // Appends the shortest round-trip form of value to a String.
+
+// ------------------------------------------------------------------------- //
+//                             String hashing                                //
+// ------------------------------------------------------------------------- //
+
+// 64-bit wyhash of the bytes, never 0. A String caches its hash on first use;
+// every String function that modifies or hands out a writable pointer to the
+// contents drops the cached value, code writing to dataStr directly must call
+// ma_string_invalidate_hash itself.
+uint64_t ma_string_hash(String* str);                                                   // Returns the hash of a String, computing and caching it when needed.
+uint64_t ma_string_hash_len(const char* data, size_t length);                           // Hashes `length` bytes, equal to ma_string_hash of the same contents.
+uint64_t ma_string_hash_seeded(const char* data, size_t length, uint64_t seed);         // Hashes `length` bytes with a caller-chosen seed.
+uint64_t ma_string_view_hash(StringView view);                                          // Hashes the bytes of a view.
+void ma_string_invalidate_hash(String* str);                                            // Drops the cached hash after writing to the contents directly.
+
+// ------------------------------------------------------------------------- //
+//                               String rope                                 //
+// ------------------------------------------------------------------------- //
+
+#define MA_ROPE_LEAF_SIZE 1024      // Capacity of a leaf, the most bytes an in-place edit moves
+#define MA_ROPE_MAX_DEPTH 96        // Bound on the height of the AVL-balanced tree
+
+// Text held in fixed-capacity leaves under a height-balanced binary tree, so
+// inserting or erasing anywhere costs O(log n) plus at most one leaf of
+// copying, instead of moving the whole tail as a String does.
+typedef struct RopeNode {
+    struct RopeNode* left;      // NULL for leaves, whose bytes follow the node
+    struct RopeNode* right;
+    size_t length;              // Bytes in the subtree
+    size_t height;              // 1 for leaves
+} RopeNode;
+
+typedef struct Rope {
+    RopeNode* root;             // NULL for the empty rope
+    const Allocator* allocator; // Allocator current at creation, every node comes from it
+} Rope;
+
+// Walks the leaves of a rope in order. The rope must not be modified while
+// an iterator is in use.
+typedef struct RopeIterator {
+    RopeNode* stack[MA_ROPE_MAX_DEPTH];     // Right subtrees still to visit
+    size_t depth;
+    RopeNode* leaf;             // Leaf the next chunk comes from, NULL to pop the stack
+    size_t offset;
+} RopeIterator;
+
+Rope* ma_rope_create(const char* initialStr);                                           // Creates a rope from a null-terminated string (NULL for empty).
+Rope* ma_rope_create_len(const char* data, size_t length);                              // Creates a rope from `length` bytes.
+Rope* ma_rope_from_string(const String* str);                                           // Creates a rope holding the contents of a String.
+void ma_rope_destroy(Rope* rope);                                                       // Frees the rope.
+size_t ma_rope_length(const Rope* rope);                                                // Returns the number of bytes in the rope.
+char ma_rope_at(const Rope* rope, size_t index);                                        // Returns the byte at index.
+
+void ma_rope_insert(Rope* rope, size_t pos, const char* strItem);                       // Inserts a null-terminated string at pos.
+void ma_rope_insert_len(Rope* rope, size_t pos, const char* data, size_t length);       // Inserts `length` bytes at pos.
+void ma_rope_insert_string(Rope* rope, size_t pos, const String* str);                  // Inserts the contents of a String at pos.
+void ma_rope_append_len(Rope* rope, const char* data, size_t length);                   // Appends `length` bytes.
+void ma_rope_erase(Rope* rope, size_t pos, size_t len);                                 // Erases up to len bytes starting at pos.
+
+size_t ma_rope_find(const Rope* rope, const char* needle, size_t pos);                  // Finds a string at or after pos, MA_STRING_NPOS when absent.
+size_t ma_rope_find_len(const Rope* rope, const char* needle, size_t needleLength, size_t pos); // Finds `needleLength` bytes at or after pos.
+String* ma_rope_substr(const Rope* rope, size_t pos, size_t len);                       // Copies up to len bytes starting at pos into a new String.
+String* ma_rope_to_string(const Rope* rope);                                            // Flattens the rope into one new String.
+
+void ma_rope_iterator_init(RopeIterator* it, const Rope* rope, size_t pos);             // Prepares an iterator starting at byte pos.
+bool ma_rope_iterator_next(RopeIterator* it, const char** data, size_t* length);        // Yields the next contiguous chunk, false at the end.
+
 // ------------------------------------------------------------------------- //
 //                          CPP vectors in C                                 //
 // ------------------------------------------------------------------------- //
@@ -261,10 +697,15 @@ struct Vector {
     size_t size;
     size_t capacitySize;
     size_t itemSize;
+    size_t alignment;               // Alignment of the items buffer, kept across reallocations
     MemoryPoolVector *pool;
+    bool ownsPool;                  // The pool is destroyed with the vector
+    MemoryPoolVector *headerPool;   // Pool holding this header, NULL when the header comes from the object slab
 };
 
 Vector* ma_vector_create(size_t itemSize);                                         // Initializes and returns a new vector with specified item size.
+Vector* ma_vector_create_aligned(size_t itemSize, size_t alignment);               // Creates a vector whose items start on an `alignment` boundary (MA_MEMORY_POOL_ALIGN_CACHE_LINE by default).
+Vector* ma_vector_create_with_pool(size_t itemSize, MemoryPoolVector* pool);       // Creates a vector whose header and items live in a caller-owned pool.
 
 bool ma_vector_is_equal(const Vector* vec1, const Vector* vec2);                   // Checks if two vectors are equal in content.
 bool ma_vector_is_less(const Vector* vec1, const Vector* vec2);                    // Checks if vec1 is lexicographically less than vec2.
@@ -276,6 +717,7 @@ bool ma_vector_is_empty(Vector* vec);
 bool ma_vector_reserve(Vector* vec, size_t size);                                  // Erases a range of elements from the vector.
 bool ma_vector_push_back(Vector* vec, const void* item);                           // Inserts an item into the vector at a specified position.
 bool ma_vector_emplace_back(Vector *vec, void *item, size_t itemSize);             // Reserves memory to enhance vector capacity.
+bool ma_vector_set_pool_growth(Vector* vec, size_t growthFactor, size_t maxChunkSize); // Sets how the chunks of the vector's memory pool grow.
 
 void ma_vector_erase(Vector* vec, size_t pos, size_t len);                         // Erases a range of elements from the vector.
 void ma_vector_insert(Vector* vec, size_t pos, void* item);                        // Inserts an item into the vector at a specified position.
@@ -349,7 +791,7 @@ size_t ma_file_writer_write_fmt(FileWriter* writer, const char* format, ...);
 size_t ma_file_writer_get_size(FileWriter* writer);                                         // Gets the size of the file.
 
 bool ma_file_writer_write_line(char* buffer, size_t size, FileWriter* writer);              // Writes a line of text to the file.
-bool ma_file_writer_close(FileWriter* writer);                                              // Closes the given FileWriter.
+bool ma_file_writer_close(FileWriter* writer);                                              // Closes and releases the given FileWriter.
 bool ma_file_writer_is_open(FileWriter* writer);                                            // Checks if the FileWriter is open.
 bool ma_file_writer_flush(FileWriter* writer);                                              // Flushes the FileWriter's buffer.
 bool ma_file_writer_set_encoding(FileWriter* writer, const WriteEncodingType encoding);     // Sets the character encoding for writing.
@@ -396,7 +838,7 @@ bool ma_file_reader_is_open(FileReader* reader);
 bool ma_file_reader_eof(FileReader* reader);                                                // Checks if the end of the file has been reached.
 bool ma_file_reader_copy(FileReader* src_reader, FileWriter* dest_writer);                  // Copies content from a FileReader to a FileWriter.
 bool ma_file_reader_read_line(char* buffer, size_t size, FileReader* reader);               // Reads a line of text from the file.
-bool ma_file_reader_read_lines(FileReader* reader, char*** buffer, size_t num_lines);       // Reads a specified number of lines from the file.
+bool ma_file_reader_read_lines(FileReader* reader, char*** buffer, size_t num_lines);       // Reads lines into caller-owned buffers, released like those of the String functions (see Allocator).
 
 size_t ma_file_reader_get_position(FileReader* reader);                                     // Returns the current position in the file.
 size_t ma_file_reader_read(void* buffer, size_t size, size_t count, FileReader* reader);    // Reads data from the file.
@@ -405,3 +847,49 @@ size_t ma_file_reader_read_fmt(FileReader* reader, const char* format, ...);
 
 const char* ma_file_reader_get_file_name(FileReader* reader);                               // Retrieves the file path associated with the FileReader.
 
+// ------------------------------------------------------------------------- //
+//                            String builder                                 //
+// ------------------------------------------------------------------------- //
+
+#define MA_STRING_BUILDER_CHUNK_SIZE 256                // Size of the first chunk when no hint is given
+#define MA_STRING_BUILDER_MAX_CHUNK_SIZE (1024 * 1024)  // Chunks stop doubling past this size
+
+// Append-only text accumulated in a chain of chunks, so appending never moves
+// what was already written. The text is either materialized into one String
+// of the exact final size, or streamed to a FileWriter one chunk at a time.
+typedef struct StringBuilderChunk {
+    struct StringBuilderChunk* next;
+    size_t size;
+    size_t capacity;            // The bytes themselves follow the chunk header
+} StringBuilderChunk;
+
+typedef struct StringBuilder {
+    StringBuilderChunk* head;
+    StringBuilderChunk* tail;   // Chunk the next append goes to
+    size_t size;                // Total bytes appended
+    size_t nextChunkSize;
+    FileWriter* writer;         // When set, a single chunk is reused and drained to the writer
+    const Allocator* allocator; // Allocator current at creation, every chunk comes from it
+    bool failed;                // Bytes were dropped since the last flush; `size` excludes them
+} StringBuilder;
+
+StringBuilder* ma_string_builder_create(size_t sizeHint);                                   // Creates a builder whose first chunk holds `sizeHint` bytes (0 for the default).
+StringBuilder* ma_string_builder_create_for_writer(FileWriter* writer, size_t chunkSize);   // Creates a builder that streams to a FileWriter through one chunk.
+void ma_string_builder_destroy(StringBuilder* builder);                                     // Frees the builder; pending writer output is not flushed.
+void ma_string_builder_clear(StringBuilder* builder);                                       // Drops the contents, keeping the first chunk.
+bool ma_string_builder_reserve(StringBuilder* builder, size_t size);                        // Makes the next `size` bytes land in a single chunk; false if they cannot, e.g. past a writer-backed builder's chunk size.
+size_t ma_string_builder_length(const StringBuilder* builder);                              // Returns the number of bytes appended.
+
+void ma_string_builder_append(StringBuilder* builder, const char* str);                     // Appends a null-terminated string.
+void ma_string_builder_append_len(StringBuilder* builder, const char* data, size_t length); // Appends `length` bytes.
+void ma_string_builder_append_string(StringBuilder* builder, const String* str);            // Appends the contents of a String.
+void ma_string_builder_append_char(StringBuilder* builder, char c);                         // Appends one byte.
+void ma_string_builder_append_int64(StringBuilder* builder, int64_t value);                 // Appends a signed integer in decimal.
+void ma_string_builder_append_double(StringBuilder* builder, double value);                 // Appends the shortest round-trip text of a double.
+void ma_string_builder_append_format(StringBuilder* builder, const char* format, ...);      // Appends printf-style formatted text.
+void ma_string_builder_append_join(StringBuilder* builder, String** strings, size_t count, const char* delimiter, size_t delimiterLength); // Appends Strings separated by a delimiter.
+void ma_string_builder_append_repeat(StringBuilder* builder, const char* data, size_t length, size_t count); // Appends `count` copies of `length` bytes.
+
+String* ma_string_builder_to_string(const StringBuilder* builder);                          // Copies the contents into one new String of the exact size.
+bool ma_string_builder_flush(StringBuilder* builder);                                       // Writes the buffered bytes to the builder's FileWriter; false if a write failed or appended bytes were dropped since the last flush.
+